@@ -43,6 +43,18 @@ static int msgq_slab_legal_used_elements(struct data_fifo *data_fifo, uint32_t *
 	return 0;
 }
 
+static void watermark_update(atomic_t *watermark, atomic_val_t val)
+{
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(watermark);
+		if (val <= max) {
+			return;
+		}
+	} while (!atomic_cas(watermark, max, val));
+}
+
 int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 				       k_timeout_t timeout)
 {
@@ -51,6 +63,11 @@ int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 	int ret;
 
 	ret = k_mem_slab_alloc(&data_fifo->mem_slab, data, timeout);
+	if (ret == 0) {
+		watermark_update(&data_fifo->alloced_max,
+				 k_mem_slab_num_used_get(&data_fifo->mem_slab));
+	}
+
 	return ret;
 }
 
@@ -83,6 +100,8 @@ int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
 		return -ESPIPE;
 	}
 
+	watermark_update(&data_fifo->locked_max, k_msgq_num_used_get(&data_fifo->msgq));
+
 	return 0;
 }
 
@@ -135,6 +154,18 @@ int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num, u
 	return ret;
 }
 
+int data_fifo_watermarks_get(struct data_fifo *data_fifo, uint32_t *alloced_max,
+			     uint32_t *locked_max)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	*alloced_max = atomic_get(&data_fifo->alloced_max);
+	*locked_max = atomic_get(&data_fifo->locked_max);
+
+	return 0;
+}
+
 int data_fifo_empty(struct data_fifo *data_fifo)
 {
 	uint32_t fifo_alloced_num, fifo_locked_num;
@@ -11,6 +11,46 @@
 #include <stdint.h>
 #include <zephyr/kernel.h>
 
+#if defined(CONFIG_DATA_FIFO_SPSC)
+/* Blocks are handed out from a bitmap of vacant blocks and the indexes of
+ * filled blocks are passed from producer to consumer through a ring.
+ * Producer and consumer never take a lock, except for waking up a waiting
+ * context.
+ */
+struct data_fifo {
+	char *slab_buffer;
+	uint8_t *ring;
+	size_t *block_sizes;
+	atomic_t *vacant_bm;
+	atomic_t write_idx;
+	atomic_t read_idx;
+	atomic_t alloced_num;
+	atomic_t alloced_max;
+	atomic_t locked_max;
+	atomic_t vacant_waiters;
+	atomic_t filled_waiters;
+	struct k_sem vacant_sem;
+	struct k_sem filled_sem;
+	uint32_t elements_max;
+	size_t block_size_max;
+	bool initialized;
+};
+
+#define DATA_FIFO_DEFINE(name, elements_max_in, block_size_max_in)                                 \
+	BUILD_ASSERT((elements_max_in) <= UINT8_MAX + 1, "Too many elements for the ring");        \
+	char __aligned(WB_UP(1))                                                                   \
+		_slab_buffer_##name[(elements_max_in) * (block_size_max_in)] = { 0 };              \
+	uint8_t _ring_##name[(elements_max_in)] = { 0 };                                           \
+	size_t _block_sizes_##name[(elements_max_in)] = { 0 };                                     \
+	ATOMIC_DEFINE(_vacant_bm_##name, (elements_max_in));                                       \
+	struct data_fifo name = { .slab_buffer = _slab_buffer_##name,                              \
+				  .ring = _ring_##name,                                            \
+				  .block_sizes = _block_sizes_##name,                              \
+				  .vacant_bm = _vacant_bm_##name,                                  \
+				  .block_size_max = block_size_max_in,                             \
+				  .elements_max = elements_max_in,                                 \
+				  .initialized = false }
+#else
 /* The queue elements hold a pointer to a memory block in a slab and the
  * number of bytes written to that block.
  */
@@ -24,6 +64,8 @@ struct data_fifo {
 	char *slab_buffer;
 	struct k_mem_slab mem_slab;
 	struct k_msgq msgq;
+	atomic_t alloced_max;
+	atomic_t locked_max;
 	uint32_t elements_max;
 	size_t block_size_max;
 	bool initialized;
@@ -39,6 +81,7 @@ struct data_fifo {
 				  .block_size_max = block_size_max_in,                             \
 				  .elements_max = elements_max_in,                                 \
 				  .initialized = false }
+#endif /* CONFIG_DATA_FIFO_SPSC */
 
 /**
  * @brief Get pointer to first vacant block in slab.
@@ -132,6 +175,20 @@ int data_fifo_block_free(struct data_fifo *data_fifo, void **data);
 int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num,
 			   uint32_t *locked_num);
 
+/**
+ * @brief Get the occupancy watermarks of the data_fifo.
+ *
+ * The watermarks are kept from data_fifo_init and are not reset by data_fifo_empty.
+ *
+ * @param data_fifo Pointer to the data_fifo structure.
+ * @param alloced_max Maximum number of blocks alloced at the same time.
+ * @param locked_max Maximum number of blocks locked (filled and not read) at the same time.
+ *
+ * @retval 0 Success
+ */
+int data_fifo_watermarks_get(struct data_fifo *data_fifo, uint32_t *alloced_max,
+			     uint32_t *locked_max);
+
 /**
  * @brief Empty all items from data_fifo
  *
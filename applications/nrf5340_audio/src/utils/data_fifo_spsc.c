@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "data_fifo.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "macros_common.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(data_fifo, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Number of attempts to get a consistent snapshot of the used elements */
+#define NUM_USED_GET_ATTEMPTS 3
+
+/* Ring indexes run modulo two times the number of elements,
+ * so a full ring can be told apart from an empty one.
+ */
+static inline atomic_val_t ring_idx_next(struct data_fifo *data_fifo, atomic_val_t idx)
+{
+	return (idx + 1) % (2 * data_fifo->elements_max);
+}
+
+static inline uint32_t ring_count(struct data_fifo *data_fifo, atomic_val_t write_idx,
+				  atomic_val_t read_idx)
+{
+	return (write_idx - read_idx + 2 * data_fifo->elements_max) %
+	       (2 * data_fifo->elements_max);
+}
+
+static inline uint32_t block_idx_get(struct data_fifo *data_fifo, void *data)
+{
+	size_t offset = (char *)data - data_fifo->slab_buffer;
+
+	__ASSERT_NO_MSG(((char *)data >= data_fifo->slab_buffer) &&
+			(offset < (data_fifo->elements_max * data_fifo->block_size_max)));
+	__ASSERT_NO_MSG((offset % data_fifo->block_size_max) == 0);
+
+	return offset / data_fifo->block_size_max;
+}
+
+static void watermark_update(atomic_t *watermark, atomic_val_t val)
+{
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(watermark);
+		if (val <= max) {
+			return;
+		}
+	} while (!atomic_cas(watermark, max, val));
+}
+
+/* Claim any vacant block. Safe to be called from multiple contexts. */
+static int vacant_block_claim(struct data_fifo *data_fifo, void **data)
+{
+	for (uint32_t word = 0; word < ATOMIC_BITMAP_SIZE(data_fifo->elements_max); word++) {
+		atomic_val_t vacant = atomic_get(&data_fifo->vacant_bm[word]);
+
+		while (vacant) {
+			uint32_t bit = find_lsb_set(vacant) - 1;
+			uint32_t idx = word * ATOMIC_BITS + bit;
+
+			if (atomic_test_and_clear_bit(data_fifo->vacant_bm, idx)) {
+				*data = &data_fifo->slab_buffer[idx * data_fifo->block_size_max];
+				watermark_update(&data_fifo->alloced_max,
+						 atomic_inc(&data_fifo->alloced_num) + 1);
+				return 0;
+			}
+
+			vacant &= ~BIT(bit);
+		}
+	}
+
+	return -ENOMEM;
+}
+
+/* Take the oldest filled block. The read index is advanced with CAS, so the
+ * producer may also drop the oldest block when the FIFO overruns.
+ */
+static int filled_block_take(struct data_fifo *data_fifo, void **data, size_t *size)
+{
+	atomic_val_t read_idx;
+	uint8_t idx;
+
+	do {
+		read_idx = atomic_get(&data_fifo->read_idx);
+		if (read_idx == atomic_get(&data_fifo->write_idx)) {
+			return -ENOMSG;
+		}
+
+		idx = data_fifo->ring[read_idx % data_fifo->elements_max];
+	} while (!atomic_cas(&data_fifo->read_idx, read_idx,
+			     ring_idx_next(data_fifo, read_idx)));
+
+	*data = &data_fifo->slab_buffer[idx * data_fifo->block_size_max];
+	*size = data_fifo->block_sizes[idx];
+
+	return 0;
+}
+
+/* Remaining time of the wait that ends at the given tick. */
+static k_timeout_t timeout_remaining(k_timeout_t timeout, int64_t end)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	int64_t remaining = end - k_uptime_ticks();
+
+	return (remaining > 0) ? K_TICKS(remaining) : K_NO_WAIT;
+}
+
+int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
+				       k_timeout_t timeout)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+	int64_t end = k_uptime_ticks() + timeout.ticks;
+	int ret;
+
+	while (true) {
+		ret = vacant_block_claim(data_fifo, data);
+		if (ret != -ENOMEM || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return ret;
+		}
+
+		/* Announce the waiter before checking again, so a block
+		 * freed in the meantime always wakes this context up.
+		 */
+		atomic_inc(&data_fifo->vacant_waiters);
+		ret = vacant_block_claim(data_fifo, data);
+		if (ret == 0) {
+			atomic_dec(&data_fifo->vacant_waiters);
+			return 0;
+		}
+
+		ret = k_sem_take(&data_fifo->vacant_sem, timeout_remaining(timeout, end));
+		atomic_dec(&data_fifo->vacant_waiters);
+		if (ret) {
+			return ret;
+		}
+	}
+}
+
+int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	if (size > data_fifo->block_size_max) {
+		LOG_ERR("Size %zu too big", size);
+		return -ENOMEM;
+	} else if (size == 0) {
+		LOG_ERR("Size is zero");
+		return -EINVAL;
+	}
+
+	uint32_t idx = block_idx_get(data_fifo, *data);
+	atomic_val_t write_idx = atomic_get(&data_fifo->write_idx);
+	atomic_val_t read_idx = atomic_get(&data_fifo->read_idx);
+
+	/* Only alloced blocks can be locked, so there must be space in the ring */
+	if (ring_count(data_fifo, write_idx, read_idx) >= data_fifo->elements_max) {
+		LOG_ERR("Fatal error, ring is full");
+		return -ESPIPE;
+	}
+
+	data_fifo->block_sizes[idx] = size;
+	data_fifo->ring[write_idx % data_fifo->elements_max] = idx;
+
+	/* Publish the block. Atomic operations act as a full memory barrier. */
+	atomic_set(&data_fifo->write_idx, ring_idx_next(data_fifo, write_idx));
+
+	watermark_update(&data_fifo->locked_max,
+			 ring_count(data_fifo, ring_idx_next(data_fifo, write_idx), read_idx));
+
+	if (atomic_get(&data_fifo->filled_waiters)) {
+		k_sem_give(&data_fifo->filled_sem);
+	}
+
+	return 0;
+}
+
+int data_fifo_pointer_last_filled_get(struct data_fifo *data_fifo, void **data, size_t *size,
+				      k_timeout_t timeout)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+	int64_t end = k_uptime_ticks() + timeout.ticks;
+	int ret;
+
+	while (true) {
+		ret = filled_block_take(data_fifo, data, size);
+		if (ret != -ENOMSG || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return ret;
+		}
+
+		atomic_inc(&data_fifo->filled_waiters);
+		ret = filled_block_take(data_fifo, data, size);
+		if (ret == 0) {
+			atomic_dec(&data_fifo->filled_waiters);
+			return 0;
+		}
+
+		ret = k_sem_take(&data_fifo->filled_sem, timeout_remaining(timeout, end));
+		atomic_dec(&data_fifo->filled_waiters);
+		if (ret) {
+			return ret;
+		}
+	}
+}
+
+int data_fifo_block_free(struct data_fifo *data_fifo, void **data)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	uint32_t idx = block_idx_get(data_fifo, *data);
+
+	__ASSERT(!atomic_test_bit(data_fifo->vacant_bm, idx), "Block freed twice");
+
+	atomic_dec(&data_fifo->alloced_num);
+	atomic_set_bit(data_fifo->vacant_bm, idx);
+
+	if (atomic_get(&data_fifo->vacant_waiters)) {
+		k_sem_give(&data_fifo->vacant_sem);
+	}
+
+	return 0;
+}
+
+int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num, uint32_t *locked_num)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	uint32_t alloced = UINT32_MAX;
+	uint32_t locked = UINT32_MAX;
+
+	/* Producer and consumer are not stopped, so retry if the snapshot
+	 * was taken in the middle of an operation.
+	 */
+	for (int i = 0; i < NUM_USED_GET_ATTEMPTS; i++) {
+		alloced = atomic_get(&data_fifo->alloced_num);
+		locked = ring_count(data_fifo, atomic_get(&data_fifo->write_idx),
+				    atomic_get(&data_fifo->read_idx));
+
+		if (alloced >= locked) {
+			*locked_num = locked;
+			*alloced_num = alloced;
+			return 0;
+		}
+	}
+
+	LOG_ERR("Num locked %d cannot be larger than used blocks %d", locked, alloced);
+
+	return -EACCES;
+}
+
+int data_fifo_watermarks_get(struct data_fifo *data_fifo, uint32_t *alloced_max,
+			     uint32_t *locked_max)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	*alloced_max = atomic_get(&data_fifo->alloced_max);
+	*locked_max = atomic_get(&data_fifo->locked_max);
+
+	return 0;
+}
+
+static void data_fifo_reset(struct data_fifo *data_fifo)
+{
+	for (uint32_t i = 0; i < ATOMIC_BITMAP_SIZE(data_fifo->elements_max); i++) {
+		atomic_clear(&data_fifo->vacant_bm[i]);
+	}
+
+	for (uint32_t i = 0; i < data_fifo->elements_max; i++) {
+		atomic_set_bit(data_fifo->vacant_bm, i);
+	}
+
+	atomic_set(&data_fifo->alloced_num, 0);
+	atomic_set(&data_fifo->read_idx, atomic_get(&data_fifo->write_idx));
+}
+
+int data_fifo_empty(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	/* Mark all blocks as vacant, including the ones which are alloced and not locked */
+	data_fifo_reset(data_fifo);
+
+	return 0;
+}
+
+int data_fifo_init(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(!data_fifo->initialized);
+	__ASSERT_NO_MSG(data_fifo->elements_max != 0);
+	__ASSERT_NO_MSG(data_fifo->elements_max <= (UINT8_MAX + 1));
+	__ASSERT_NO_MSG(data_fifo->block_size_max != 0);
+	__ASSERT_NO_MSG((data_fifo->block_size_max % WB_UP(1)) == 0);
+
+	k_sem_init(&data_fifo->vacant_sem, 0, 1);
+	k_sem_init(&data_fifo->filled_sem, 0, 1);
+
+	atomic_set(&data_fifo->write_idx, 0);
+	data_fifo_reset(data_fifo);
+
+	data_fifo->initialized = true;
+
+	return 0;
+}
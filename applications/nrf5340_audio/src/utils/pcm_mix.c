@@ -7,93 +7,245 @@
 #include "pcm_mix.h"
 
 #include <zephyr/kernel.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__ARM_FEATURE_SIMD32) || defined(__ARM_FEATURE_QBIT) || defined(__ARM_FEATURE_SAT)
+#include <arm_acle.h>
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, LOG_LEVEL_WRN);
 
-/* Clip signal if amplitude is outside legal range */
-static void hard_limiter(int32_t *const pcm)
+#define PCM_24_BIT_MAX ((1 << 23) - 1)
+#define PCM_24_BIT_MIN (-(1 << 23))
+
+/* Multipliers used to place a mono 16-bit sample into the lanes of a
+ * stereo frame. The left channel is stored in the lower halfword.
+ */
+#define LANE_MUL_LR 0x00010001UL
+#define LANE_MUL_L  0x00000001UL
+#define LANE_MUL_R  0x00010000UL
+
+/* Saturating add of two 16-bit samples */
+static inline int16_t sat_add_16(int16_t a, int16_t b)
 {
-	if (*pcm < INT16_MIN) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MIN;
-	} else if (*pcm > INT16_MAX) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MAX;
+	int32_t res = (int32_t)a + b;
+
+	if (res < INT16_MIN) {
+		return INT16_MIN;
+	} else if (res > INT16_MAX) {
+		return INT16_MAX;
 	}
+
+	return (int16_t)res;
 }
 
-/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
-static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
-			      size_t size_b)
+/* Saturating add of two pairs of 16-bit samples packed in 32-bit words.
+ * Uses the QADD16 instruction when the DSP extension is available.
+ */
+static inline uint32_t qadd16(uint32_t a, uint32_t b)
 {
-	int32_t res;
+#if defined(__ARM_FEATURE_SIMD32)
+	return (uint32_t)__qadd16((int16x2_t)a, (int16x2_t)b);
+#else
+	int16_t lo = sat_add_16((int16_t)(a & 0xFFFF), (int16_t)(b & 0xFFFF));
+	int16_t hi = sat_add_16((int16_t)(a >> 16), (int16_t)(b >> 16));
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
+	return (uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+#endif
+}
 
-		hard_limiter(&res);
+/* Saturating add of two 32-bit samples */
+static inline int32_t qadd32(int32_t a, int32_t b)
+{
+#if defined(__ARM_FEATURE_QBIT)
+	return __qadd(a, b);
+#else
+	int64_t res = (int64_t)a + b;
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+	if (res < INT32_MIN) {
+		return INT32_MIN;
+	} else if (res > INT32_MAX) {
+		return INT32_MAX;
 	}
+
+	return (int32_t)res;
+#endif
 }
 
-/* Mix mono into both channels of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
-					    void const *const pcm_b, size_t size_b)
+/* Saturating add of two 24-bit samples */
+static inline int32_t qadd24(int32_t a, int32_t b)
 {
-	int32_t res;
+	/* Sum of two 24-bit values always fits in 32 bits */
+	int32_t res = a + b;
 
-	/* Use size_b as this is the length of the mono sample.
-	 * This must be *2 to traverse the stereo sample and /2 since
-	 * the sample is two bytes in size.
-	 */
-	for (uint32_t i = 0; i < size_b; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i / 2];
+#if defined(__ARM_FEATURE_SAT)
+	return __ssat(res, 24);
+#else
+	if (res < PCM_24_BIT_MIN) {
+		return PCM_24_BIT_MIN;
+	} else if (res > PCM_24_BIT_MAX) {
+		return PCM_24_BIT_MAX;
+	}
 
-		hard_limiter(&res);
+	return res;
+#endif
+}
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
-	}
+static inline uint32_t load_u32(void const *const p)
+{
+	uint32_t val;
+
+	memcpy(&val, p, sizeof(val));
+	return val;
+}
+
+static inline void store_u32(void *const p, uint32_t val)
+{
+	memcpy(p, &val, sizeof(val));
 }
 
-/* Mix mono into left channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+/* Read a packed, little endian, 24-bit sample and sign extend it */
+static inline int32_t load_s24(uint8_t const *const p)
 {
-	int32_t res;
+	uint32_t val = p[0] | (p[1] << 8) | (p[2] << 16);
+
+	return (int32_t)(val << 8) >> 8;
+}
+
+static inline void store_s24(uint8_t *const p, int32_t val)
+{
+	p[0] = (uint8_t)val;
+	p[1] = (uint8_t)(val >> 8);
+	p[2] = (uint8_t)(val >> 16);
+}
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
+/* Mix stereo-stereo or mono-mono 16-bit. Two samples are added per instruction */
+static void pcm_mix_16_identical(int16_t *const pcm_a, int16_t const *const pcm_b,
+				 size_t samples)
+{
+	size_t i = 0;
 
-		hard_limiter(&res);
+	for (; (i + 1) < samples; i += 2) {
+		store_u32(&pcm_a[i], qadd16(load_u32(&pcm_a[i]), load_u32(&pcm_b[i])));
+	}
 
-		((int16_t *)pcm_a)[i * 2] = (int16_t)res;
+	if (i < samples) {
+		pcm_a[i] = sat_add_16(pcm_a[i], pcm_b[i]);
 	}
 }
 
-/* Mix mono into right channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+/* Mix 16-bit mono into a stereo buffer. One stereo frame is mixed per instruction,
+ * lane_mul selects the channels the mono sample is added to.
+ */
+static void pcm_mix_16_mono_into_stereo(int16_t *const pcm_a, int16_t const *const pcm_b,
+					size_t samples_b, uint32_t lane_mul)
 {
-	int32_t res;
+	for (size_t i = 0; i < samples_b; i++) {
+		uint32_t frame_b = (uint32_t)(uint16_t)pcm_b[i] * lane_mul;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
+		store_u32(&pcm_a[i * 2], qadd16(load_u32(&pcm_a[i * 2]), frame_b));
+	}
+}
 
-		hard_limiter(&res);
+static void pcm_mix_32(int32_t *const pcm_a, int32_t const *const pcm_b, size_t samples_b,
+		       enum pcm_mix_mode mix_mode)
+{
+	switch (mix_mode) {
+	case B_STEREO_INTO_A_STEREO:
+	case B_MONO_INTO_A_MONO:
+		for (size_t i = 0; i < samples_b; i++) {
+			pcm_a[i] = qadd32(pcm_a[i], pcm_b[i]);
+		}
+		break;
+	case B_MONO_INTO_A_STEREO_LR:
+		for (size_t i = 0; i < samples_b; i++) {
+			pcm_a[i * 2] = qadd32(pcm_a[i * 2], pcm_b[i]);
+			pcm_a[i * 2 + 1] = qadd32(pcm_a[i * 2 + 1], pcm_b[i]);
+		}
+		break;
+	case B_MONO_INTO_A_STEREO_L:
+		for (size_t i = 0; i < samples_b; i++) {
+			pcm_a[i * 2] = qadd32(pcm_a[i * 2], pcm_b[i]);
+		}
+		break;
+	case B_MONO_INTO_A_STEREO_R:
+		for (size_t i = 0; i < samples_b; i++) {
+			pcm_a[i * 2 + 1] = qadd32(pcm_a[i * 2 + 1], pcm_b[i]);
+		}
+		break;
+	}
+}
 
-		((int16_t *)pcm_a)[i * 2 + 1] = (int16_t)res;
+static void pcm_mix_24(uint8_t *const pcm_a, uint8_t const *const pcm_b, size_t samples_b,
+		       enum pcm_mix_mode mix_mode)
+{
+	const size_t bps = 3;
+
+	for (size_t i = 0; i < samples_b; i++) {
+		int32_t b = load_s24(&pcm_b[i * bps]);
+		uint8_t *l;
+		uint8_t *r;
+
+		switch (mix_mode) {
+		case B_STEREO_INTO_A_STEREO:
+		case B_MONO_INTO_A_MONO:
+			l = &pcm_a[i * bps];
+			store_s24(l, qadd24(load_s24(l), b));
+			break;
+		case B_MONO_INTO_A_STEREO_LR:
+			l = &pcm_a[i * 2 * bps];
+			r = l + bps;
+			store_s24(l, qadd24(load_s24(l), b));
+			store_s24(r, qadd24(load_s24(r), b));
+			break;
+		case B_MONO_INTO_A_STEREO_L:
+			l = &pcm_a[i * 2 * bps];
+			store_s24(l, qadd24(load_s24(l), b));
+			break;
+		case B_MONO_INTO_A_STEREO_R:
+			r = &pcm_a[(i * 2 + 1) * bps];
+			store_s24(r, qadd24(load_s24(r), b));
+			break;
+		}
 	}
 }
 
-int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
-	    enum pcm_mix_mode mix_mode)
+static void pcm_mix_16(int16_t *const pcm_a, int16_t const *const pcm_b, size_t samples_b,
+		       enum pcm_mix_mode mix_mode)
 {
+	switch (mix_mode) {
+	case B_STEREO_INTO_A_STEREO:
+	case B_MONO_INTO_A_MONO:
+		pcm_mix_16_identical(pcm_a, pcm_b, samples_b);
+		break;
+	case B_MONO_INTO_A_STEREO_LR:
+		pcm_mix_16_mono_into_stereo(pcm_a, pcm_b, samples_b, LANE_MUL_LR);
+		break;
+	case B_MONO_INTO_A_STEREO_L:
+		pcm_mix_16_mono_into_stereo(pcm_a, pcm_b, samples_b, LANE_MUL_L);
+		break;
+	case B_MONO_INTO_A_STEREO_R:
+		pcm_mix_16_mono_into_stereo(pcm_a, pcm_b, samples_b, LANE_MUL_R);
+		break;
+	}
+}
+
+int pcm_mix_bit_depth(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		      enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+
 	if (pcm_a == NULL || size_a == 0) {
 		return -EINVAL;
 	}
 
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
 	if (pcm_b == NULL || size_b == 0) {
 		/* Nothing to mix, returning */
 		return 0;
@@ -106,24 +258,14 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 		if (size_b > size_a) {
 			return -EPERM;
 		}
-		pcm_mix_identical(pcm_a, size_a, pcm_b, size_b);
 		break;
 	case B_MONO_INTO_A_STEREO_LR:
-		if (size_b > (size_a / 2)) {
-			return -EPERM;
-		}
-		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, size_a, pcm_b, size_b);
-		break;
+		/* Fall through */
 	case B_MONO_INTO_A_STEREO_L:
-		pcm_mix_b_mono_into_a_stereo_l(pcm_a, size_a, pcm_b, size_b);
-		if (size_b > (size_a / 2)) {
-			LOG_ERR("size a %d size b %d", size_a, size_b);
-			return -EPERM;
-		}
-		break;
+		/* Fall through */
 	case B_MONO_INTO_A_STEREO_R:
-		pcm_mix_b_mono_into_a_stereo_r(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
+			LOG_ERR("size a %d size b %d", size_a, size_b);
 			return -EPERM;
 		}
 		break;
@@ -131,5 +273,23 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 		return -ESRCH;
 	};
 
+	switch (pcm_bit_depth) {
+	case 16:
+		pcm_mix_16(pcm_a, pcm_b, size_b / bytes_per_sample, mix_mode);
+		break;
+	case 24:
+		pcm_mix_24(pcm_a, pcm_b, size_b / bytes_per_sample, mix_mode);
+		break;
+	case 32:
+		pcm_mix_32(pcm_a, pcm_b, size_b / bytes_per_sample, mix_mode);
+		break;
+	}
+
 	return 0;
 }
+
+int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+	    enum pcm_mix_mode mix_mode)
+{
+	return pcm_mix_bit_depth(pcm_a, size_a, pcm_b, size_b, mix_mode, 16);
+}
@@ -17,6 +17,31 @@ enum pcm_mix_mode {
 	B_MONO_INTO_A_STEREO_R,
 };
 
+/**
+ * @brief Mixes two buffers of PCM data with selectable bit depth.
+ *
+ * @note Uses saturating addition. Input can be mono or stereo as long as inputs match.
+ * By selecting the mix mode, mono can also be mixed into a stereo buffer.
+ * On cores with the DSP extension, 16-bit samples are mixed in pairs using
+ * packed saturating instructions.
+ *
+ * @param pcm_a         [in/out]Pointer to buffer A PCM data
+ * @param size_a        [in]    Size (bytes) of buffer A PCM data
+ * @param pcm_b         [in]    Pointer to buffer B PCM data
+ * @param size_b        [in]    Size (bytes) of buffer B PCM data
+ * @param mix_mode      [in]    Mixing mode according to pcm_mix_mode
+ * @param pcm_bit_depth [in]    Bit depth of PCM samples (16, 24 or 32).
+ *				24-bit samples are packed in 3 bytes
+ *
+ * @return 0            Success. Result stored in pcm_a
+ * @return -EINVAL      pcm_a is NULL, size_a = 0 or invalid bit depth
+ * @return -EPERM       size_b < size_a for stereo to stereo, mono to mono
+ *						or size_a/2 < size_b for mono to stereo mix
+ * @return -ESRCH       Invalid mix_mode
+ */
+int pcm_mix_bit_depth(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		      enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth);
+
 /**
  * @brief Mixes two buffers of PCM data.
  *
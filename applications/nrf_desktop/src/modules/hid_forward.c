@@ -264,7 +264,7 @@ static void drop_enqueued_reports(struct enqueued_reports *enqueued_reports,
 
 		item = get_enqueued_report(enqueued_reports, irep_idx);
 
-		app_event_manager_free(item->report);
+		APP_EVENT_FREE(item->report);
 		k_free(item);
 	}
 }
@@ -357,7 +357,7 @@ static void enqueue_hid_report(struct enqueued_reports *enqueued_reports,
 	} else {
 		LOG_WRN("Enqueue dropped the oldest report");
 		item = get_enqueued_report(enqueued_reports, irep_idx);
-		app_event_manager_free(item->report);
+		APP_EVENT_FREE(item->report);
 	}
 
 	if (!item) {
@@ -72,6 +72,11 @@ void wifi_nrf_bal_write_block(void *ctx,
 			      const void *src_addr,
 			      size_t len);
 
+void wifi_nrf_bal_write_block_async(void *ctx,
+				    unsigned long dest_addr_offset,
+				    const void *src_addr,
+				    size_t len);
+
 unsigned long wifi_nrf_bal_dma_map(void *ctx,
 				   unsigned long virt_addr,
 				   size_t len,
@@ -25,6 +25,8 @@
  * @write_word:
  * @read_block:
  * @write_block:
+ * @write_block_async: Optional, queue a block write that later accesses wait
+ *                     for.
  * @dma_map:
  * @dma_unmap:
  */
@@ -52,6 +54,10 @@ struct wifi_nrf_bal_ops {
 			    unsigned long dest_addr_offset,
 			    const void *src_addr,
 			    size_t len);
+	void (*write_block_async)(void *bus_dev_ctx,
+				  unsigned long dest_addr_offset,
+				  const void *src_addr,
+				  size_t len);
 	unsigned long (*dma_map)(void *bus_dev_ctx,
 				 unsigned long virt_addr,
 				 size_t len,
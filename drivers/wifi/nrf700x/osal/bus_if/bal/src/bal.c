@@ -274,6 +274,37 @@ void wifi_nrf_bal_write_block(void *ctx,
 }
 
 
+void wifi_nrf_bal_write_block_async(void *ctx,
+				    unsigned long dest_addr_offset,
+				    const void *src_addr,
+				    size_t len)
+{
+	struct wifi_nrf_bal_dev_ctx *bal_dev_ctx = NULL;
+
+	bal_dev_ctx = (struct wifi_nrf_bal_dev_ctx *)ctx;
+
+	if (!bal_dev_ctx->bpriv->ops->write_block_async) {
+		wifi_nrf_bal_write_block(ctx,
+					 dest_addr_offset,
+					 src_addr,
+					 len);
+		return;
+	}
+
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#ifdef CONFIG_NRF_WIFI_LOW_POWER_DBG
+	wifi_nrf_rpu_bal_sleep_chk(bal_dev_ctx,
+				   dest_addr_offset);
+#endif	/* CONFIG_NRF_WIFI_LOW_POWER_DBG */
+#endif  /* CONFIG_NRF_WIFI_LOW_POWER */
+
+	bal_dev_ctx->bpriv->ops->write_block_async(bal_dev_ctx->bus_dev_ctx,
+						   dest_addr_offset,
+						   src_addr,
+						   len);
+}
+
+
 unsigned long wifi_nrf_bal_dma_map(void *ctx,
 				   unsigned long virt_addr,
 				   size_t len,
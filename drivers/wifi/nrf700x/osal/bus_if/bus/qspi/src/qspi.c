@@ -274,6 +274,23 @@ static void wifi_nrf_bus_qspi_write_block(void *dev_ctx,
 }
 
 
+static void wifi_nrf_bus_qspi_write_block_async(void *dev_ctx,
+						unsigned long dest_addr_offset,
+						const void *src_addr,
+						size_t len)
+{
+	struct wifi_nrf_bus_qspi_dev_ctx *qspi_dev_ctx = NULL;
+
+	qspi_dev_ctx = (struct wifi_nrf_bus_qspi_dev_ctx *)dev_ctx;
+
+	wifi_nrf_osal_qspi_cpy_to_async(qspi_dev_ctx->qspi_priv->opriv,
+					qspi_dev_ctx->os_qspi_dev_ctx,
+					qspi_dev_ctx->host_addr_base + dest_addr_offset,
+					src_addr,
+					len);
+}
+
+
 static unsigned long wifi_nrf_bus_qspi_dma_map(void *dev_ctx,
 					       unsigned long virt_addr,
 					       size_t len,
@@ -352,6 +369,7 @@ static struct wifi_nrf_bal_ops wifi_nrf_bus_qspi_ops = {
 	.write_word = &wifi_nrf_bus_qspi_write_word,
 	.read_block = &wifi_nrf_bus_qspi_read_block,
 	.write_block = &wifi_nrf_bus_qspi_write_block,
+	.write_block_async = &wifi_nrf_bus_qspi_write_block_async,
 	.dma_map = &wifi_nrf_bus_qspi_dma_map,
 	.dma_unmap = &wifi_nrf_bus_qspi_dma_unmap,
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
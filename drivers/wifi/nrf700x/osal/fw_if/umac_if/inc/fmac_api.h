@@ -132,6 +132,18 @@ enum wifi_nrf_status wifi_nrf_fmac_stats_get(struct wifi_nrf_fmac_dev_ctx *fmac_
 					     struct rpu_op_stats *stats);
 
 
+/**
+ * wifi_nrf_fmac_host_stats_get() - Get the host statistics.
+ * @fmac_dev_ctx: Pointer to the UMAC IF context for a RPU WLAN device.
+ * @stats: Pointer to memory where the stats are to be copied.
+ *
+ * This function copies the statistics kept by the host, without
+ * requesting the statistics from the RPU.
+ */
+void wifi_nrf_fmac_host_stats_get(struct wifi_nrf_fmac_dev_ctx *fmac_dev_ctx,
+				  struct rpu_host_stats *stats);
+
+
 /**
  * wifi_nrf_fmac_scan() - Issue a scan request to the RPU.
  * @fmac_dev_ctx: Pointer to the UMAC IF context for a RPU WLAN device.
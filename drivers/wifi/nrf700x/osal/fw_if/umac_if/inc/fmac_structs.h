@@ -232,6 +232,11 @@ struct wifi_nrf_fmac_buf_map_info {
  * @total_tx_pkts: Total number of frames transmitted.
  * @total_tx_done_pkts: Total number of TX dones received.
  * @total_rx_pkts: Total number of frames received.
+ * @total_tx_cmds: Total number of TX commands sent to the RPU.
+ * @total_tx_doorbells: Total number of times the RPU was signalled for TX
+ *                      commands.
+ * @total_tx_bus_bytes: Total number of bytes of TX commands and frames written
+ *                      to the RPU.
  * @tx_coalesce_frames: Total number of transmit frames coalesced.
  * @tx_done_coalesce_frames: Total number of TX dones received for coalesced
  *                           frames.
@@ -246,6 +251,9 @@ struct rpu_host_stats {
 	unsigned long long total_tx_pkts;
 	unsigned long long total_tx_done_pkts;
 	unsigned long long total_rx_pkts;
+	unsigned long long total_tx_cmds;
+	unsigned long long total_tx_doorbells;
+	unsigned long long total_tx_bus_bytes;
 };
 
 
@@ -738,10 +738,8 @@ enum wifi_nrf_status wifi_nrf_fmac_stats_get(struct wifi_nrf_fmac_dev_ctx *fmac_
 #ifndef CONFIG_NRF700X_RADIO_TEST
 	if ((stats_type == RPU_STATS_TYPE_ALL) ||
 	    (stats_type == RPU_STATS_TYPE_HOST)) {
-		wifi_nrf_osal_mem_cpy(fmac_dev_ctx->fpriv->opriv,
-				      &stats->host,
-				      &fmac_dev_ctx->host_stats,
-				      sizeof(fmac_dev_ctx->host_stats));
+		wifi_nrf_fmac_host_stats_get(fmac_dev_ctx,
+					     &stats->host);
 	}
 #endif /* !CONFIG_NRF700X_RADIO_TEST */
 
@@ -751,6 +749,31 @@ out:
 }
 
 
+#ifndef CONFIG_NRF700X_RADIO_TEST
+void wifi_nrf_fmac_host_stats_get(struct wifi_nrf_fmac_dev_ctx *fmac_dev_ctx,
+				  struct rpu_host_stats *stats)
+{
+	struct wifi_nrf_hal_dev_ctx *hal_dev_ctx = fmac_dev_ctx->hal_dev_ctx;
+
+	wifi_nrf_osal_mem_cpy(fmac_dev_ctx->fpriv->opriv,
+			      stats,
+			      &fmac_dev_ctx->host_stats,
+			      sizeof(fmac_dev_ctx->host_stats));
+
+	/* The 64 bit counters are updated under the HAL lock */
+	wifi_nrf_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	stats->total_tx_cmds = hal_dev_ctx->tx_cmds;
+	stats->total_tx_doorbells = hal_dev_ctx->tx_doorbells;
+	stats->total_tx_bus_bytes = hal_dev_ctx->tx_bus_bytes;
+
+	wifi_nrf_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+}
+#endif /* !CONFIG_NRF700X_RADIO_TEST */
+
+
 enum wifi_nrf_status wifi_nrf_fmac_ver_get(struct wifi_nrf_fmac_dev_ctx *fmac_dev_ctx)
 {
 	enum wifi_nrf_status status = WIFI_NRF_STATUS_FAIL;
@@ -98,6 +98,31 @@ enum wifi_nrf_status wifi_nrf_hal_ctrl_cmd_send(struct wifi_nrf_hal_dev_ctx *hal
 						unsigned int cmd_size);
 
 
+/**
+ * wifi_nrf_hal_data_cmd_batch_start() - Start a batch of TX data commands.
+ * @hal_ctx: Pointer to HAL context.
+ *
+ * TX data commands sent until the batch ends are posted to the RPU, but the
+ * RPU is signalled only once for all of them, when the batch ends. Batches
+ * can be nested, the RPU is signalled when the outermost batch ends.
+ */
+void wifi_nrf_hal_data_cmd_batch_start(struct wifi_nrf_hal_dev_ctx *hal_ctx);
+
+
+/**
+ * wifi_nrf_hal_data_cmd_batch_end() - End a batch of TX data commands.
+ * @hal_ctx: Pointer to HAL context.
+ *
+ * Signals the RPU for the TX data commands posted during the batch, if this
+ * was the outermost batch.
+ *
+ * Return: Status
+ *		Pass : %WIFI_NRF_STATUS_SUCCESS
+ *		Error: %WIFI_NRF_STATUS_FAIL
+ */
+enum wifi_nrf_status wifi_nrf_hal_data_cmd_batch_end(struct wifi_nrf_hal_dev_ctx *hal_ctx);
+
+
 /**
  * wifi_nrf_hal_data_cmd_send() - Send a data command to the RPU.
  * @hal_ctx: Pointer to HAL context.
@@ -66,6 +66,29 @@ enum wifi_nrf_status hal_rpu_mem_write(struct wifi_nrf_hal_dev_ctx *hal_ctx,
 				       void *host_addr,
 				       unsigned int len);
 
+/**
+ * hal_rpu_mem_write_async() - Queue a write to the RPU RAM.
+ * @hpriv: Pointer to HAL context.
+ * @rpu_mem_addr: Absolute value of the RPU RAM address where the contents
+ *                are to be written.
+ * @host_addr: Pointer to the host memory from where the contents are to be
+ *             copied to the RPU memory. Must stay valid until the RPU has
+ *             been signalled to use the contents.
+ * @len: The length (in bytes) of the contents to be copied to the RPU memory.
+ *
+ * This function is like hal_rpu_mem_write() but can return before the write
+ * is done, if the bus supports it. Accesses to the RPU issued after it, for
+ * example the command referring to the contents, are done after the write.
+ *
+ * Return: Status
+ *		Pass : %WIFI_NRF_STATUS_SUCCESS
+ *		Error: %WIFI_NRF_STATUS_FAIL
+ */
+enum wifi_nrf_status hal_rpu_mem_write_async(struct wifi_nrf_hal_dev_ctx *hal_ctx,
+					     unsigned int rpu_mem_addr,
+					     void *host_addr,
+					     unsigned int len);
+
 
 /**
  * hal_rpu_mem_clr() - Clear contents of RPU memory.
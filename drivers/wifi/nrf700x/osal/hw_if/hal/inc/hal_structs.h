@@ -173,6 +173,15 @@ struct wifi_nrf_hal_buf_map_info {
  * @num_events: Debug counter for number of events received from the RPU.
  * @num_events_resubmit: Debug counter for number of event pointers
  *                       resubmitted back to the RPU.
+ * @tx_cmd_batch_depth: Number of open TX command batches. The RPU is signalled
+ *                      for the posted TX commands when the last batch ends.
+ * @tx_cmd_batch_pending: Number of TX commands posted since the RPU was last
+ *                        signalled.
+ * @tx_cmds: Debug counter for number of TX commands posted to the RPU.
+ * @tx_doorbells: Debug counter for number of times the RPU was signalled for
+ *                posted TX commands.
+ * @tx_bus_bytes: Debug counter for number of bytes of TX commands and frames
+ *                written to the RPU.
  *
  * This structure maintains the context information necessary for the
  * operation of the HAL. Some of the elements of the structure need to be
@@ -226,6 +235,12 @@ struct wifi_nrf_hal_dev_ctx {
 	unsigned int event_data_len;
 	unsigned int event_data_pending;
 	unsigned int event_resubmit;
+
+	unsigned int tx_cmd_batch_depth;
+	unsigned int tx_cmd_batch_pending;
+	unsigned long long tx_cmds;
+	unsigned long long tx_doorbells;
+	unsigned long long tx_bus_bytes;
 };
 
 
@@ -212,10 +212,22 @@ unsigned long wifi_nrf_hal_buf_map_tx(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
 
 	rpu_addr = RPU_MEM_PKT_BASE + (bounce_buf_addr - hal_dev_ctx->addr_rpu_pktram_base);
 
-	hal_rpu_mem_write(hal_dev_ctx,
-			  (unsigned int)rpu_addr,
-			  (void *)buf,
-			  buf_len);
+	/* The frame stays allocated until its TX done event, and the TX command
+	 * referring to it is written after the frame, so the write does not
+	 * need to be waited for.
+	 */
+	hal_rpu_mem_write_async(hal_dev_ctx,
+				(unsigned int)rpu_addr,
+				(void *)buf,
+				buf_len);
+
+	wifi_nrf_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	hal_dev_ctx->tx_bus_bytes += buf_len;
+
+	wifi_nrf_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
 
 	addr_to_map = bounce_buf_addr;
 
@@ -546,6 +558,12 @@ static enum wifi_nrf_status hal_rpu_msg_trigger(struct wifi_nrf_hal_dev_ctx *hal
 	}
 
 	hal_dev_ctx->num_cmds++;
+
+	/* The RPU picks up all the posted commands */
+	if (hal_dev_ctx->tx_cmd_batch_pending) {
+		hal_dev_ctx->tx_doorbells++;
+		hal_dev_ctx->tx_cmd_batch_pending = 0;
+	}
 out:
 	return status;
 }
@@ -594,6 +612,16 @@ static enum wifi_nrf_status hal_rpu_msg_post(struct wifi_nrf_hal_dev_ctx *hal_de
 		goto out;
 	}
 
+	if (msg_type == WIFI_NRF_HAL_MSG_TYPE_CMD_DATA_TX) {
+		hal_dev_ctx->tx_cmds++;
+		hal_dev_ctx->tx_cmd_batch_pending++;
+
+		/* The RPU is signalled when the batch ends */
+		if (hal_dev_ctx->tx_cmd_batch_depth) {
+			goto out;
+		}
+	}
+
 	if (msg_type != WIFI_NRF_HAL_MSG_TYPE_CMD_DATA_RX) {
 		/* Indicate to the RPU that the information has been posted */
 		status = hal_rpu_msg_trigger(hal_dev_ctx);
@@ -866,6 +894,45 @@ out:
 }
 
 
+void wifi_nrf_hal_data_cmd_batch_start(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx)
+{
+	wifi_nrf_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	hal_dev_ctx->tx_cmd_batch_depth++;
+
+	wifi_nrf_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+}
+
+
+enum wifi_nrf_status wifi_nrf_hal_data_cmd_batch_end(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx)
+{
+	enum wifi_nrf_status status = WIFI_NRF_STATUS_SUCCESS;
+
+	wifi_nrf_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	hal_dev_ctx->tx_cmd_batch_depth--;
+
+	if (!hal_dev_ctx->tx_cmd_batch_depth &&
+	    hal_dev_ctx->tx_cmd_batch_pending) {
+		status = hal_rpu_msg_trigger(hal_dev_ctx);
+
+		if (status != WIFI_NRF_STATUS_SUCCESS) {
+			wifi_nrf_osal_log_err(hal_dev_ctx->hpriv->opriv,
+					      "%s: Posting TX commands to RPU failed\n",
+					      __func__);
+		}
+	}
+
+	wifi_nrf_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+
+	return status;
+}
+
+
 enum wifi_nrf_status wifi_nrf_hal_data_cmd_send(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
 						enum WIFI_NRF_HAL_MSG_TYPE cmd_type,
 						void *cmd,
@@ -912,6 +979,10 @@ enum wifi_nrf_status wifi_nrf_hal_data_cmd_send(struct wifi_nrf_hal_dev_ctx *hal
 		goto out;
 	}
 
+	if (cmd_type == WIFI_NRF_HAL_MSG_TYPE_CMD_DATA_TX) {
+		hal_dev_ctx->tx_bus_bytes += cmd_size;
+	}
+
 	/* Post the updated information to the RPU */
 	status = hal_rpu_msg_post(hal_dev_ctx,
 				  cmd_type,
@@ -958,6 +1029,13 @@ enum wifi_nrf_status hal_rpu_eventq_process(struct wifi_nrf_hal_dev_ctx *hal_dev
 	void *event_data = NULL;
 	unsigned int event_len = 0;
 
+	/* TX commands queued while handling the events, for example on TX
+	 * done, are signalled to the RPU together.
+	 */
+#ifdef CONFIG_NRF700X_TX_CMD_BATCH
+	wifi_nrf_hal_data_cmd_batch_start(hal_dev_ctx);
+#endif /* CONFIG_NRF700X_TX_CMD_BATCH */
+
 	while (1) {
 		wifi_nrf_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
 						hal_dev_ctx->lock_rx,
@@ -995,6 +1073,10 @@ enum wifi_nrf_status hal_rpu_eventq_process(struct wifi_nrf_hal_dev_ctx *hal_dev
 	}
 
 out:
+#ifdef CONFIG_NRF700X_TX_CMD_BATCH
+	wifi_nrf_hal_data_cmd_batch_end(hal_dev_ctx);
+#endif /* CONFIG_NRF700X_TX_CMD_BATCH */
+
 	return status;
 }
 
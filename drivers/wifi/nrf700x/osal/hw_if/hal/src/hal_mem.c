@@ -150,7 +150,8 @@ out:
 static enum wifi_nrf_status rpu_mem_write_ram(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
 					      unsigned int ram_addr_val,
 					      void *src_addr,
-					      unsigned int len)
+					      unsigned int len,
+					      bool async)
 {
 	enum wifi_nrf_status status = WIFI_NRF_STATUS_FAIL;
 	unsigned long addr_offset = 0;
@@ -184,10 +185,17 @@ static enum wifi_nrf_status rpu_mem_write_ram(struct wifi_nrf_hal_dev_ctx *hal_d
 	}
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
 
-	wifi_nrf_bal_write_block(hal_dev_ctx->bal_dev_ctx,
-				 addr_offset,
-				 src_addr,
-				 len);
+	if (async) {
+		wifi_nrf_bal_write_block_async(hal_dev_ctx->bal_dev_ctx,
+					       addr_offset,
+					       src_addr,
+					       len);
+	} else {
+		wifi_nrf_bal_write_block(hal_dev_ctx->bal_dev_ctx,
+					 addr_offset,
+					 src_addr,
+					 len);
+	}
 
 	status = WIFI_NRF_STATUS_SUCCESS;
 
@@ -416,7 +424,8 @@ enum wifi_nrf_status hal_rpu_mem_write(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
 		status = rpu_mem_write_ram(hal_dev_ctx,
 					   rpu_mem_addr_val,
 					   src_addr,
-					   len);
+					   len,
+					   false);
 	} else if (hal_rpu_is_mem_bev(rpu_mem_addr_val)) {
 		status = rpu_mem_write_bev(hal_dev_ctx,
 					   rpu_mem_addr_val,
@@ -435,6 +444,30 @@ out:
 }
 
 
+enum wifi_nrf_status hal_rpu_mem_write_async(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
+					     unsigned int rpu_mem_addr_val,
+					     void *src_addr,
+					     unsigned int len)
+{
+	if (!hal_dev_ctx) {
+		return WIFI_NRF_STATUS_FAIL;
+	}
+
+	if (!src_addr || !hal_rpu_is_mem_ram(rpu_mem_addr_val)) {
+		wifi_nrf_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Invalid params\n",
+				      __func__);
+		return WIFI_NRF_STATUS_FAIL;
+	}
+
+	return rpu_mem_write_ram(hal_dev_ctx,
+				 rpu_mem_addr_val,
+				 src_addr,
+				 len,
+				 true);
+}
+
+
 enum wifi_nrf_status hal_rpu_mem_clr(struct wifi_nrf_hal_dev_ctx *hal_dev_ctx,
 				     enum RPU_PROC_TYPE proc,
 				     enum HAL_RPU_MEM_TYPE mem_type)
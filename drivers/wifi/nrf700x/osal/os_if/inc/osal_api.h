@@ -1202,6 +1202,26 @@ void wifi_nrf_osal_qspi_cpy_to(struct wifi_nrf_osal_priv *opriv,
 				const void *src,
 				size_t count);
 
+/**
+ * wifi_nrf_osal_qspi_cpy_to_async() - Queue a copy to the device memory.
+ * @opriv: Pointer to the OSAL context returned by the @wifi_nrf_osal_init API.
+ * @priv: Bus specific context of the device.
+ * @addr: Device address to copy to.
+ * @src: Host memory to copy from, valid until the device has consumed it.
+ * @count: Number of bytes to copy.
+ *
+ * Returns before the copy is done if the OS layer supports it. Accesses to the
+ * device memory issued after this call are done after the copy. Falls back to
+ * @wifi_nrf_osal_qspi_cpy_to otherwise.
+ *
+ * Return: None.
+ */
+void wifi_nrf_osal_qspi_cpy_to_async(struct wifi_nrf_osal_priv *opriv,
+				      void *priv,
+				      unsigned long addr,
+				      const void *src,
+				      size_t count);
+
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 /**
  * wifi_nrf_osal_timer_alloc() - Allocate a timer.
@@ -186,6 +186,7 @@ struct wifi_nrf_osal_ops {
 	void (*qspi_write_reg32)(void *priv, unsigned long addr, unsigned int val);
 	void (*qspi_cpy_from)(void *priv, void *dest, unsigned long addr, size_t count);
 	void (*qspi_cpy_to)(void *priv, unsigned long addr, const void *src, size_t count);
+	void (*qspi_cpy_to_async)(void *priv, unsigned long addr, const void *src, size_t count);
 
 	void *(*spinlock_alloc)(void);
 	void (*spinlock_free)(void *lock);
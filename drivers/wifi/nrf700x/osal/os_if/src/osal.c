@@ -688,6 +688,27 @@ void wifi_nrf_osal_qspi_cpy_to(struct wifi_nrf_osal_priv *opriv,
 				count);
 }
 
+
+void wifi_nrf_osal_qspi_cpy_to_async(struct wifi_nrf_osal_priv *opriv,
+				     void *priv,
+				     unsigned long addr,
+				     const void *src,
+				     size_t count)
+{
+	if (!opriv->ops->qspi_cpy_to_async) {
+		opriv->ops->qspi_cpy_to(priv,
+					addr,
+					src,
+					count);
+		return;
+	}
+
+	opriv->ops->qspi_cpy_to_async(priv,
+				      addr,
+				      src,
+				      count);
+}
+
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 void *wifi_nrf_osal_timer_alloc(struct wifi_nrf_osal_priv *opriv)
 {
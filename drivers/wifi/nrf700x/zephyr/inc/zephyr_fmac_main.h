@@ -47,6 +47,9 @@ struct wifi_nrf_vif_ctx_zep {
 #ifdef CONFIG_WPA_SUPP
 	struct zep_wpa_supp_dev_callbk_fns supp_callbk_fns;
 #endif /* CONFIG_WPA_SUPP */
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	struct net_stats_eth eth_stats;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
 };
 
 struct wifi_nrf_vif_ctx_map {
@@ -21,6 +21,10 @@ void wifi_nrf_if_init(struct net_if *iface);
 enum ethernet_hw_caps wifi_nrf_if_caps_get(const struct device *dev);
 int wifi_nrf_if_send(const struct device *dev, struct net_pkt *pkt);
 
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+struct net_stats_eth *wifi_nrf_if_stats_get(const struct device *dev);
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
+
 void wifi_nrf_if_rx_frm(void *os_vif_ctx, void *frm);
 
 enum wifi_nrf_status wifi_nrf_if_state_chg(void *os_vif_ctx, enum wifi_nrf_fmac_if_state if_state);
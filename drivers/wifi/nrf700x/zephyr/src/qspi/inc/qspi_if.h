@@ -13,6 +13,7 @@
 #define __QSPI_IF_H__
 
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/slist.h>
 #ifdef CONFIG_NRFX_QSPI
 #include <nrfx_qspi.h>
 #endif
@@ -53,6 +54,59 @@ struct qspi_config {
 	int test_status;
 	int test_iteration;
 };
+
+/**
+ * @brief One transfer of a QSPI request.
+ *
+ * @param addr RPU address, word aligned.
+ * @param data Word aligned host buffer, valid until the request completes.
+ * @param len Length in bytes, a multiple of the word size.
+ * @param write True to write @p data to the RPU, false to read into it.
+ */
+struct qspi_xfer {
+	unsigned int addr;
+	void *data;
+	size_t len;
+	bool write;
+};
+
+struct qspi_req;
+
+/**
+ * @brief Completion callback of a QSPI request.
+ *
+ * Called from the QSPI interrupt once all transfers of the request are done, or
+ * after the first transfer that failed. The request can be reused or freed from
+ * the callback.
+ *
+ * @param req The completed request.
+ * @param status 0 on success or negative error code.
+ */
+typedef void (*qspi_req_cb_t)(struct qspi_req *req, int status);
+
+/**
+ * @brief Scatter-gather QSPI request.
+ *
+ * The transfers of queued requests are started back to back from the QSPI
+ * interrupt. Blocking reads and writes issued after a request is submitted
+ * are run after it completes.
+ *
+ * @param node Queue node, internal.
+ * @param xfers Transfers of the request, run in order.
+ * @param xfer_cnt Number of transfers.
+ * @param cb Completion callback, can be NULL.
+ * @param user_data User data for the callback.
+ * @param xfer_idx Index of the ongoing transfer, internal.
+ */
+struct qspi_req {
+	sys_snode_t node;
+	struct qspi_xfer *xfers;
+	unsigned int xfer_cnt;
+	qspi_req_cb_t cb;
+	void *user_data;
+	unsigned int xfer_idx;
+};
+
 struct qspi_dev {
 	int (*deinit)(void);
 	void *config;
@@ -60,6 +114,7 @@ struct qspi_dev {
 	int (*write)(unsigned int addr, const void *data, int len);
 	int (*read)(unsigned int addr, void *data, int len);
 	int (*hl_read)(unsigned int addr, void *data, int len);
+	int (*submit)(struct qspi_req *req);
 	void (*hard_reset)(void);
 };
 
@@ -73,6 +128,25 @@ int qspi_read(unsigned int addr, void *data, int len);
 
 int qspi_hl_read(unsigned int addr, void *data, int len);
 
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+/**
+ * @brief Queue a scatter-gather request.
+ *
+ * Must be called from a thread, or from the completion callback of a request.
+ *
+ * @param req The request, valid until its callback is called.
+ *
+ * @retval 0 If the request is queued.
+ * @retval -EINVAL If a transfer is not word aligned.
+ */
+int qspi_submit(struct qspi_req *req);
+
+/**
+ * @brief Wait until all queued requests are completed.
+ */
+void qspi_flush(void);
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
 int qspi_deinit(void);
 
 void gpio_free_irq(int pin, struct gpio_callback *button_cb_data);
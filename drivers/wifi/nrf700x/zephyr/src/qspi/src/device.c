@@ -24,7 +24,11 @@ static struct qspi_config config;
 static struct qspi_dev qspi = { .init = qspi_init,
 			 .read = qspi_read,
 			 .write = qspi_write,
-			 .hl_read = qspi_hl_read};
+			 .hl_read = qspi_hl_read,
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+			 .submit = qspi_submit,
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+			 };
 #else
 static struct qspi_dev spim = { .init = spim_init,
 			 .read = spim_read,
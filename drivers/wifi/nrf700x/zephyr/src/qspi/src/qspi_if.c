@@ -111,6 +111,24 @@ struct qspi_nor_data {
 #endif /* CONFIG_MULTITHREADING */
 };
 
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+/**
+ * @brief Queue of scatter-gather requests
+ *
+ * While busy, the queue owns the QSPI locks, which are given back from the
+ * interrupt when the last request completes.
+ */
+static struct {
+	struct k_spinlock lock;
+	sys_slist_t reqs;
+	/* Request of the ongoing transfer, accessed by the lock owner only. */
+	struct qspi_req *cur;
+	bool busy;
+} qspi_async;
+
+static void qspi_async_done(void);
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
 static inline int qspi_freq_to_sckfreq(int freq)
 {
 #if defined(CONFIG_SOC_SERIES_NRF53X)
@@ -388,8 +406,17 @@ static void qspi_handler(nrfx_qspi_evt_t event, void *p_context)
 {
 	struct qspi_nor_data *dev_data = p_context;
 
-	if (event == NRFX_QSPI_EVENT_DONE)
-		_qspi_complete(dev_data);
+	if (event != NRFX_QSPI_EVENT_DONE)
+		return;
+
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+	if (qspi_async.cur) {
+		qspi_async_done();
+		return;
+	}
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
+	_qspi_complete(dev_data);
 }
 
 #if NRF52_ERRATA_122_PRESENT
@@ -1086,6 +1113,10 @@ int qspi_deinit(void)
 {
 	LOG_DBG("TODO : %s\n", __func__);
 
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+	qspi_flush();
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
 	return 0;
 }
 
@@ -1233,6 +1264,157 @@ int qspi_hl_read(unsigned int addr, void *data, int len)
 	return 0;
 }
 
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+static int qspi_req_run(struct qspi_req *req)
+{
+	struct qspi_xfer *xfer;
+	int status = 0;
+
+	for (req->xfer_idx = 0; req->xfer_idx < req->xfer_cnt; req->xfer_idx++) {
+		xfer = &req->xfers[req->xfer_idx];
+
+		if (xfer->write)
+			status = qspi_write(xfer->addr, xfer->data, xfer->len);
+		else
+			status = qspi_read(xfer->addr, xfer->data, xfer->len);
+
+		if (status)
+			break;
+	}
+
+	if (req->cb)
+		req->cb(req, status);
+
+	return 0;
+}
+
+/* Start the next transfer of the queue, or release the QSPI locks if the
+ * queue is empty.
+ */
+static void qspi_async_next(void)
+{
+	struct qspi_req *req;
+	struct qspi_xfer *xfer;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+	unsigned int addr;
+	nrfx_err_t res;
+
+	for (;;) {
+		req = qspi_async.cur;
+
+		if (!req) {
+			key = k_spin_lock(&qspi_async.lock);
+
+			node = sys_slist_get(&qspi_async.reqs);
+
+			if (!node) {
+				qspi_async.busy = false;
+				k_spin_unlock(&qspi_async.lock, key);
+
+				qspi_unlock(&qspi_perip);
+				qspi_trans_unlock(&qspi_perip);
+				k_sem_give(&qspi_config->lock);
+				return;
+			}
+
+			k_spin_unlock(&qspi_async.lock, key);
+
+			req = CONTAINER_OF(node, struct qspi_req, node);
+			qspi_async.cur = req;
+		}
+
+		xfer = &req->xfers[req->xfer_idx];
+		addr = xfer->addr | qspi_config->addrmask;
+
+		qspi_update_nonce(addr, xfer->len, 0);
+
+		if (xfer->write)
+			res = _nrfx_qspi_write(xfer->data, xfer->len, addr);
+		else
+			res = _nrfx_qspi_read(xfer->data, xfer->len, addr);
+
+		if (res == NRFX_SUCCESS)
+			return;
+
+		qspi_async.cur = NULL;
+
+		if (req->cb)
+			req->cb(req, qspi_get_zephyr_ret_code(res));
+	}
+}
+
+static void qspi_async_done(void)
+{
+	struct qspi_req *req = qspi_async.cur;
+
+	if (++req->xfer_idx == req->xfer_cnt) {
+		qspi_async.cur = NULL;
+
+		if (req->cb)
+			req->cb(req, 0);
+	}
+
+	qspi_async_next();
+}
+
+int qspi_submit(struct qspi_req *req)
+{
+	k_spinlock_key_t key;
+
+	for (unsigned int i = 0; i < req->xfer_cnt; i++) {
+		struct qspi_xfer *xfer = &req->xfers[i];
+
+		if ((xfer->addr % WORD_SIZE) || ((uintptr_t)xfer->data % WORD_SIZE) ||
+		    (xfer->len % WORD_SIZE) || !xfer->len)
+			return -EINVAL;
+	}
+
+	/* Without EasyDMA completion events, or when the peripheral is
+	 * uninitialized between transfers, the request is run right away.
+	 */
+	if (!qspi_config->easydma || NRF52_ERRATA_122_PRESENT || !req->xfer_cnt)
+		return qspi_req_run(req);
+
+	req->xfer_idx = 0;
+
+	key = k_spin_lock(&qspi_async.lock);
+
+	if (qspi_async.busy) {
+		sys_slist_append(&qspi_async.reqs, &req->node);
+		k_spin_unlock(&qspi_async.lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&qspi_async.lock, key);
+
+	/* Same locking order as the blocking transfers. The queue is only
+	 * marked busy once it owns the locks.
+	 */
+	k_sem_take(&qspi_config->lock, K_FOREVER);
+	qspi_trans_lock(&qspi_perip);
+	qspi_lock(&qspi_perip);
+
+	key = k_spin_lock(&qspi_async.lock);
+	sys_slist_append(&qspi_async.reqs, &req->node);
+	qspi_async.busy = true;
+	k_spin_unlock(&qspi_async.lock, key);
+
+	qspi_async_next();
+
+	return 0;
+}
+
+void qspi_flush(void)
+{
+	/* The queue holds the lock while busy, and gives it back from the
+	 * interrupt once the last request completes.
+	 */
+	k_sem_take(&qspi_config->lock, K_FOREVER);
+	k_sem_give(&qspi_config->lock);
+}
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
 int qspi_cmd_sleep_rpu(const struct device *dev)
 {
 	uint8_t data = 0x0;
@@ -108,6 +108,65 @@ static void zep_shim_qspi_cpy_to(void *priv, unsigned long addr, const void *src
 	dev->write(addr, src, count);
 }
 
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+struct zep_shim_qspi_req {
+	struct qspi_req req;
+	struct qspi_xfer xfer;
+};
+
+K_MEM_SLAB_DEFINE(zep_shim_qspi_req_slab, sizeof(struct zep_shim_qspi_req),
+		  CONFIG_NRF700X_QSPI_ASYNC_REQS, 4);
+
+static void zep_shim_qspi_req_done(struct qspi_req *req, int status)
+{
+	struct zep_shim_qspi_req *shim_req = CONTAINER_OF(req, struct zep_shim_qspi_req, req);
+
+	if (status) {
+		LOG_ERR("%s: QSPI write to 0x%x failed: %d\n", __func__, shim_req->xfer.addr,
+			status);
+	}
+
+	k_mem_slab_free(&zep_shim_qspi_req_slab, (void **)&shim_req);
+}
+
+static void zep_shim_qspi_cpy_to_async(void *priv, unsigned long addr, const void *src,
+				       size_t count)
+{
+	struct zep_shim_bus_qspi_priv *qspi_priv = priv;
+	struct zep_shim_qspi_req *shim_req;
+	struct qspi_dev *dev;
+
+	dev = qspi_priv->qspi_dev;
+
+	/* Unaligned buffers and bursts of writes that use up the requests are
+	 * written right away.
+	 */
+	if (!dev->submit || ((uintptr_t)src % 4) ||
+	    k_mem_slab_alloc(&zep_shim_qspi_req_slab, (void **)&shim_req, K_NO_WAIT)) {
+		zep_shim_qspi_cpy_to(priv, addr, src, count);
+		return;
+	}
+
+	if (count % 4 != 0) {
+		count = (count + 4) & 0xfffffffc;
+	}
+
+	shim_req->xfer.addr = addr;
+	shim_req->xfer.data = (void *)src;
+	shim_req->xfer.len = count;
+	shim_req->xfer.write = true;
+
+	shim_req->req.xfers = &shim_req->xfer;
+	shim_req->req.xfer_cnt = 1;
+	shim_req->req.cb = zep_shim_qspi_req_done;
+
+	if (dev->submit(&shim_req->req)) {
+		k_mem_slab_free(&zep_shim_qspi_req_slab, (void **)&shim_req);
+		zep_shim_qspi_cpy_to(priv, addr, src, count);
+	}
+}
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
+
 static void *zep_shim_spinlock_alloc(void)
 {
 	struct k_sem *lock = NULL;
@@ -197,21 +256,90 @@ struct nwb {
 	int hostbuffer;
 	void *cleanup_ctx;
 	void (*cleanup_cb)();
+	/* Network buffer owning the data, NULL if the data is on the heap */
+	struct net_buf *buf;
+	/* Descriptor allocated from the heap instead of the slab */
+	bool from_heap;
 };
 
+/* The network buffer descriptors come from a slab and their data from a
+ * network buffer pool, so that received frames can be passed to the
+ * network stack without copying them. The data of the pool buffers is
+ * allocated from the heap. The pool is sized for the RX buffers. TX
+ * frames queued beyond it are allocated from the heap.
+ */
+K_MEM_SLAB_DEFINE(zep_shim_nwb_slab, sizeof(struct nwb), CONFIG_NRF700X_NBUF_COUNT, 4);
+NET_BUF_POOL_HEAP_DEFINE(zep_shim_nbuf_pool, CONFIG_NRF700X_NBUF_COUNT, 0, NULL);
+
+static struct {
+	atomic_t tx_copy;
+	atomic_t rx_zero_copy;
+	atomic_t rx_copy;
+	atomic_t pool_empty;
+	atomic_t alloc_fail;
+} nbuf_stats;
+
+void zep_shim_nbuf_stats_get(struct zep_shim_nbuf_stats *stats)
+{
+	stats->tx_copy = atomic_get(&nbuf_stats.tx_copy);
+	stats->rx_zero_copy = atomic_get(&nbuf_stats.rx_zero_copy);
+	stats->rx_copy = atomic_get(&nbuf_stats.rx_copy);
+	stats->pool_empty = atomic_get(&nbuf_stats.pool_empty);
+	stats->alloc_fail = atomic_get(&nbuf_stats.alloc_fail);
+}
+
+static struct nwb *nwb_alloc(void)
+{
+	struct nwb *nwb;
+
+	if (k_mem_slab_alloc(&zep_shim_nwb_slab, (void **)&nwb, K_NO_WAIT)) {
+		nwb = k_calloc(sizeof(struct nwb), sizeof(char));
+
+		if (nwb) {
+			nwb->from_heap = true;
+		}
+
+		return nwb;
+	}
+
+	memset(nwb, 0, sizeof(*nwb));
+
+	return nwb;
+}
+
+static void nwb_free(struct nwb *nwb)
+{
+	if (nwb->from_heap) {
+		k_free(nwb);
+	} else {
+		k_mem_slab_free(&zep_shim_nwb_slab, (void **)&nwb);
+	}
+}
+
 static void *zep_shim_nbuf_alloc(unsigned int size)
 {
 	struct nwb *nwb;
 
-	nwb = (struct nwb *)k_calloc(sizeof(struct nwb), sizeof(char));
+	nwb = nwb_alloc();
 
-	if (!nwb)
+	if (!nwb) {
+		atomic_inc(&nbuf_stats.alloc_fail);
 		return NULL;
+	}
 
-	nwb->priv = k_calloc(size, sizeof(char));
+	/* The bus transfers whole words, keep room for the padding */
+	nwb->buf = net_buf_alloc_len(&zep_shim_nbuf_pool, ROUND_UP(size, 4), K_NO_WAIT);
+
+	if (nwb->buf) {
+		nwb->priv = nwb->buf->data;
+	} else {
+		atomic_inc(&nbuf_stats.pool_empty);
+		nwb->priv = k_calloc(ROUND_UP(size, 4), sizeof(char));
+	}
 
 	if (!nwb->priv) {
-		k_free(nwb);
+		atomic_inc(&nbuf_stats.alloc_fail);
+		nwb_free(nwb);
 		return NULL;
 	}
 
@@ -226,13 +354,15 @@ static void *zep_shim_nbuf_alloc(unsigned int size)
 
 static void zep_shim_nbuf_free(void *nbuf)
 {
-	struct nwb *nwb;
-
-	nwb = nbuf;
+	struct nwb *nwb = nbuf;
 
-	k_free(((struct nwb *)nbuf)->priv);
+	if (nwb->buf) {
+		net_buf_unref(nwb->buf);
+	} else {
+		k_free(nwb->priv);
+	}
 
-	k_free(nbuf);
+	nwb_free(nwb);
 }
 
 static void zep_shim_nbuf_headroom_res(void *nbuf, unsigned int size)
@@ -303,24 +433,24 @@ void *net_pkt_to_nbuf(struct net_pkt *pkt)
 
 	len = net_pkt_get_len(pkt);
 
-	nwb = zep_shim_nbuf_alloc(len + 100);
+	nwb = zep_shim_nbuf_alloc(len);
 
 	if (!nwb) {
 		return NULL;
 	}
 
-	zep_shim_nbuf_headroom_res(nwb, 100);
-
 	data = zep_shim_nbuf_data_put(nwb, len);
 
 	net_pkt_read(pkt, data, len);
 
+	atomic_inc(&nbuf_stats.tx_copy);
+
 	return nwb;
 }
 
 void *net_pkt_from_nbuf(void *iface, void *frm)
 {
-	struct net_pkt *pkt;
+	struct net_pkt *pkt = NULL;
 	unsigned char *data;
 	unsigned int len;
 	struct nwb *nwb = frm;
@@ -329,17 +459,42 @@ void *net_pkt_from_nbuf(void *iface, void *frm)
 
 	data = zep_shim_nbuf_data_get(nwb);
 
+	if (IS_ENABLED(CONFIG_NRF700X_NBUF_ZERO_COPY) && nwb->buf) {
+		pkt = net_pkt_rx_alloc_on_iface(iface, K_MSEC(100));
+
+		if (!pkt) {
+			goto out;
+		}
+
+		/* Hand the buffer over to the packet, the frame is already
+		 * in place behind the headroom used by the FMAC layer.
+		 */
+		nwb->buf->data = data;
+		nwb->buf->len = len;
+		net_pkt_append_buffer(pkt, nwb->buf);
+		nwb->buf = NULL;
+		nwb->priv = NULL;
+
+		atomic_inc(&nbuf_stats.rx_zero_copy);
+
+		goto out;
+	}
+
 	pkt = net_pkt_rx_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_MSEC(100));
 
 	if (!pkt) {
-		return NULL;
+		goto out;
 	}
 
 	if (net_pkt_write(pkt, data, len)) {
 		net_pkt_unref(pkt);
 		pkt = NULL;
+		goto out;
 	}
 
+	atomic_inc(&nbuf_stats.rx_copy);
+
+out:
 	zep_shim_nbuf_free(nwb);
 
 	return pkt;
@@ -739,6 +894,9 @@ static const struct wifi_nrf_osal_ops wifi_nrf_os_zep_ops = {
 	.qspi_write_reg32 = zep_shim_qspi_write_reg32,
 	.qspi_cpy_from = zep_shim_qspi_cpy_from,
 	.qspi_cpy_to = zep_shim_qspi_cpy_to,
+#ifdef CONFIG_NRF700X_QSPI_ASYNC
+	.qspi_cpy_to_async = zep_shim_qspi_cpy_to_async,
+#endif /* CONFIG_NRF700X_QSPI_ASYNC */
 
 	.spinlock_alloc = zep_shim_spinlock_alloc,
 	.spinlock_free = zep_shim_spinlock_free,
@@ -55,6 +55,25 @@ struct zep_shim_llist {
 	unsigned int len;
 };
 
+/**
+ * struct zep_shim_nbuf_stats - Network buffer statistics.
+ * @tx_copy: Number of frames copied to a network buffer for transmission.
+ * @rx_zero_copy: Number of received frames passed to the network stack without copying them.
+ * @rx_copy: Number of received frames copied to a network packet.
+ * @pool_empty: Number of network buffers whose data was allocated from the heap as the
+ *	pool was empty.
+ * @alloc_fail: Number of failed network buffer allocations.
+ */
+struct zep_shim_nbuf_stats {
+	uint32_t tx_copy;
+	uint32_t rx_zero_copy;
+	uint32_t rx_copy;
+	uint32_t pool_empty;
+	uint32_t alloc_fail;
+};
+
+void zep_shim_nbuf_stats_get(struct zep_shim_nbuf_stats *stats);
+
 void *net_pkt_to_nbuf(struct net_pkt *pkt);
 void *net_pkt_from_nbuf(void *iface, void *frm);
 
@@ -477,6 +477,9 @@ static const struct net_wifi_mgmt_offload wifi_offload_ops = {
 	.wifi_iface.iface_api.init = wifi_nrf_if_init,
 	.wifi_iface.get_capabilities = wifi_nrf_if_caps_get,
 	.wifi_iface.send = wifi_nrf_if_send,
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	.wifi_iface.get_stats = wifi_nrf_if_stats_get,
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
 	.scan = wifi_nrf_disp_scan_zep,
 };
 
@@ -25,7 +25,10 @@ void wifi_nrf_if_rx_frm(void *os_vif_ctx, void *frm)
 	struct wifi_nrf_vif_ctx_zep *vif_ctx_zep;
 	struct net_if *iface;
 	struct net_pkt *pkt;
-	uint8_t status;
+	int status;
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	size_t len;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
 
 	vif_ctx_zep = os_vif_ctx;
 
@@ -33,12 +36,27 @@ void wifi_nrf_if_rx_frm(void *os_vif_ctx, void *frm)
 
 	pkt = net_pkt_from_nbuf(iface, frm);
 
+	if (!pkt) {
+		LOG_DBG("RCV Packet dropped, no network packet");
+		return;
+	}
+
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	len = net_pkt_get_len(pkt);
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
+
 	status = net_recv_data(iface, pkt);
 
 	if (status < 0) {
 		LOG_ERR("RCV Packet dropped by NET stack: %d", status);
 		net_pkt_unref(pkt);
+		return;
 	}
+
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	vif_ctx_zep->eth_stats.pkts.rx++;
+	vif_ctx_zep->eth_stats.bytes.received += len;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
 }
 
 enum wifi_nrf_status wifi_nrf_if_state_chg(void *os_vif_ctx, enum wifi_nrf_fmac_if_state if_state)
@@ -85,6 +103,8 @@ int wifi_nrf_if_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct wifi_nrf_vif_ctx_zep *vif_ctx_zep = NULL;
 	struct wifi_nrf_ctx_zep *rpu_ctx_zep = NULL;
+	enum wifi_nrf_status status;
+	void *nbuf;
 
 	vif_ctx_zep = dev->data;
 	rpu_ctx_zep = vif_ctx_zep->rpu_ctx_zep;
@@ -99,6 +119,83 @@ int wifi_nrf_if_send(const struct device *dev, struct net_pkt *pkt)
 		return 0;
 	}
 
-	return wifi_nrf_fmac_start_xmit(rpu_ctx_zep->rpu_ctx, vif_ctx_zep->vif_idx,
-					net_pkt_to_nbuf(pkt));
+	nbuf = net_pkt_to_nbuf(pkt);
+
+	if (!nbuf) {
+		LOG_DBG("%s: No network buffer for TX\n", __func__);
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+		vif_ctx_zep->eth_stats.tx_dropped++;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
+		return -ENOMEM;
+	}
+
+	status = wifi_nrf_fmac_start_xmit(rpu_ctx_zep->rpu_ctx, vif_ctx_zep->vif_idx, nbuf);
+
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+	if (status == WIFI_NRF_STATUS_SUCCESS) {
+		vif_ctx_zep->eth_stats.pkts.tx++;
+		/* The frame was copied, the packet is unchanged */
+		vif_ctx_zep->eth_stats.bytes.sent += net_pkt_get_len(pkt);
+	} else {
+		vif_ctx_zep->eth_stats.tx_dropped++;
+	}
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
+
+	return status;
+}
+
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+struct net_stats_eth *wifi_nrf_if_stats_get(const struct device *dev)
+{
+	struct wifi_nrf_vif_ctx_zep *vif_ctx_zep = NULL;
+#ifdef CONFIG_NET_STATISTICS_ETHERNET_VENDOR
+	/* TX commands, doorbells and bus bytes over the frames sent give the
+	 * batching achieved per frame. The network buffer counters give the
+	 * frames copied in each direction and the allocations that missed
+	 * the pool.
+	 */
+	static struct net_stats_eth_vendor vendor_stats[] = {
+		{ "tx_frames", 0 },
+		{ "tx_cmds", 0 },
+		{ "tx_doorbells", 0 },
+		{ "tx_bus_bytes", 0 },
+		{ "nbuf_tx_copy", 0 },
+		{ "nbuf_rx_zero_copy", 0 },
+		{ "nbuf_rx_copy", 0 },
+		{ "nbuf_pool_empty", 0 },
+		{ "nbuf_alloc_fail", 0 },
+		{ NULL, 0 },
+	};
+	struct wifi_nrf_ctx_zep *rpu_ctx_zep = NULL;
+	struct rpu_host_stats host_stats;
+	struct zep_shim_nbuf_stats nbuf_stats;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET_VENDOR */
+
+	vif_ctx_zep = dev->data;
+
+#ifdef CONFIG_NET_STATISTICS_ETHERNET_VENDOR
+	rpu_ctx_zep = vif_ctx_zep->rpu_ctx_zep;
+
+	if (rpu_ctx_zep && rpu_ctx_zep->rpu_ctx) {
+		wifi_nrf_fmac_host_stats_get(rpu_ctx_zep->rpu_ctx, &host_stats);
+
+		vendor_stats[0].value = host_stats.total_tx_pkts;
+		vendor_stats[1].value = host_stats.total_tx_cmds;
+		vendor_stats[2].value = host_stats.total_tx_doorbells;
+		vendor_stats[3].value = host_stats.total_tx_bus_bytes;
+	}
+
+	zep_shim_nbuf_stats_get(&nbuf_stats);
+
+	vendor_stats[4].value = nbuf_stats.tx_copy;
+	vendor_stats[5].value = nbuf_stats.rx_zero_copy;
+	vendor_stats[6].value = nbuf_stats.rx_copy;
+	vendor_stats[7].value = nbuf_stats.pool_empty;
+	vendor_stats[8].value = nbuf_stats.alloc_fail;
+
+	vif_ctx_zep->eth_stats.vendor = vendor_stats;
+#endif /* CONFIG_NET_STATISTICS_ETHERNET_VENDOR */
+
+	return &vif_ctx_zep->eth_stats;
 }
+#endif /* CONFIG_NET_STATISTICS_ETHERNET */
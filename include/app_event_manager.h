@@ -50,14 +50,56 @@ enum app_event_type_flags {
 	APP_EVENT_TYPE_FLAGS_USER_SETTABLE_START,
 	APP_EVENT_TYPE_FLAGS_INIT_LOG_ENABLE =
 		APP_EVENT_TYPE_FLAGS_USER_SETTABLE_START,
+	APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY,
+	APP_EVENT_TYPE_FLAGS_LOW_PRIORITY,
 
 	/* Number of predefined flags. */
 	APP_EVENT_TYPE_FLAGS_COUNT,
 
-	/* Value greater or equal are user-specific. */
+	/* Value greater or equal are user-specific. Flags are stored in
+	 * an uint8_t, so bits from this one up to bit 7 are available.
+	 */
 	APP_EVENT_TYPE_FLAGS_USER_DEFINED_START = APP_EVENT_TYPE_FLAGS_COUNT,
 };
 
+/**
+ * @brief Event priority lanes.
+ *
+ * Every lane is a separate event queue. Events from a higher priority lane are
+ * always processed before events from lower priority lanes. Events within
+ * a lane are processed in order of submission.
+ *
+ * Event type is assigned to a lane using @ref APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY
+ * or @ref APP_EVENT_TYPE_FLAGS_LOW_PRIORITY flag. The lanes are used only if
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_PRIORITY_LANES} is enabled, otherwise all
+ * events go to the normal priority lane.
+ */
+enum app_event_manager_lane {
+	APP_EVENT_MANAGER_LANE_HIGH,
+	APP_EVENT_MANAGER_LANE_NORMAL,
+	APP_EVENT_MANAGER_LANE_LOW,
+
+	APP_EVENT_MANAGER_LANE_COUNT
+};
+
+/** @brief Event priority lane statistics. */
+struct app_event_manager_lane_stats {
+	/** Number of events currently waiting in the lane. */
+	uint32_t depth;
+
+	/** Maximum number of events waiting in the lane. */
+	uint32_t max_depth;
+
+	/** Number of events taken from the lane for processing. */
+	uint32_t processed_cnt;
+
+	/** Average time between event submission and start of its processing. */
+	uint32_t latency_avg_us;
+
+	/** Maximum time between event submission and start of its processing. */
+	uint32_t latency_max_us;
+};
+
 /** @brief Get event type flag's value.
  *
  * @param flag Selected event type flag.
@@ -160,6 +202,9 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
  * @param ev_info_struct   Data structure describing the event type.
  * @param app_event_type_flags Event type flags.
  *                         You should use APP_EVENT_FLAGS_CREATE to define them.
+ *                         @ref APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY and
+ *                         @ref APP_EVENT_TYPE_FLAGS_LOW_PRIORITY cannot be used
+ *                         together.
  */
 #define APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags) \
 	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags)
@@ -385,11 +430,77 @@ void *app_event_manager_alloc(size_t size);
  * The default implementation of this function is same as k_free.
  * It is annotated as weak and can be overridden by user.
  *
+ * To release an event that was not submitted, use @ref APP_EVENT_FREE
+ * instead. With event pools enabled, the event may not come from
+ * @ref app_event_manager_alloc.
+ *
  * @param addr  Pointer to previously allocated memory.
  **/
 void app_event_manager_free(void *addr);
 
 
+/** @brief Free an event that was not submitted.
+ *
+ * Use this macro to release an event allocated with the new_<i>%event_type</i>
+ * function that is not going to be submitted. The macro takes into account
+ * whether the event comes from the event type pool or from
+ * @ref app_event_manager_alloc.
+ *
+ * @param event  Pointer to the event object.
+ */
+#define APP_EVENT_FREE(event) _event_free(&(event)->header)
+
+
+/** @brief Event pool statistics. */
+struct app_event_manager_pool_stats {
+	/** Number of blocks in the pool. */
+	uint32_t block_cnt;
+
+	/** Number of blocks currently in use. */
+	uint32_t used_cnt;
+
+	/** High-water mark of blocks in use. */
+	uint32_t max_used_cnt;
+
+	/** Number of allocations that fell back to the heap because the pool was empty. */
+	uint32_t heap_fallback_cnt;
+};
+
+
+/** @brief Get statistics of the event type pool.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_POOLS} option needs to be enabled.
+ *
+ * @param et     Pointer to the event type.
+ * @param stats  Pointer to the structure to be filled with statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the event type does not use a pool (event with dynamic data).
+ * @retval -ENOTSUP If event pools are disabled.
+ */
+int app_event_manager_pool_stats_get(const struct event_type *et,
+				     struct app_event_manager_pool_stats *stats);
+
+
+/** @brief Get statistics of the event priority lane.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_QUEUE_STATS} option needs to be enabled.
+ *
+ * @param lane   Priority lane.
+ * @param stats  Pointer to the structure to be filled with statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the lane is invalid.
+ * @retval -ENOTSUP If queue statistics are disabled.
+ */
+int app_event_manager_lane_stats_get(enum app_event_manager_lane lane,
+				     struct app_event_manager_lane_stats *stats);
+
+
 /** @brief Log event.
  *
  * This helper macro simplifies event logging.
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SENSOR_DATA_AGGREGATOR_H_
+#define _SENSOR_DATA_AGGREGATOR_H_
+
+/**
+ * @file
+ * @defgroup caf_sensor_data_aggregator CAF Sensor Data Aggregator
+ * @{
+ * @brief CAF Sensor Data Aggregator.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Sensor data aggregator handle. */
+struct sensor_data_aggregator;
+
+/**
+ * @brief Get the aggregator of a sensor.
+ *
+ * The handle is meant to be looked up once and then used for every sample of the sensor.
+ *
+ * @param sensor_descr Sensor description, the same pointer as used in the sensor events.
+ *
+ * @return Aggregator handle or NULL if no aggregator handles the sensor.
+ */
+struct sensor_data_aggregator *sensor_data_aggregator_get(const char *sensor_descr);
+
+/**
+ * @brief Claim the place for the next sample in the active aggregator buffer.
+ *
+ * The sample is written in place and added to the buffer with
+ * @ref sensor_data_aggregator_sample_commit. Only one sample of an aggregator
+ * can be claimed at a time. A claimed sample that is not committed is dropped.
+ *
+ * @param agg  Aggregator handle.
+ * @param size Size of the sample in bytes.
+ *
+ * @return Pointer to the sample or NULL if there is no free buffer or the size does not
+ *	   match the sensor data size of the aggregator.
+ */
+void *sensor_data_aggregator_sample_claim(struct sensor_data_aggregator *agg, size_t size);
+
+/**
+ * @brief Add a claimed sample to the active aggregator buffer.
+ *
+ * When the buffer is full, it is sent in a sensor_data_aggregator_event.
+ *
+ * @param agg    Aggregator handle.
+ * @param sample Pointer returned by @ref sensor_data_aggregator_sample_claim.
+ *
+ * @retval 0 If successful.
+ * @retval -ECANCELED If the buffer was sent before the sample was committed, for example
+ *		      because the sensor state changed. The sample is dropped.
+ */
+int sensor_data_aggregator_sample_commit(struct sensor_data_aggregator *agg, void *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _SENSOR_DATA_AGGREGATOR_H_ */
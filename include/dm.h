@@ -108,6 +108,13 @@ struct dm_cb {
 	 * Callback that is executed when the result
 	 * of the Distance Measurement is available for reading.
 	 *
+	 * The callback is called from the DM thread. If the
+	 * @kconfig{CONFIG_DM_CALC_WORKER} option is enabled, it is called from
+	 * the distance calculation thread instead, with the priority set by
+	 * @kconfig{CONFIG_DM_CALC_THREAD_PRIORITY}. In that case, the results
+	 * of rangings that end while the previous results are still being
+	 * calculated are dropped and no callback is called for them.
+	 *
 	 *  @param[out] result Pointer to the variable that is used to store
 	 *                     the Distance Measurement result.
 	 */
@@ -138,6 +145,39 @@ struct dm_request {
 	uint32_t start_delay_us;
 };
 
+/** @brief Scheduling statistics of a peer. */
+struct dm_peer_stats {
+	/** Bluetooth LE device address. */
+	bt_addr_le_t bt_addr;
+
+	/** Number of rangings scheduled. */
+	uint32_t scheduled;
+
+	/** Number of rangings done. */
+	uint32_t rangings;
+
+	/** Rangings done per minute since the statistics were reset. */
+	uint32_t ranging_rate;
+
+	/** Number of requests rejected because the timeslot queue was full. */
+	uint32_t rejected_full;
+
+	/** Number of requests rejected because the peer had the maximum number of
+	 *  timeslots scheduled.
+	 */
+	uint32_t rejected_peer_limit;
+
+	/** Number of requests rejected because the timeslot did not fit between
+	 *  the timeslots already scheduled.
+	 */
+	uint32_t rejected_busy;
+
+	/** Number of rangings whose report was dropped because the distance
+	 *  calculation could not keep up.
+	 */
+	uint32_t dropped;
+};
+
 /** @brief Initialize the DM.
  *
  *  Initialize the DM by specifying a list of supported operations.
@@ -160,6 +200,23 @@ int dm_init(struct dm_init_param *init_param);
  */
 int dm_request_add(struct dm_request *req);
 
+/** @brief Get the scheduling statistics of a peer.
+ *
+ *  Requires the @kconfig{CONFIG_DM_STATS} option. The statistics are kept for
+ *  up to @kconfig{CONFIG_DM_STATS_PEER_COUNT} peers.
+ *
+ *  @param[in] bt_addr Bluetooth LE device address of the peer.
+ *  @param[out] peer_stats Statistics of the peer.
+ *
+ *  @retval 0 if the operation was successful.
+ *  @retval -ENOENT if there are no statistics for the peer.
+ *          Otherwise, a (negative) error code is returned.
+ */
+int dm_peer_stats_get(const bt_addr_le_t *bt_addr, struct dm_peer_stats *peer_stats);
+
+/** @brief Reset the scheduling statistics of all peers. */
+void dm_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,9 @@
 extern "C" {
 #endif
 
+/** Entry ID reserved for the duration of the last store. */
+#define EMDS_STORE_TIME_ID 0xFFFF
+
 /**
  * @struct emds_entry
  *
@@ -53,13 +56,15 @@ struct emds_dynamic_entry {
  *
  * @param _name The entry name.
  * @param _id Unique ID for the entry. This value and not an overlap with any
- *            other value.
+ *            other value, or with @ref EMDS_STORE_TIME_ID.
  * @param _data Data pointer to be stored at emergency data store.
  * @param _len Length of data to be stored at emergency data store.
  *
  * This creates a variable _name prepended by emds_.
  */
 #define EMDS_STATIC_ENTRY_DEFINE(_name, _id, _data, _len)                      \
+	BUILD_ASSERT((_id) != EMDS_STORE_TIME_ID,                              \
+		     "Entry ID is reserved for the store time");               \
 	static const STRUCT_SECTION_ITERABLE(emds_entry, emds_##_name) = {     \
 		.id = _id,                                                     \
 		.data = (uint8_t *)_data,                                      \
@@ -163,8 +168,13 @@ int emds_prepare(void);
  * @brief Estimate the time needed to store the registered data.
  *
  * Estimate how much time it takes to store all dynamic and static data
- * registered in the entries. This value is dependent on the chip used, and
- * should be checked against the chip datasheet.
+ * registered in the entries. The duration of each store is saved together with
+ * the data. When a previous store has been loaded with @ref emds_load, the
+ * estimate is the measured duration of that store scaled to the current size
+ * of the entries, plus @kconfig{CONFIG_EMDS_FLASH_TIME_BASE_OVERHEAD_US}.
+ * Otherwise, the estimate is computed from the worst case flash timings, which
+ * are dependent on the chip used, and should be checked against the chip
+ * datasheet.
  *
  * @return Time needed to store all data (in microseconds).
  */
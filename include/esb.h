@@ -210,6 +210,21 @@ struct esb_evt {
 	uint32_t tx_attempts;	/**< Number of TX retransmission attempts. */
 };
 
+/** @brief Enhanced ShockBurst statistics of a pipe. */
+struct esb_pipe_stats {
+	uint32_t tx_success;	 /**< Number of packets sent successfully. */
+	uint32_t tx_failed;	 /**< Number of packets not acknowledged after
+				  *  all retransmission attempts.
+				  */
+	uint32_t tx_retransmits; /**< Number of retransmissions. */
+	uint32_t tx_chained;	 /**< Number of packets chained in a burst. */
+	uint32_t tx_bytes;	 /**< Payload bytes of the packets sent
+				  *  successfully.
+				  */
+	uint32_t rx_packets;	 /**< Number of packets received. */
+	uint32_t rx_bytes;	 /**< Payload bytes of the packets received. */
+};
+
 /** @brief Event handler prototype. */
 typedef void (*esb_event_handler)(const struct esb_evt *event);
 
@@ -483,6 +498,42 @@ int esb_set_bitrate(enum esb_bitrate bitrate);
  */
 int esb_reuse_pid(uint8_t pipe);
 
+/** @brief Get the longest time the interrupts were locked to queue a payload.
+ *
+ * The time is measured from the last call to this function. Requires the
+ * @kconfig{CONFIG_ESB_IRQ_LOCK_STATS} option.
+ *
+ * @param[out] time_ns Longest time the interrupts were locked, in nanoseconds.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_irq_lock_time_get(uint32_t *time_ns);
+
+/** @brief Get the statistics of a pipe.
+ *
+ * The statistics are counted from the initialization of the module or from
+ * the last call to @ref esb_pipe_stats_reset. The throughput of a pipe is the
+ * difference of the byte counters divided by the time between two reads.
+ * Requires the @kconfig{CONFIG_ESB_PIPE_STATS} option.
+ *
+ * @param[in]  pipe  Pipe.
+ * @param[out] stats Statistics of the pipe.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_pipe_stats_get(uint8_t pipe, struct esb_pipe_stats *stats);
+
+/** @brief Reset the statistics of all pipes.
+ *
+ * Requires the @kconfig{CONFIG_ESB_PIPE_STATS} option.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_pipe_stats_reset(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -117,6 +117,67 @@ static inline void at_monitor_resume(struct at_monitor_entry *mon)
 	mon->flags.paused = false;
 }
 
+/**
+ * @brief AT monitor statistics.
+ */
+struct at_monitor_stats {
+	/** Number of notifications to be copied for monitors in the system workqueue. */
+	uint32_t notif_cnt;
+	/** Number of notifications dropped because there was no space to copy them. */
+	uint32_t dropped_cnt;
+	/** Bytes currently used by copied notifications. */
+	size_t used;
+	/** Maximum number of bytes used by copied notifications. */
+	size_t used_max;
+	/** Size of the heap or ring buffer. */
+	size_t size;
+};
+
+/**
+ * @brief Get the length of a notification.
+ *
+ * Get the length of the notification without calling strlen().
+ *
+ * @note Only valid for notifications received by monitors defined with @ref AT_MONITOR,
+ *	 not for notifications received in an ISR.
+ *
+ * @param notif The AT notification received by the monitor callback.
+ *
+ * @return Length of the notification, not including the null-terminator.
+ */
+size_t at_monitor_notif_len(const char *notif);
+
+/**
+ * @brief Take a reference to a notification.
+ *
+ * Keep the notification after returning from the monitor callback, without copying it.
+ * The notification must be released with @ref at_monitor_notif_unref.
+ *
+ * @note Only valid for notifications received by monitors defined with @ref AT_MONITOR,
+ *	 not for notifications received in an ISR.
+ *
+ * @param notif The AT notification received by the monitor callback.
+ */
+void at_monitor_notif_ref(const char *notif);
+
+/**
+ * @brief Release a reference to a notification.
+ *
+ * @param notif The AT notification referenced with @ref at_monitor_notif_ref.
+ */
+void at_monitor_notif_unref(const char *notif);
+
+/**
+ * @brief Get the AT monitor statistics.
+ *
+ * @param[out] stats Statistics of the notifications copied for monitors
+ *		     in the system workqueue.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If @p stats is NULL.
+ */
+int at_monitor_stats_get(struct at_monitor_stats *stats);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -51,6 +51,28 @@ int nrf_modem_lib_trace_processing_done_wait(k_timeout_t timeout);
  */
 int nrf_modem_lib_trace_level_set(enum nrf_modem_lib_trace_level trace_level);
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH) || defined(__DOXYGEN__)
+/** @brief Read out the traces stored in flash.
+ *
+ * Reads the traces stored by the flash trace backend, oldest first and
+ * decompressed, continuing where the previous read stopped. Traces still
+ * held in RAM are written to flash when the stored traces have been read.
+ *
+ * @param buf Buffer for the traces.
+ * @param len Size of the buffer.
+ *
+ * @return Number of bytes read, -ENODATA if all traces have been read,
+ *	   or another negative errno on failure.
+ */
+int nrf_modem_lib_trace_read(uint8_t *buf, size_t len);
+
+/** @brief Erase the traces stored in flash.
+ *
+ * @return Zero on success, a negative errno otherwise.
+ */
+int nrf_modem_lib_trace_clear(void);
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH */
+
 /** @} */
 
 #ifdef __cplusplus
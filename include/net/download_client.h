@@ -47,6 +47,8 @@ enum download_client_evt_id {
 	 * - EHOSTDOWN: host went down during download
 	 * - EBADMSG: HTTP response header not as expected
 	 * - E2BIG: HTTP response header could not fit in buffer
+	 * - ESTALE: the resource on the server has changed since
+	 *   the download was journaled
 	 *
 	 * In case of errors on the socket during send() or recv() (ECONNRESET),
 	 * returning zero from the callback will let the library attempt
@@ -102,8 +104,87 @@ struct download_client_cfg {
 	size_t frag_size_override;
 	/** Set hostname for TLS Server Name Indication extension */
 	bool set_tls_hostname;
+	/** Keep a persistent journal of the download, to validate
+	 *  the resource when the download is resumed.
+	 *  Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_JOURNAL}.
+	 *  Only one download at a time can be journaled.
+	 */
+	bool journal;
+};
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+/**
+ * @brief Download journal.
+ *
+ * The journal is kept in settings storage, so that an interrupted
+ * download can be resumed after a reboot or a loss of connection.
+ */
+struct download_client_journal {
+	/** CRC32 of the host and file name of the download. */
+	uint32_t url_hash;
+	/** ETag of the resource, empty if the server did not send one. */
+	char etag[CONFIG_DOWNLOAD_CLIENT_JOURNAL_ETAG_SIZE];
+	/** Size of the resource, in bytes. */
+	size_t file_size;
+	/** Number of bytes accepted by the application. */
+	size_t offset;
+	/** Offset the running hash starts from. */
+	size_t crc_offset;
+	/** CRC32 of the bytes from @c crc_offset to @c offset. */
+	uint32_t crc;
+};
+#else
+struct download_client_journal;
+#endif
+
+/**
+ * @brief Read back downloaded data, to verify a journal.
+ *
+ * @param[in]  offset	Offset in the resource.
+ * @param[out] buf	Buffer to read into.
+ * @param[in]  len	Number of bytes to read.
+ * @param[in]  user_data	User data, as passed to @ref download_client_journal_verify.
+ *
+ * @retval int Zero on success, otherwise a negative error code.
+ */
+typedef int (*download_client_journal_read_t)(size_t offset, void *buf, size_t len,
+					      void *user_data);
+
+/**
+ * @brief Download statistics.
+ *
+ * Statistics are reset when a download is started
+ * with @ref download_client_start.
+ */
+struct download_client_stats {
+	/** Payload bytes received since the download was started. */
+	size_t bytes;
+	/** Time since the download was started, or total download time
+	 *  once the download is complete, in milliseconds.
+	 */
+	uint32_t duration_ms;
+	/** Average throughput, in bytes per second. */
+	uint32_t throughput;
+	/** Number of requests sent to the server. */
+	uint32_t requests;
+	/** Number of times the client reconnected to the server. */
+	uint32_t reconnects;
+	/** Shortest time between sending an HTTP request and
+	 *  receiving the response header, in milliseconds.
+	 */
+	uint32_t rtt_min_ms;
+	/** Average HTTP response time, in milliseconds. */
+	uint32_t rtt_avg_ms;
+	/** Longest HTTP response time, in milliseconds. */
+	uint32_t rtt_max_ms;
 };
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+#define DOWNLOAD_CLIENT_HTTP_REQUESTS_MAX CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH
+#else
+#define DOWNLOAD_CLIENT_HTTP_REQUESTS_MAX 1
+#endif
+
 /**
  * @brief Download client asynchronous event handler.
  *
@@ -157,6 +238,19 @@ struct download_client {
 		bool has_header;
 		/** The server has closed the connection. */
 		bool connection_close;
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+		/** Number of range requests sent and not fully received. */
+		uint8_t in_flight;
+		/** Offset of the next range to request. */
+		size_t next_req;
+		/** Payload size of the response being received. */
+		size_t content_len;
+		/** Bytes of the next response received after the current fragment. */
+		size_t carry;
+		/** Request buffer, the response buffer can hold the next response. */
+		char req_buf[CONFIG_DOWNLOAD_CLIENT_MAX_HOSTNAME_SIZE +
+			     CONFIG_DOWNLOAD_CLIENT_MAX_FILENAME_SIZE + 128];
+#endif
 	} http;
 
 	struct {
@@ -182,6 +276,38 @@ struct download_client {
 
 	/** Set socket to native TLS */
 	bool set_native_tls;
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	struct {
+		/** Statistics of the current download. */
+		struct download_client_stats stats;
+		/** Uptime when the download was started. */
+		int64_t start;
+		/** Uptime when the download was completed, zero until then. */
+		int64_t end;
+		/** Offset the download was started from. */
+		size_t from;
+		/** Sum of the HTTP response times. */
+		uint64_t rtt_sum;
+		/** Number of HTTP response times measured. */
+		uint32_t rtt_cnt;
+		/** Uptime when each HTTP request waiting for a response was sent. */
+		int64_t req_time[DOWNLOAD_CLIENT_HTTP_REQUESTS_MAX];
+		/** Index of the oldest HTTP request waiting for a response. */
+		uint8_t req_head;
+		/** Number of HTTP requests waiting for a response. */
+		uint8_t req_cnt;
+	} stats;
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+	struct {
+		/** Journal of the current download. */
+		struct download_client_journal entry;
+		/** Offset of the journal last saved to settings storage. */
+		size_t saved;
+	} journal;
+#endif
 };
 
 /**
@@ -254,6 +380,72 @@ void download_client_resume(struct download_client *client);
  */
 int download_client_file_size_get(struct download_client *client, size_t *size);
 
+/**
+ * @brief Retrieve the statistics of the current or last download.
+ *
+ * Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_STATS}.
+ *
+ * @param[in]  client	Client instance.
+ * @param[out] stats	Download statistics.
+ *
+ * @retval int Zero on success, otherwise a negative error code.
+ */
+int download_client_stats_get(struct download_client *client,
+			      struct download_client_stats *stats);
+
+/**
+ * @brief Retrieve the journal of an interrupted download.
+ *
+ * Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_JOURNAL}.
+ *
+ * The journal must be checked against the data stored by the application
+ * with @ref download_client_journal_verify. Once verified, the offset in the
+ * journal can be passed to @ref download_client_start to resume the download.
+ * When resuming, the library checks that the ETag and the size of the resource
+ * have not changed, and reports @ref DOWNLOAD_CLIENT_EVT_ERROR with error
+ * -ESTALE otherwise. A journal that has not been verified is ignored.
+ *
+ * @param[in]  host	Name of the host, as passed to @ref download_client_connect.
+ * @param[in]  file	File name, as passed to @ref download_client_start.
+ * @param[out] journal	Download journal.
+ *
+ * @retval int Zero on success, -ENOENT if there is no journal for this download,
+ *	       otherwise a negative error code.
+ */
+int download_client_journal_get(const char *host, const char *file,
+				struct download_client_journal *journal);
+
+/**
+ * @brief Verify a journal against the data stored by the application.
+ *
+ * Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_JOURNAL}.
+ *
+ * Reads back the bytes covered by the CRC of the journal and compares
+ * their CRC with the journal. The journal is deleted if they do not match.
+ *
+ * If the data cannot be read back, @p read can be NULL. The journal is then
+ * accepted without checking its CRC, and a resumed download is only checked
+ * against the ETag and size of the resource on the server.
+ *
+ * @param[in] journal	Journal, as retrieved with @ref download_client_journal_get.
+ * @param[in] read	Function to read back the downloaded data, or NULL.
+ * @param[in] user_data	User data passed to @p read.
+ *
+ * @retval int Zero on success, -EBADMSG if the data does not match the journal,
+ *	       otherwise a negative error code.
+ */
+int download_client_journal_verify(const struct download_client_journal *journal,
+				   download_client_journal_read_t read, void *user_data);
+
+/**
+ * @brief Delete the download journal.
+ *
+ * Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_JOURNAL}.
+ *
+ * @retval int Zero on success, otherwise a negative error code.
+ */
+int download_client_journal_clear(void);
+
 /**
  * @brief Disconnect from the server.
  *
@@ -8,6 +8,7 @@
 #define NRF_RPC_IPC_H_
 
 #include <zephyr/device.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/ipc/ipc_service.h>
 
 #include <nrf_rpc.h>
@@ -43,6 +44,29 @@ struct nrf_rpc_ipc_endpoint {
 	struct k_event ept_bond;
 };
 
+/** @brief nRF RPC IPC Service transport statistics. */
+struct nrf_rpc_ipc_stats {
+	/** Number of packets sent. */
+	uint32_t sent;
+
+	/** Number of packets sent from the IPC Service shared memory without a copy. */
+	uint32_t sent_nocopy;
+
+	/** Number of failed Tx buffer allocations. */
+	uint32_t alloc_failures;
+
+	/** Number of Tx buffers allocated from the system heap because
+	 *  they did not fit in the Tx buffer pool.
+	 */
+	uint32_t heap_allocs;
+
+	/** Total time spent sending packets in microseconds. */
+	uint64_t send_time_us;
+
+	/** Longest time spent sending a single packet in microseconds. */
+	uint32_t send_time_max_us;
+};
+
 /** @brief nRF RPC IPC Service transport instance. */
 struct nrf_rpc_ipc {
 	const struct device *ipc;
@@ -58,6 +82,22 @@ struct nrf_rpc_ipc {
 
 	/** Indicates if transport is already initialized. */
 	bool used;
+
+	/** Indicates if Tx buffers are allocated from the IPC Service shared memory. */
+	bool nocopy;
+
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_STATS)
+	/** Transport statistics. */
+	struct {
+		atomic_t sent;
+		atomic_t sent_nocopy;
+		atomic_t alloc_failures;
+		atomic_t heap_allocs;
+		atomic_t send_time_max_us;
+		struct k_spinlock lock;
+		uint64_t send_time_us;
+	} stats;
+#endif
 };
 
 /** @brief Extern nRF RPC IPC Service transport declaration.
@@ -121,6 +161,19 @@ struct nrf_rpc_ipc {
 		.ctx = &_name##_instance                                     \
 	}
 
+/** @brief Get the statistics of the nRF RPC IPC Service transport.
+ *
+ * Requires the @kconfig{CONFIG_NRF_RPC_IPC_SERVICE_STATS} option.
+ *
+ * @param[in] transport nRF RPC IPC Service transport instance.
+ * @param[out] stats Statistics of the transport.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOTSUP Statistics are disabled.
+ */
+int nrf_rpc_ipc_stats_get(const struct nrf_rpc_tr *transport, struct nrf_rpc_ipc_stats *stats);
+
 /**
  * @}
  */
@@ -15,17 +15,205 @@
 
 LOG_MODULE_REGISTER(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
 
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+#define MATCHED_WORDS DIV_ROUND_UP(CONFIG_AT_MONITOR_FILTER_TRIE_MONITORS, 32)
+#endif
+
 struct at_notif_fifo {
 	void *fifo_reserved;
+	atomic_t ref; /* Number of references, the notification is released at zero */
+	uint16_t len; /* Notification length, without the null-terminator */
+	uint16_t size; /* Size taken from the heap or the ring, including this header */
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+	uint32_t matched[MATCHED_WORDS]; /* Deferred monitors matching the notification */
+#endif
 	char data[]; /* Null-terminated AT notification string */
 };
 
 static void at_monitor_task(struct k_work *work);
 
 static K_FIFO_DEFINE(at_monitor_fifo);
-static K_HEAP_DEFINE(at_monitor_heap, CONFIG_AT_MONITOR_HEAP_SIZE);
 static K_WORK_DEFINE(at_monitor_work, at_monitor_task);
 
+static atomic_t notif_cnt;
+static atomic_t dropped_cnt;
+static atomic_t used;
+static atomic_t used_max;
+
+#if defined(CONFIG_AT_MONITOR_RING)
+/* Notifications are stored in order. Space is reclaimed from the oldest notification
+ * once it is released, so a notification held by a monitor holds back the ones after it.
+ */
+static uint8_t ring_buf[CONFIG_AT_MONITOR_HEAP_SIZE] __aligned(sizeof(void *));
+static size_t ring_head;
+static size_t ring_tail;
+static size_t ring_end = sizeof(ring_buf); /* End of valid data when wrapped */
+static struct k_spinlock ring_lock;
+
+static struct at_notif_fifo *ring_alloc(size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	struct at_notif_fifo *at_notif = NULL;
+
+	if (atomic_get(&used) == 0) {
+		ring_head = 0;
+		ring_tail = 0;
+		ring_end = sizeof(ring_buf);
+	}
+
+	if (ring_head > ring_tail || atomic_get(&used) == 0) {
+		if (size <= sizeof(ring_buf) - ring_head) {
+			at_notif = (struct at_notif_fifo *)&ring_buf[ring_head];
+			ring_head += size;
+		} else if (size <= ring_tail) {
+			/* Wrap around, the space at the end is skipped */
+			ring_end = ring_head;
+			at_notif = (struct at_notif_fifo *)&ring_buf[0];
+			ring_head = size;
+		}
+	} else if (size <= ring_tail - ring_head) {
+		at_notif = (struct at_notif_fifo *)&ring_buf[ring_head];
+		ring_head += size;
+	}
+
+	if (at_notif) {
+		at_notif->size = size;
+		atomic_set(&at_notif->ref, 1);
+		atomic_add(&used, size);
+	}
+
+	k_spin_unlock(&ring_lock, key);
+
+	return at_notif;
+}
+
+static void ring_reclaim(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	struct at_notif_fifo *at_notif;
+
+	while (atomic_get(&used)) {
+		at_notif = (struct at_notif_fifo *)&ring_buf[ring_tail];
+		if (atomic_get(&at_notif->ref)) {
+			break;
+		}
+
+		ring_tail += at_notif->size;
+		atomic_sub(&used, at_notif->size);
+
+		if (ring_tail == ring_end) {
+			ring_tail = 0;
+			ring_end = sizeof(ring_buf);
+		}
+	}
+
+	k_spin_unlock(&ring_lock, key);
+}
+#else
+static K_HEAP_DEFINE(at_monitor_heap, CONFIG_AT_MONITOR_HEAP_SIZE);
+#endif /* CONFIG_AT_MONITOR_RING */
+
+static void used_max_update(atomic_val_t val)
+{
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&used_max);
+		if (val <= max) {
+			return;
+		}
+	} while (!atomic_cas(&used_max, max, val));
+}
+
+/* Allocate a notification with one reference, for the workqueue task. Called from an ISR. */
+static struct at_notif_fifo *notif_alloc(size_t len)
+{
+	struct at_notif_fifo *at_notif;
+	size_t size = ROUND_UP(sizeof(struct at_notif_fifo) + len + sizeof(char), sizeof(void *));
+
+	atomic_inc(&notif_cnt);
+
+	if (len > UINT16_MAX) {
+		atomic_inc(&dropped_cnt);
+		return NULL;
+	}
+
+#if defined(CONFIG_AT_MONITOR_RING)
+	at_notif = ring_alloc(size);
+#else
+	at_notif = k_heap_alloc(&at_monitor_heap, size, K_NO_WAIT);
+	if (at_notif) {
+		at_notif->size = size;
+		atomic_set(&at_notif->ref, 1);
+		atomic_add(&used, size);
+	}
+#endif
+	if (!at_notif) {
+		atomic_inc(&dropped_cnt);
+		return NULL;
+	}
+
+	used_max_update(atomic_get(&used));
+	at_notif->len = len;
+
+	return at_notif;
+}
+
+static void notif_unref(struct at_notif_fifo *at_notif)
+{
+	if (atomic_dec(&at_notif->ref) != 1) {
+		return;
+	}
+
+#if defined(CONFIG_AT_MONITOR_RING)
+	ring_reclaim();
+#else
+	atomic_sub(&used, at_notif->size);
+	k_heap_free(&at_monitor_heap, at_notif);
+#endif
+}
+
+static struct at_notif_fifo *notif_from_data(const char *notif)
+{
+	return CONTAINER_OF(notif, struct at_notif_fifo, data);
+}
+
+size_t at_monitor_notif_len(const char *notif)
+{
+	__ASSERT_NO_MSG(notif != NULL);
+
+	return notif_from_data(notif)->len;
+}
+
+void at_monitor_notif_ref(const char *notif)
+{
+	__ASSERT_NO_MSG(notif != NULL);
+
+	atomic_inc(&notif_from_data(notif)->ref);
+}
+
+void at_monitor_notif_unref(const char *notif)
+{
+	__ASSERT_NO_MSG(notif != NULL);
+
+	notif_unref(notif_from_data(notif));
+}
+
+int at_monitor_stats_get(struct at_monitor_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	stats->notif_cnt = atomic_get(&notif_cnt);
+	stats->dropped_cnt = atomic_get(&dropped_cnt);
+	stats->used = atomic_get(&used);
+	stats->used_max = atomic_get(&used_max);
+	stats->size = CONFIG_AT_MONITOR_HEAP_SIZE;
+
+	return 0;
+}
+
 static bool is_paused(const struct at_monitor_entry *mon)
 {
 	return mon->flags.paused;
@@ -41,6 +229,240 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+
+/* Aho-Corasick automaton built from the monitor filters.
+ * Node 0 is the root, so index 0 also means "no node" for child and sibling links.
+ */
+struct trie_node {
+	uint16_t child;   /* First child */
+	uint16_t sibling; /* Next sibling */
+	uint16_t fail;	  /* Longest proper suffix that is a node */
+	uint16_t dict;	  /* Longest proper suffix that ends a filter */
+	uint16_t out;	  /* First monitor ending at this node, plus one */
+	char c;
+	uint8_t depth;
+};
+
+extern struct at_monitor_entry _at_monitor_entry_list_start[];
+extern struct at_monitor_entry _at_monitor_entry_list_end[];
+
+static struct trie_node trie[CONFIG_AT_MONITOR_FILTER_TRIE_NODES];
+/* Next monitor ending at the same node, plus one */
+static uint16_t trie_out_next[CONFIG_AT_MONITOR_FILTER_TRIE_MONITORS];
+/* Monitors matching any notification */
+static uint32_t trie_any[MATCHED_WORDS];
+static size_t trie_node_cnt;
+static bool trie_ready;
+
+static uint16_t trie_goto(uint16_t node, char c)
+{
+	for (uint16_t n = trie[node].child; n; n = trie[n].sibling) {
+		if (trie[n].c == c) {
+			return n;
+		}
+	}
+
+	return 0;
+}
+
+static int trie_insert(const char *filter, uint16_t mon_idx)
+{
+	uint16_t node = 0;
+	uint16_t next;
+
+	for (const char *c = filter; *c; c++) {
+		next = trie_goto(node, *c);
+		if (!next) {
+			if (trie_node_cnt == ARRAY_SIZE(trie) || trie[node].depth == UINT8_MAX) {
+				return -ENOMEM;
+			}
+
+			next = trie_node_cnt++;
+			trie[next].c = *c;
+			trie[next].depth = trie[node].depth + 1;
+			trie[next].sibling = trie[node].child;
+			trie[node].child = next;
+		}
+		node = next;
+	}
+
+	trie_out_next[mon_idx] = trie[node].out;
+	trie[node].out = mon_idx + 1;
+
+	return 0;
+}
+
+static void trie_links_build(void)
+{
+	uint8_t depth_max = 0;
+
+	for (size_t i = 1; i < trie_node_cnt; i++) {
+		depth_max = MAX(depth_max, trie[i].depth);
+	}
+
+	/* Suffix links of a node only depend on shallower nodes, so build them by depth.
+	 * Nodes at depth one keep the root as suffix.
+	 */
+	for (uint8_t depth = 1; depth < depth_max; depth++) {
+		for (size_t i = 0; i < trie_node_cnt; i++) {
+			if (trie[i].depth != depth) {
+				continue;
+			}
+
+			for (uint16_t n = trie[i].child; n; n = trie[n].sibling) {
+				uint16_t f = trie[i].fail;
+
+				while (f && !trie_goto(f, trie[n].c)) {
+					f = trie[f].fail;
+				}
+
+				trie[n].fail = trie_goto(f, trie[n].c);
+				trie[n].dict = trie[trie[n].fail].out ? trie[n].fail
+								      : trie[trie[n].fail].dict;
+			}
+		}
+	}
+}
+
+static int trie_build(void)
+{
+	size_t mon_cnt = _at_monitor_entry_list_end - _at_monitor_entry_list_start;
+	int err;
+
+	if (mon_cnt > CONFIG_AT_MONITOR_FILTER_TRIE_MONITORS) {
+		return -ENOMEM;
+	}
+
+	trie_node_cnt = 1;
+
+	for (size_t i = 0; i < mon_cnt; i++) {
+		const char *filter = _at_monitor_entry_list_start[i].filter;
+
+		if (filter == ANY || filter[0] == '\0') {
+			trie_any[i / 32] |= BIT(i % 32);
+			continue;
+		}
+
+		err = trie_insert(filter, i);
+		if (err) {
+			return err;
+		}
+	}
+
+	trie_links_build();
+
+	return 0;
+}
+
+static void trie_out_mark(uint16_t node, uint32_t *matched)
+{
+	for (uint16_t m = trie[node].out; m; m = trie_out_next[m - 1]) {
+		matched[(m - 1) / 32] |= BIT((m - 1) % 32);
+	}
+}
+
+/* Set the bits of all monitors whose filter occurs in the notification.
+ * Returns the length of the notification.
+ */
+static size_t trie_match(const char *notif, uint32_t *matched)
+{
+	const char *c;
+	uint16_t node = 0;
+	uint16_t next;
+
+	memcpy(matched, trie_any, sizeof(trie_any));
+
+	for (c = notif; *c; c++) {
+		while (!(next = trie_goto(node, *c)) && node) {
+			node = trie[node].fail;
+		}
+		node = next;
+
+		for (uint16_t n = node; n; n = trie[n].dict) {
+			trie_out_mark(n, matched);
+		}
+	}
+
+	return c - notif;
+}
+
+/* Dispatch to ISR monitors and schedule the deferred ones, matching the notification once. */
+static void trie_dispatch(const char *notif)
+{
+	uint32_t matched[MATCHED_WORDS];
+	bool monitored = false;
+	struct at_notif_fifo *at_notif;
+	size_t len;
+
+	len = trie_match(notif, matched);
+
+	for (size_t w = 0; w < MATCHED_WORDS; w++) {
+		uint32_t bits = matched[w];
+
+		while (bits) {
+			uint32_t bit = find_lsb_set(bits) - 1;
+			struct at_monitor_entry *e = &_at_monitor_entry_list_start[w * 32 + bit];
+
+			bits &= ~BIT(bit);
+
+			if (is_paused(e) || is_direct(e)) {
+				matched[w] &= ~BIT(bit);
+			}
+
+			if (is_paused(e)) {
+				continue;
+			}
+
+			if (is_direct(e)) {
+				LOG_DBG("Dispatching to %p (ISR)", e->handler);
+				e->handler(notif);
+			} else {
+				monitored = true;
+			}
+		}
+	}
+
+	if (!monitored) {
+		return;
+	}
+
+	at_notif = notif_alloc(len);
+	if (!at_notif) {
+		LOG_WRN("No space for incoming notification: %s",
+			notif);
+		return;
+	}
+
+	memcpy(at_notif->matched, matched, sizeof(matched));
+	memcpy(at_notif->data, notif, len + 1);
+
+	k_fifo_put(&at_monitor_fifo, at_notif);
+	k_work_submit(&at_monitor_work);
+}
+
+static void trie_notif_dispatch(struct at_notif_fifo *at_notif)
+{
+	for (size_t w = 0; w < MATCHED_WORDS; w++) {
+		uint32_t bits = at_notif->matched[w];
+
+		while (bits) {
+			uint32_t bit = find_lsb_set(bits) - 1;
+			struct at_monitor_entry *e = &_at_monitor_entry_list_start[w * 32 + bit];
+
+			bits &= ~BIT(bit);
+
+			/* The monitor could have been paused after the notification was matched */
+			if (!is_paused(e)) {
+				LOG_DBG("Dispatching to %p", e->handler);
+				e->handler(at_notif->data);
+			}
+		}
+	}
+}
+
+#endif /* CONFIG_AT_MONITOR_FILTER_TRIE */
+
 /* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
  * Keep this function public so that it can be called by tests.
  * This function is called from an ISR.
@@ -49,10 +471,17 @@ void at_monitor_dispatch(const char *notif)
 {
 	bool monitored;
 	struct at_notif_fifo *at_notif;
-	size_t sz_needed;
+	size_t len;
 
 	__ASSERT_NO_MSG(notif != NULL);
 
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+	if (trie_ready) {
+		trie_dispatch(notif);
+		return;
+	}
+#endif
+
 	monitored = false;
 	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 		if (!is_paused(e) && has_match(e, notif)) {
@@ -71,16 +500,16 @@ void at_monitor_dispatch(const char *notif)
 		return;
 	}
 
-	sz_needed = sizeof(struct at_notif_fifo) + strlen(notif) + sizeof(char);
+	len = strlen(notif);
 
-	at_notif = k_heap_alloc(&at_monitor_heap, sz_needed, K_NO_WAIT);
+	at_notif = notif_alloc(len);
 	if (!at_notif) {
-		LOG_WRN("No heap space for incoming notification: %s",
+		LOG_WRN("No space for incoming notification: %s",
 			notif);
 		return;
 	}
 
-	strcpy(at_notif->data, notif);
+	memcpy(at_notif->data, notif, len + 1);
 
 	k_fifo_put(&at_monitor_fifo, at_notif);
 	k_work_submit(&at_monitor_work);
@@ -92,14 +521,21 @@ static void at_monitor_task(struct k_work *work)
 
 	while ((at_notif = k_fifo_get(&at_monitor_fifo, K_NO_WAIT))) {
 		/* Match notification with all monitors */
-		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
+		LOG_DBG("AT notif: %.*s", at_notif->len - strlen("\r\n"), at_notif->data);
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+		if (trie_ready) {
+			trie_notif_dispatch(at_notif);
+			notif_unref(at_notif);
+			continue;
+		}
+#endif
 		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
 				LOG_DBG("Dispatching to %p", e->handler);
 				e->handler(at_notif->data);
 			}
 		}
-		k_heap_free(&at_monitor_heap, at_notif);
+		notif_unref(at_notif);
 	}
 }
 
@@ -107,6 +543,17 @@ static int at_monitor_sys_init(const struct device *unused)
 {
 	int err;
 
+#if defined(CONFIG_AT_MONITOR_FILTER_TRIE)
+	err = trie_build();
+	if (err) {
+		LOG_WRN("Too many monitors or filter characters for the automaton, "
+			"falling back to matching each filter");
+	} else {
+		LOG_DBG("Automaton built with %zu nodes", trie_node_cnt);
+		trie_ready = true;
+	}
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
@@ -0,0 +1,675 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <modem/nrf_modem_lib_trace.h>
+#include <modem/trace_backend.h>
+#include <pm_config.h>
+
+LOG_MODULE_REGISTER(modem_trace_backend, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
+
+#define TRACE_BLOCK_SIZE CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_BLOCK_SIZE
+#define TRACE_SECTOR_SIZE CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_SECTOR_SIZE
+#define TRACE_RECORD_MAGIC 0x5254
+/* Largest flash write block size the records can be padded to. */
+#define TRACE_FLASH_ALIGN_MAX 16
+
+#define LZ_HASH_BITS 10
+#define LZ_MIN_MATCH 4
+/* The last literals and the minimum distance of the last match to the end of a block are those
+ * of the LZ4 block format, so that stored blocks can be decoded by LZ4 tools.
+ */
+#define LZ_LAST_LITERALS 5
+#define LZ_MFLIMIT 12
+
+/**
+ * @brief Header of a trace record, in the RAM ring and in flash.
+ *
+ * A record holds a block of trace data, LZ4 block compressed if @c len is less than
+ * @c raw_len and stored as is otherwise.
+ */
+struct trace_record_hdr {
+	uint16_t magic;
+	uint16_t len;
+	uint16_t raw_len;
+	uint16_t crc;
+};
+
+/* Blocks that do not compress are stored as is, so a record is never larger than this. */
+#define TRACE_RECORD_MAX (sizeof(struct trace_record_hdr) + TRACE_BLOCK_SIZE)
+
+BUILD_ASSERT(TRACE_BLOCK_SIZE <= UINT16_MAX, "Trace block too large for the record header");
+BUILD_ASSERT(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_RING_SIZE >= 2 * TRACE_RECORD_MAX,
+	     "Trace ring too small for the trace block size");
+
+static trace_backend_processed_cb trace_processed_callback;
+
+/* Trace data being collected into a block, protected by stage_mutex. */
+static K_MUTEX_DEFINE(stage_mutex);
+static uint8_t stage[TRACE_BLOCK_SIZE];
+static size_t stage_len;
+static uint8_t stage_record[TRACE_RECORD_MAX] __aligned(4);
+static uint16_t lz_table[1 << LZ_HASH_BITS];
+
+/* Compressed records waiting to be written to flash. */
+static K_MUTEX_DEFINE(ring_mutex);
+RING_BUF_DECLARE(trace_ring, CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_RING_SIZE);
+static K_SEM_DEFINE(spill_sem, 0, 1);
+static K_SEM_DEFINE(space_sem, 0, 1);
+static K_SEM_DEFINE(flush_sem, 0, 1);
+
+/* Trace partition, protected by flash_mutex. */
+static K_MUTEX_DEFINE(flash_mutex);
+static const struct flash_area *fa;
+static uint8_t flash_align;
+static off_t write_off;
+static off_t erased_end;
+static size_t dropped;
+static uint8_t spill_record[TRACE_RECORD_MAX + TRACE_FLASH_ALIGN_MAX] __aligned(4);
+
+/* Read position and the block decompressed last. */
+static off_t read_off;
+static uint8_t read_record[TRACE_RECORD_MAX] __aligned(4);
+static uint8_t read_block[TRACE_BLOCK_SIZE];
+static size_t read_block_len;
+static size_t read_block_pos;
+
+static uint32_t lz_hash(const uint8_t *p)
+{
+	return (sys_get_le32(p) * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+/* Size of a sequence with the given literal and match lengths, match length 0 for none. */
+static size_t lz_sequence_size(size_t lit_len, size_t match_len)
+{
+	size_t size = 1 + lit_len;
+
+	if (lit_len >= 15) {
+		size += (lit_len - 15) / 255 + 1;
+	}
+
+	if (match_len) {
+		match_len -= LZ_MIN_MATCH;
+		size += 2;
+
+		if (match_len >= 15) {
+			size += (match_len - 15) / 255 + 1;
+		}
+	}
+
+	return size;
+}
+
+static uint8_t *lz_len_put(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+
+	*op++ = len;
+
+	return op;
+}
+
+static uint8_t *lz_sequence_put(uint8_t *op, const uint8_t *lit, size_t lit_len, size_t offset,
+				size_t match_len)
+{
+	uint8_t *token = op++;
+
+	*token = MIN(lit_len, 15) << 4;
+	if (lit_len >= 15) {
+		op = lz_len_put(op, lit_len - 15);
+	}
+
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	if (offset) {
+		match_len -= LZ_MIN_MATCH;
+
+		*token |= MIN(match_len, 15);
+		sys_put_le16(offset, op);
+		op += 2;
+
+		if (match_len >= 15) {
+			op = lz_len_put(op, match_len - 15);
+		}
+	}
+
+	return op;
+}
+
+/* Greedy LZ4 block compression. Returns the compressed length or 0 if it would not fit. */
+static size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst, size_t cap)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *end = src + len;
+	const uint8_t *mflimit = (len > LZ_MFLIMIT) ? (end - LZ_MFLIMIT) : src;
+	const uint8_t *mlimit = end - LZ_LAST_LITERALS;
+	uint8_t *op = dst;
+	size_t lit_len;
+
+	memset(lz_table, 0, sizeof(lz_table));
+
+	while (ip < mflimit) {
+		uint32_t h = lz_hash(ip);
+		const uint8_t *ref = src + lz_table[h];
+		const uint8_t *mp;
+
+		lz_table[h] = ip - src;
+
+		if ((ref >= ip) || (sys_get_le32(ref) != sys_get_le32(ip))) {
+			ip++;
+			continue;
+		}
+
+		mp = ip + LZ_MIN_MATCH;
+		while ((mp < mlimit) && (*mp == ref[mp - ip])) {
+			mp++;
+		}
+
+		lit_len = ip - anchor;
+		if ((op - dst) + lz_sequence_size(lit_len, mp - ip) > cap) {
+			return 0;
+		}
+
+		op = lz_sequence_put(op, anchor, lit_len, ip - ref, mp - ip);
+		ip = mp;
+		anchor = ip;
+	}
+
+	lit_len = end - anchor;
+	if ((op - dst) + lz_sequence_size(lit_len, 0) > cap) {
+		return 0;
+	}
+
+	op = lz_sequence_put(op, anchor, lit_len, 0, 0);
+
+	return op - dst;
+}
+
+static int lz_len_get(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*ip >= iend) {
+			return -EINVAL;
+		}
+
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 255);
+
+	return 0;
+}
+
+static int lz_decompress(const uint8_t *src, size_t len, uint8_t *dst, size_t cap)
+{
+	const uint8_t *ip = src;
+	const uint8_t *iend = src + len;
+	uint8_t *op = dst;
+	uint8_t *oend = dst + cap;
+
+	while (ip < iend) {
+		uint8_t token = *ip++;
+		size_t lit_len = token >> 4;
+		size_t match_len = token & 15;
+		size_t offset;
+
+		if ((lit_len == 15) && lz_len_get(&ip, iend, &lit_len)) {
+			return -EINVAL;
+		}
+
+		if ((lit_len > (size_t)(iend - ip)) || (lit_len > (size_t)(oend - op))) {
+			return -EINVAL;
+		}
+
+		memcpy(op, ip, lit_len);
+		op += lit_len;
+		ip += lit_len;
+
+		/* The last sequence has literals only. */
+		if (ip == iend) {
+			break;
+		}
+
+		if ((iend - ip) < 2) {
+			return -EINVAL;
+		}
+
+		offset = sys_get_le16(ip);
+		ip += 2;
+
+		if ((match_len == 15) && lz_len_get(&ip, iend, &match_len)) {
+			return -EINVAL;
+		}
+
+		match_len += LZ_MIN_MATCH;
+
+		if ((offset == 0) || (offset > (size_t)(op - dst)) ||
+		    (match_len > (size_t)(oend - op))) {
+			return -EINVAL;
+		}
+
+		/* Byte by byte, as the match can overlap the output. */
+		for (const uint8_t *ref = op - offset; match_len; match_len--) {
+			*op++ = *ref++;
+		}
+	}
+
+	return op - dst;
+}
+
+static bool record_hdr_valid(const struct trace_record_hdr *hdr)
+{
+	return (hdr->magic == TRACE_RECORD_MAGIC) && (hdr->len > 0) &&
+	       (hdr->len <= hdr->raw_len) && (hdr->raw_len <= TRACE_BLOCK_SIZE);
+}
+
+static bool record_hdr_erased(const struct trace_record_hdr *hdr)
+{
+	return (hdr->magic == UINT16_MAX) && (hdr->len == UINT16_MAX);
+}
+
+static size_t record_size(const struct trace_record_hdr *hdr)
+{
+	return ROUND_UP(sizeof(*hdr) + hdr->len, flash_align);
+}
+
+static void ring_record_put(const void *record, size_t len)
+{
+	while (true) {
+		k_mutex_lock(&ring_mutex, K_FOREVER);
+
+		if (ring_buf_space_get(&trace_ring) >= len) {
+			(void)ring_buf_put(&trace_ring, record, len);
+			k_mutex_unlock(&ring_mutex);
+			break;
+		}
+
+		k_mutex_unlock(&ring_mutex);
+
+		/* Flash is slower than the modem, wait for the spill thread. */
+		k_sem_take(&space_sem, K_FOREVER);
+	}
+
+	k_sem_give(&spill_sem);
+}
+
+static bool ring_record_get(void *record)
+{
+	struct trace_record_hdr *hdr = record;
+	bool found = false;
+
+	k_mutex_lock(&ring_mutex, K_FOREVER);
+
+	if (!ring_buf_is_empty(&trace_ring)) {
+		(void)ring_buf_get(&trace_ring, record, sizeof(*hdr));
+		(void)ring_buf_get(&trace_ring, (uint8_t *)record + sizeof(*hdr), hdr->len);
+		found = true;
+	}
+
+	k_mutex_unlock(&ring_mutex);
+
+	if (found) {
+		k_sem_give(&space_sem);
+	}
+
+	return found;
+}
+
+/* Compress the collected trace data into a record. Called with stage_mutex held. */
+static void stage_commit(void)
+{
+	struct trace_record_hdr *hdr = (struct trace_record_hdr *)stage_record;
+	uint8_t *payload = stage_record + sizeof(*hdr);
+	size_t len;
+
+	if (!stage_len) {
+		return;
+	}
+
+	len = lz_compress(stage, stage_len, payload, stage_len - 1);
+	if (!len) {
+		memcpy(payload, stage, stage_len);
+		len = stage_len;
+	}
+
+	hdr->magic = TRACE_RECORD_MAGIC;
+	hdr->len = len;
+	hdr->raw_len = stage_len;
+	hdr->crc = crc16_ccitt(0, payload, len);
+
+	ring_record_put(stage_record, sizeof(*hdr) + len);
+
+	stage_len = 0;
+}
+
+/* Write all collected trace data to flash. */
+static void trace_flush(void)
+{
+	const struct trace_record_hdr marker = {
+		.magic = TRACE_RECORD_MAGIC,
+	};
+
+	k_mutex_lock(&stage_mutex, K_FOREVER);
+
+	stage_commit();
+
+	/* The spill thread signals the marker once the records before it are written. */
+	ring_record_put(&marker, sizeof(marker));
+	k_sem_take(&flush_sem, K_FOREVER);
+
+	k_mutex_unlock(&stage_mutex);
+}
+
+/* Called with flash_mutex held. */
+static void record_spill(struct trace_record_hdr *hdr)
+{
+	size_t size = record_size(hdr);
+	int err;
+
+	if (!fa || (write_off + size > fa->fa_size)) {
+		if (!dropped) {
+			LOG_WRN("Trace partition is full, dropping traces");
+		}
+
+		dropped += hdr->raw_len;
+		return;
+	}
+
+	while (write_off + size > erased_end) {
+		err = flash_area_erase(fa, erased_end, TRACE_SECTOR_SIZE);
+		if (err) {
+			LOG_ERR("Failed to erase trace partition at 0x%lx, err: %d",
+				(long)erased_end, err);
+			dropped += hdr->raw_len;
+			return;
+		}
+
+		erased_end += TRACE_SECTOR_SIZE;
+	}
+
+	memset((uint8_t *)hdr + sizeof(*hdr) + hdr->len, 0xff,
+	       size - sizeof(*hdr) - hdr->len);
+
+	err = flash_area_write(fa, write_off, hdr, size);
+	if (err) {
+		LOG_ERR("Failed to write trace partition at 0x%lx, err: %d", (long)write_off, err);
+		dropped += hdr->raw_len;
+		/* The record may be partially written, continue in the next sector. */
+		write_off = MIN(ROUND_UP(write_off + 1, TRACE_SECTOR_SIZE), fa->fa_size);
+		return;
+	}
+
+	write_off += size;
+}
+
+static void trace_spill_thread(void)
+{
+	struct trace_record_hdr *hdr = (struct trace_record_hdr *)spill_record;
+
+	while (true) {
+		k_sem_take(&spill_sem, K_FOREVER);
+
+		while (ring_record_get(spill_record)) {
+			if (!hdr->len) {
+				k_sem_give(&flush_sem);
+				continue;
+			}
+
+			k_mutex_lock(&flash_mutex, K_FOREVER);
+			record_spill(hdr);
+			k_mutex_unlock(&flash_mutex);
+		}
+	}
+}
+
+/* Open the trace partition and find the end of the stored traces. Called with flash_mutex held.
+ *
+ * Records are written back to back. Invalid data, like a record torn by a reset, is skipped up
+ * to the next sector, where the writer continued.
+ */
+static int trace_flash_open(void)
+{
+	struct trace_record_hdr hdr;
+	off_t off = 0;
+	int err;
+
+	if (fa) {
+		return 0;
+	}
+
+	err = flash_area_open(PM_MODEM_TRACE_ID, &fa);
+	if (err) {
+		LOG_ERR("Failed to open trace partition, err: %d", err);
+		return err;
+	}
+
+	flash_align = MAX(flash_area_align(fa), 1);
+	if ((flash_align > TRACE_FLASH_ALIGN_MAX) || (fa->fa_size % TRACE_SECTOR_SIZE)) {
+		LOG_ERR("Unsupported trace partition layout");
+		flash_area_close(fa);
+		fa = NULL;
+		return -ENOTSUP;
+	}
+
+	while (off + sizeof(hdr) <= fa->fa_size) {
+		err = flash_area_read(fa, off, &hdr, sizeof(hdr));
+		if (err) {
+			break;
+		}
+
+		if (record_hdr_erased(&hdr)) {
+			break;
+		}
+
+		if (record_hdr_valid(&hdr) && (off + record_size(&hdr) <= fa->fa_size)) {
+			off += record_size(&hdr);
+		} else {
+			off = ROUND_UP(off + 1, TRACE_SECTOR_SIZE);
+		}
+	}
+
+	write_off = MIN(off, fa->fa_size);
+	erased_end = ROUND_UP(write_off, TRACE_SECTOR_SIZE);
+
+	LOG_INF("Trace partition: %ld of %u bytes used", (long)write_off, (unsigned int)fa->fa_size);
+
+	return 0;
+}
+
+/* Decompress the next record into the read block. Called with flash_mutex held. */
+static int record_read(void)
+{
+	struct trace_record_hdr *hdr = (struct trace_record_hdr *)read_record;
+	uint8_t *payload = read_record + sizeof(*hdr);
+	int err;
+	int len;
+
+	while (read_off < write_off) {
+		err = flash_area_read(fa, read_off, hdr, sizeof(*hdr));
+		if (err) {
+			return err;
+		}
+
+		if (!record_hdr_valid(hdr) || (read_off + record_size(hdr) > write_off)) {
+			read_off = ROUND_UP(read_off + 1, TRACE_SECTOR_SIZE);
+			continue;
+		}
+
+		read_off += record_size(hdr);
+
+		err = flash_area_read(fa, read_off - record_size(hdr) + sizeof(*hdr), payload,
+				      hdr->len);
+		if (err) {
+			return err;
+		}
+
+		if (crc16_ccitt(0, payload, hdr->len) != hdr->crc) {
+			LOG_WRN("Skipping corrupt trace record");
+			continue;
+		}
+
+		if (hdr->len == hdr->raw_len) {
+			memcpy(read_block, payload, hdr->len);
+			len = hdr->len;
+		} else {
+			len = lz_decompress(payload, hdr->len, read_block, sizeof(read_block));
+		}
+
+		if (len != hdr->raw_len) {
+			LOG_WRN("Skipping corrupt trace record");
+			continue;
+		}
+
+		read_block_len = len;
+		read_block_pos = 0;
+
+		return 0;
+	}
+
+	return -ENODATA;
+}
+
+int trace_backend_init(trace_backend_processed_cb trace_processed_cb)
+{
+	int err;
+
+	if (trace_processed_cb == NULL) {
+		return -EFAULT;
+	}
+
+	trace_processed_callback = trace_processed_cb;
+
+	k_mutex_lock(&flash_mutex, K_FOREVER);
+	err = trace_flash_open();
+	k_mutex_unlock(&flash_mutex);
+
+	return err;
+}
+
+int trace_backend_deinit(void)
+{
+	trace_flush();
+
+	k_mutex_lock(&flash_mutex, K_FOREVER);
+
+	if (dropped) {
+		LOG_WRN("%u bytes of traces did not fit in the trace partition",
+			(unsigned int)dropped);
+	}
+
+	/* The partition is scanned again when it is reopened. */
+	if (fa) {
+		flash_area_close(fa);
+		fa = NULL;
+	}
+
+	k_mutex_unlock(&flash_mutex);
+
+	return 0;
+}
+
+int trace_backend_write(const void *data, size_t len)
+{
+	int err;
+
+	k_mutex_lock(&stage_mutex, K_FOREVER);
+
+	len = MIN(len, sizeof(stage) - stage_len);
+	memcpy(&stage[stage_len], data, len);
+	stage_len += len;
+
+	if (stage_len == sizeof(stage)) {
+		stage_commit();
+	}
+
+	k_mutex_unlock(&stage_mutex);
+
+	/* The modem trace buffer is released as soon as the data is staged. */
+	err = trace_processed_callback(len);
+	if (err) {
+		return err;
+	}
+
+	return (int)len;
+}
+
+int nrf_modem_lib_trace_read(uint8_t *buf, size_t len)
+{
+	bool flushed = false;
+	int err;
+
+	k_mutex_lock(&flash_mutex, K_FOREVER);
+
+	err = trace_flash_open();
+
+	while (!err && (read_block_pos == read_block_len)) {
+		err = record_read();
+
+		/* Write out the traces collected in RAM once the reader has caught up. */
+		if ((err == -ENODATA) && !flushed) {
+			k_mutex_unlock(&flash_mutex);
+			trace_flush();
+			k_mutex_lock(&flash_mutex, K_FOREVER);
+
+			flushed = true;
+			err = 0;
+		}
+	}
+
+	if (!err) {
+		len = MIN(len, read_block_len - read_block_pos);
+		memcpy(buf, &read_block[read_block_pos], len);
+		read_block_pos += len;
+	}
+
+	k_mutex_unlock(&flash_mutex);
+
+	return err ? err : (int)len;
+}
+
+int nrf_modem_lib_trace_clear(void)
+{
+	int err;
+
+	/* Let the records in the ring reach flash before they are erased with the rest. */
+	trace_flush();
+
+	k_mutex_lock(&flash_mutex, K_FOREVER);
+
+	err = trace_flash_open();
+	if (!err) {
+		err = flash_area_erase(fa, 0, fa->fa_size);
+	}
+
+	if (!err) {
+		write_off = 0;
+		erased_end = fa->fa_size;
+		read_off = 0;
+		read_block_len = 0;
+		read_block_pos = 0;
+		dropped = 0;
+	}
+
+	k_mutex_unlock(&flash_mutex);
+
+	return err;
+}
+
+K_THREAD_DEFINE(trace_spill_thread_id, CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_STACK_SIZE,
+		trace_spill_thread, NULL, NULL, NULL,
+		CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_THREAD_PRIO, 0, 0);
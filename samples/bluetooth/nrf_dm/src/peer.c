@@ -170,6 +170,17 @@ static void print_result(struct dm_result *result)
 			result->dist_estimates.mcpd.rssi_openspace,
 			result->dist_estimates.mcpd.best);
 	}
+
+	if (IS_ENABLED(CONFIG_DM_STATS)) {
+		struct dm_peer_stats stats;
+
+		if (dm_peer_stats_get(&result->bt_addr, &stats) == 0) {
+			printk("\tRanging rate: %u.%02u/s (dropped %u)\n",
+				stats.ranging_rate / SEC_PER_MIN,
+				(stats.ranging_rate % SEC_PER_MIN) * 100 / SEC_PER_MIN,
+				stats.dropped);
+		}
+	}
 }
 
 static void timeout_handler(struct k_timer *timer_id)
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
 #include <app_event_manager.h>
@@ -19,8 +20,29 @@ static void event_processor_fn(struct k_work *work);
 
 struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
+/* Queue of events of a given priority class. */
+struct event_lane {
+	sys_slist_t queue;
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	uint32_t depth;
+	uint32_t max_depth;
+	uint32_t processed_cnt;
+	uint64_t latency_sum;
+	uint32_t latency_max;
+#endif
+};
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DEDICATED_WORKQUEUE)
+static K_THREAD_STACK_DEFINE(event_processor_stack,
+			     CONFIG_APP_EVENT_MANAGER_WORKQUEUE_STACK_SIZE);
+static struct k_work_q event_processor_wq;
+#define EVENT_PROCESSOR_WQ (&event_processor_wq)
+#else
+#define EVENT_PROCESSOR_WQ (&k_sys_work_q)
+#endif
+
 static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+static struct event_lane lanes[APP_EVENT_MANAGER_LANE_COUNT];
 static struct k_spinlock lock;
 
 static bool log_is_event_displayed(const struct event_type *et)
@@ -77,7 +99,7 @@ static void log_event(const struct app_event_header *aeh)
 }
 
 static void log_event_progress(const struct event_type *et,
-			       const struct event_listener *el)
+			       const struct event_subscriber *es)
 {
 	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SHOW_EVENTS) ||
 	    !IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SHOW_EVENT_HANDLERS) ||
@@ -85,6 +107,10 @@ static void log_event_progress(const struct event_type *et,
 		return;
 	}
 
+	const struct event_listener *el = _event_listener_get(es);
+
+	__ASSERT_NO_MSG(el != NULL);
+
 	LOG_INF("|\tnotifying %s", el->name);
 }
 
@@ -137,70 +163,246 @@ void __weak app_event_manager_free(void *addr)
 	k_free(addr);
 }
 
-static void event_processor_fn(struct k_work *work)
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+static bool pool_owns_block(const struct app_event_pool *pool, const void *addr)
 {
-	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+	const char *block = addr;
 
-	/* Make current event list local. */
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	return (block >= pool->buffer) &&
+	       (block < (pool->buffer + (pool->block_cnt * pool->block_size)));
+}
+
+static void pool_update_max_used(struct app_event_pool *pool)
+{
+	atomic_val_t used = k_mem_slab_num_used_get(&pool->slab);
+	atomic_val_t max_used;
+
+	do {
+		max_used = atomic_get(&pool->max_used);
+		if (used <= max_used) {
+			break;
+		}
+	} while (!atomic_cas(&pool->max_used, max_used, used));
+}
+
+/* Events may be allocated before app_event_manager_init is called, so the
+ * pools are set up at boot.
+ */
+static int event_pools_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct app_event_pool *pool = et->pool;
+
+		if (pool) {
+			int err = k_mem_slab_init(&pool->slab, pool->buffer, pool->block_size,
+						  pool->block_cnt);
 
-	if (sys_slist_is_empty(&eventq)) {
-		k_spin_unlock(&lock, key);
+			__ASSERT_NO_MSG(!err);
+			ARG_UNUSED(err);
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(event_pools_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_APP_EVENT_MANAGER_EVENT_POOLS */
+
+const struct event_listener *_event_listener_get(const struct event_subscriber *es)
+{
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		if (el->notification == es->notification) {
+			return el;
+		}
+	}
+
+	return NULL;
+}
+
+void *_event_alloc(const struct event_type *et, size_t size)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+	APP_EVENT_ASSERT_ID(et);
+
+	struct app_event_pool *pool = et->pool;
+
+	if (pool) {
+		void *event;
+
+		__ASSERT_NO_MSG(size <= pool->block_size);
+
+		if (!k_mem_slab_alloc(&pool->slab, &event, K_NO_WAIT)) {
+			pool_update_max_used(pool);
+			return event;
+		}
+
+		atomic_inc(&pool->heap_fallback_cnt);
+	}
+#endif
+
+	return app_event_manager_alloc(size);
+}
+
+void _event_free(struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	struct app_event_pool *pool = aeh->type_id->pool;
+
+	if (pool && pool_owns_block(pool, aeh)) {
+		void *block = aeh;
+
+		k_mem_slab_free(&pool->slab, &block);
 		return;
 	}
+#endif
 
-	sys_slist_merge_slist(&events, &eventq);
+	app_event_manager_free(aeh);
+}
 
-	k_spin_unlock(&lock, key);
+int app_event_manager_pool_stats_get(const struct event_type *et,
+				     struct app_event_manager_pool_stats *stats)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+	APP_EVENT_ASSERT_ID(et);
+	__ASSERT_NO_MSG(stats);
 
-	/* Traverse the list of events. */
-	sys_snode_t *node;
-	while (NULL != (node = sys_slist_get(&events))) {
-		struct app_event_header *aeh = CONTAINER_OF(node,
-						       struct app_event_header,
-						       node);
+	struct app_event_pool *pool = et->pool;
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+	if (!pool) {
+		return -ENOENT;
+	}
 
-		const struct event_type *et = aeh->type_id;
+	stats->block_cnt = pool->block_cnt;
+	stats->used_cnt = k_mem_slab_num_used_get(&pool->slab);
+	stats->max_used_cnt = atomic_get(&pool->max_used);
+	stats->heap_fallback_cnt = atomic_get(&pool->heap_fallback_cnt);
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static enum app_event_manager_lane event_lane_get(const struct event_type *et)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_LANES)) {
+		return APP_EVENT_MANAGER_LANE_NORMAL;
+	}
+
+	if (app_event_get_type_flag(et, APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY)) {
+		return APP_EVENT_MANAGER_LANE_HIGH;
+	}
+
+	if (app_event_get_type_flag(et, APP_EVENT_TYPE_FLAGS_LOW_PRIORITY)) {
+		return APP_EVENT_MANAGER_LANE_LOW;
+	}
+
+	return APP_EVENT_MANAGER_LANE_NORMAL;
+}
+
+static void lane_stats_on_submit(struct event_lane *lane, struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	aeh->submit_time = k_cycle_get_32();
+
+	lane->depth++;
+	if (lane->depth > lane->max_depth) {
+		lane->max_depth = lane->depth;
+	}
+#endif
+}
+
+static void lane_stats_on_get(struct event_lane *lane, const struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	uint32_t latency = k_cycle_get_32() - aeh->submit_time;
+
+	__ASSERT_NO_MSG(lane->depth > 0);
+	lane->depth--;
+	lane->processed_cnt++;
+	lane->latency_sum += latency;
+	if (latency > lane->latency_max) {
+		lane->latency_max = latency;
+	}
+#endif
+}
+
+/* Take the oldest event from the highest priority lane that is not empty. */
+static struct app_event_header *event_get(void)
+{
+	struct app_event_header *aeh = NULL;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(lanes); i++) {
+		sys_snode_t *node = sys_slist_get(&lanes[i].queue);
+
+		if (node) {
+			aeh = CONTAINER_OF(node, struct app_event_header, node);
+			lane_stats_on_get(&lanes[i], aeh);
+			break;
 		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return aeh;
+}
+
+static void event_process(struct app_event_header *aeh)
+{
+	APP_EVENT_ASSERT_ID(aeh->type_id);
 
-		log_event(aeh);
+	const struct event_type *et = aeh->type_id;
 
-		bool consumed = false;
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
 
-		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
-		     es++) {
+	log_event(aeh);
 
-			__ASSERT_NO_MSG(es != NULL);
+	bool consumed = false;
 
-			const struct event_listener *el = es->listener;
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+		__ASSERT_NO_MSG(es != NULL);
+		__ASSERT_NO_MSG(es->notification != NULL);
 
-			log_event_progress(et, el);
+		log_event_progress(et, es);
 
-			consumed = el->notification(aeh);
+		consumed = es->notification(aeh);
 
-			if (consumed) {
-				log_event_consumed(et);
-			}
+		if (consumed) {
+			log_event_consumed(et);
 		}
+	}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
-			}
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
 		}
+	}
+
+	_event_free(aeh);
+}
 
-		app_event_manager_free(aeh);
+static void event_processor_fn(struct k_work *work)
+{
+	struct app_event_header *aeh;
+
+	/* Events are taken one by one, so that an event submitted to a higher
+	 * priority lane is processed before the remaining events of lower
+	 * priority lanes. Events within a lane are processed in order.
+	 */
+	while (NULL != (aeh = event_get())) {
+		event_process(aeh);
 	}
 }
 
@@ -209,6 +411,7 @@ void _event_submit(struct app_event_header *aeh)
 	__ASSERT_NO_MSG(aeh);
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
+	struct event_lane *lane = &lanes[event_lane_get(aeh->type_id)];
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
@@ -216,10 +419,39 @@ void _event_submit(struct app_event_header *aeh)
 			h->hook(aeh);
 		}
 	}
-	sys_slist_append(&eventq, &aeh->node);
+	lane_stats_on_submit(lane, aeh);
+	sys_slist_append(&lane->queue, &aeh->node);
 	k_spin_unlock(&lock, key);
 
-	k_work_submit(&event_processor);
+	k_work_submit_to_queue(EVENT_PROCESSOR_WQ, &event_processor);
+}
+
+int app_event_manager_lane_stats_get(enum app_event_manager_lane lane,
+				     struct app_event_manager_lane_stats *stats)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	if (lane >= APP_EVENT_MANAGER_LANE_COUNT) {
+		return -EINVAL;
+	}
+
+	__ASSERT_NO_MSG(stats);
+
+	const struct event_lane *l = &lanes[lane];
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats->depth = l->depth;
+	stats->max_depth = l->max_depth;
+	stats->processed_cnt = l->processed_cnt;
+	stats->latency_avg_us = (l->processed_cnt > 0) ?
+		k_cyc_to_us_floor32(l->latency_sum / l->processed_cnt) : 0;
+	stats->latency_max_us = k_cyc_to_us_floor32(l->latency_max);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
 }
 
 int app_event_manager_init(void)
@@ -231,6 +463,16 @@ int app_event_manager_init(void)
 
 	log_event_init();
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DEDICATED_WORKQUEUE)
+	k_work_queue_start(&event_processor_wq, event_processor_stack,
+			   K_THREAD_STACK_SIZEOF(event_processor_stack),
+			   CONFIG_APP_EVENT_MANAGER_WORKQUEUE_PRIORITY, NULL);
+	k_thread_name_set(&event_processor_wq.thread, "app_event_manager");
+
+	/* Process events submitted before the work queue was started. */
+	k_work_submit_to_queue(&event_processor_wq, &event_processor);
+#endif
+
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
 			ret = h->hook();
@@ -108,12 +108,20 @@ extern "C" {
 	 )
 
 
-/* Subscribe a listener to an event. */
+/* Name of the notification function stored in the subscribers of a listener. */
+#define _APP_EVENT_LISTENER_FN_NAME(lname) _CONCAT(__event_listener_fn_, lname)
+
+
+/* Subscribe a listener to an event.
+ * Only the notification function is stored in the subscriber. As the linker
+ * sorts subscriber sections by name, every event type gets a contiguous array
+ * of handlers ordered by subscription priority.
+ */
 #define _APP_EVENT_SUBSCRIBE(lname, ename, prio)					\
 	const struct event_subscriber _CONCAT(_CONCAT(__event_subscriber_, ename), lname)\
 	__used __aligned(__alignof(struct event_subscriber))				\
 	__attribute__((__section__(_APP_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio)))) = {\
-		.listener = &_CONCAT(__event_listener_, lname),				\
+		.notification = _APP_EVENT_LISTENER_FN_NAME(lname),			\
 	}
 
 
@@ -121,6 +129,16 @@ extern "C" {
 #define _EVENT_ID(ename) (&_CONCAT(__event_type_, ename))
 
 
+/* Event allocation. When event pools are enabled, events without dynamic data
+ * are taken from the memory slab defined for the given event type.
+ */
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+#define _APP_EVENT_ALLOC(ename, size) _event_alloc(_EVENT_ID(ename), (size))
+#else
+#define _APP_EVENT_ALLOC(ename, size) app_event_manager_alloc(size)
+#endif
+
+
 /* Macro generates a function of name new_ename where ename is provided as
  * an argument. Allocator function is used to create an event of the given
  * ename type.
@@ -129,7 +147,7 @@ extern "C" {
 	static inline struct ename *_CONCAT(new_, ename)(void)			\
 	{									\
 		struct ename *event =						\
-			(struct ename *)app_event_manager_alloc(sizeof(*event));\
+			(struct ename *)_APP_EVENT_ALLOC(ename, sizeof(*event));\
 		BUILD_ASSERT(offsetof(struct ename, header) == 0,		\
 				 "");						\
 		if (event != NULL) {						\
@@ -190,10 +208,18 @@ extern "C" {
 
 
 /* Declarations and definitions - for more details refer to public API. */
+/* The notification function is wrapped in a function defined for the listener.
+ * Its address is a constant expression that the subscribers can store, whatever
+ * the notification function is (for example, a C++ function).
+ */
 #define _APP_EVENT_LISTENER(lname, notification_fn)					\
+	static bool _APP_EVENT_LISTENER_FN_NAME(lname)(const struct app_event_header *aeh)\
+	{										\
+		return (notification_fn)(aeh);						\
+	}										\
 	STRUCT_SECTION_ITERABLE(event_listener, _CONCAT(__event_listener_, lname)) = {	\
 		.name = STRINGIFY(lname),						\
-		.notification = (notification_fn),					\
+		.notification = _APP_EVENT_LISTENER_FN_NAME(lname),			\
 	}
 
 
@@ -221,6 +247,39 @@ extern "C" {
 #define _APP_EVENT_TYPE_DEFINE_SIZES(ename)
 #endif
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+/* Name of the buffer holding the pool blocks of the given event type. */
+#define _APP_EVENT_POOL_BUF_NAME(ename) _CONCAT(__event_pool_buf_, ename)
+
+/* Name of the pool object for the given event type. */
+#define _APP_EVENT_POOL_NAME(ename) _CONCAT(__event_pool_, ename)
+
+/* Size of a pool block for the given event type. */
+#define _APP_EVENT_POOL_BLOCK_SIZE(ename) ROUND_UP(sizeof(struct ename), sizeof(void *))
+
+/* Events with dynamic data have variable size and are always allocated
+ * using app_event_manager_alloc. Their pool is not referenced, so neither
+ * the pool nor its buffer end up in the image. The memory slab of the pool
+ * is initialized at boot only for the event types using it.
+ */
+#define _APP_EVENT_POOL_DEFINE(ename)							\
+	static char __aligned(sizeof(void *)) _APP_EVENT_POOL_BUF_NAME(ename)[		\
+		(_CONCAT(ename, _HAS_DYNDATA)) ? 0 :					\
+		(CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE *				\
+		 _APP_EVENT_POOL_BLOCK_SIZE(ename))];					\
+	static struct app_event_pool _APP_EVENT_POOL_NAME(ename) = {			\
+		.buffer = _APP_EVENT_POOL_BUF_NAME(ename),				\
+		.block_size = _APP_EVENT_POOL_BLOCK_SIZE(ename),			\
+		.block_cnt = CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE,			\
+	};
+
+#define _APP_EVENT_TYPE_DEFINE_POOL(ename)						\
+	.pool = ((_CONCAT(ename, _HAS_DYNDATA)) ? NULL : &_APP_EVENT_POOL_NAME(ename)),
+#else
+#define _APP_EVENT_POOL_DEFINE(ename)
+#define _APP_EVENT_TYPE_DEFINE_POOL(ename)
+#endif
+
 /** @brief Event header.
  *
  * When defining an event structure, the application event header
@@ -232,6 +291,35 @@ struct app_event_header {
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	/** Cycle count captured when the event was submitted. */
+	uint32_t submit_time;
+#endif
+};
+
+/** @brief Event pool.
+ *
+ * Fixed-size memory pool used to allocate events of a given type.
+ */
+struct app_event_pool {
+	/** Memory slab providing the event blocks. */
+	struct k_mem_slab slab;
+
+	/** Buffer holding the event blocks. */
+	char *buffer;
+
+	/** Size of an event block. */
+	size_t block_size;
+
+	/** Number of event blocks. */
+	uint32_t block_cnt;
+
+	/** Maximum number of blocks used at the same time. */
+	atomic_t max_used;
+
+	/** Number of allocations that fell back to the heap. */
+	atomic_t heap_fallback_cnt;
 };
 
 /** Function to log data from this event. */
@@ -294,6 +382,11 @@ struct event_type {
 	/** The size of the event structure */
 	uint16_t struct_size;
 #endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+	/** Pool used to allocate events of this type (NULL if not used). */
+	struct app_event_pool *pool;
+#endif
 };
 
 
@@ -305,7 +398,13 @@ extern struct event_type _event_type_list_end[];
 	BUILD_ASSERT(((et_flags) & ((BIT_MASK(APP_EVENT_TYPE_FLAGS_USER_SETTABLE_START-	\
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START))<<					\
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START)) == 0);				\
+	BUILD_ASSERT(((et_flags) & (BIT(APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY) |		\
+		BIT(APP_EVENT_TYPE_FLAGS_LOW_PRIORITY))) !=				\
+		(BIT(APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY) |				\
+		BIT(APP_EVENT_TYPE_FLAGS_LOW_PRIORITY)),				\
+		"Event type cannot have both high and low priority");			\
 	_APP_EVENT_SUBSCRIBERS_ARRAY_TAGS(ename);					\
+	_APP_EVENT_POOL_DEFINE(ename)							\
 	STRUCT_SECTION_ITERABLE(event_type, _CONCAT(__event_type_, ename)) = {		\
 		.name            = STRINGIFY(ename),					\
 		.subs_start      = _APP_EVENT_SUBSCRIBERS_START_TAG(ename),		\
@@ -317,6 +416,7 @@ extern struct event_type _event_type_list_end[];
 				((et_flags) | BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)) :	\
 				((et_flags) & (~BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)))),\
 		_APP_EVENT_TYPE_DEFINE_SIZES(ename) /* No comma here intentionally */	\
+		_APP_EVENT_TYPE_DEFINE_POOL(ename) /* No comma here intentionally */	\
 	}
 
 /**
@@ -395,8 +495,10 @@ struct event_listener {
 /** @brief Event subscriber.
  */
 struct event_subscriber {
-	/** Pointer to the listener. */
-	const struct event_listener *listener;
+	/** Pointer to the listener notification function.
+	 * The same function is set in the listener, see @ref _event_listener_get.
+	 */
+	bool (*notification)(const struct app_event_header *aeh);
 };
 
 
@@ -435,6 +537,33 @@ struct event_postprocess_hook {
  */
 void _event_submit(struct app_event_header *aeh);
 
+/** @brief Allocate an event of the given type.
+ *
+ * The event is taken from the event type pool. If the pool is exhausted,
+ * app_event_manager_alloc is used instead.
+ *
+ * @param et    Pointer to the event type.
+ * @param size  Size of the event (in bytes).
+ */
+void *_event_alloc(const struct event_type *et, size_t size);
+
+/** @brief Free an event.
+ *
+ * @param aeh  Pointer to the application event header element in the event object.
+ */
+void _event_free(struct app_event_header *aeh);
+
+/** @brief Get the listener of a subscriber.
+ *
+ * The listener is looked up by its notification function, so the function
+ * is meant for diagnostics only.
+ *
+ * @param es  Pointer to the event subscriber.
+ *
+ * @return Pointer to the listener or NULL if it was not found.
+ */
+const struct event_listener *_event_listener_get(const struct event_subscriber *es);
+
 #ifdef __cplusplus
 }
 #endif
@@ -59,7 +59,7 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 			es++) {
 
 			__ASSERT_NO_MSG(es != NULL);
-			const struct event_listener *el = es->listener;
+			const struct event_listener *el = _event_listener_get(es);
 
 			__ASSERT_NO_MSG(el != NULL);
 			shell_fprintf(shell, SHELL_NORMAL,
@@ -81,6 +81,78 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int show_pools(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)) {
+		shell_error(shell, "Event pools are disabled");
+		return -ENOTSUP;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event pools (used/max/size, heap fallbacks):\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct app_event_manager_pool_stats stats;
+
+		if (app_event_manager_pool_stats_get(et, &stats)) {
+			shell_fprintf(shell, SHELL_NORMAL,
+				      "|\t[E:%s] no pool\n", et->name);
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] %u/%u/%u, %u\n",
+			      et->name,
+			      stats.used_cnt,
+			      stats.max_used_cnt,
+			      stats.block_cnt,
+			      stats.heap_fallback_cnt);
+	}
+
+	return 0;
+}
+
+static int show_lanes(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	static const char * const lane_names[] = {
+		[APP_EVENT_MANAGER_LANE_HIGH] = "high",
+		[APP_EVENT_MANAGER_LANE_NORMAL] = "normal",
+		[APP_EVENT_MANAGER_LANE_LOW] = "low",
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(lane_names) == APP_EVENT_MANAGER_LANE_COUNT);
+
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)) {
+		shell_error(shell, "Queue statistics are disabled");
+		return -ENOTSUP;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "Event lanes (depth/max depth, processed, avg/max latency [us]):\n");
+
+	for (size_t i = 0; i < APP_EVENT_MANAGER_LANE_COUNT; i++) {
+		struct app_event_manager_lane_stats stats;
+		int err = app_event_manager_lane_stats_get(i, &stats);
+
+		if (err) {
+			shell_error(shell, "Cannot get lane statistics (err %d)", err);
+			return err;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[%s] %u/%u, %u, %u/%u\n",
+			      lane_names[i],
+			      stats.depth,
+			      stats.max_depth,
+			      stats.processed_cnt,
+			      stats.latency_avg_us,
+			      stats.latency_max_us);
+	}
+
+	return 0;
+}
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -155,6 +227,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+	SHELL_CMD_ARG(show_pools, NULL, "Show event pools usage", show_pools, 0, 0),
+	SHELL_CMD_ARG(show_lanes, NULL, "Show event lanes statistics", show_lanes, 0, 0),
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
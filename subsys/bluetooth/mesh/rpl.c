@@ -22,11 +22,104 @@ static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 
 EMDS_STATIC_ENTRY_DEFINE(rpl_store, CONFIG_BT_MESH_RPL_INDEX, replay_list, sizeof(replay_list));
 
+/* Open addressing index of the replay list, keyed by the source address.
+ * Each slot holds the replay list index of the entry plus one, so that zero
+ * marks an empty slot. The table is twice the size of the replay list, so
+ * there is always an empty slot to end the probing.
+ *
+ * The used entries of the replay list are kept at its start. The index is
+ * not stored, it is built from the replay list on first use, after the list
+ * is restored from the emergency data storage.
+ */
+#define RPL_HASH_SIZE (2 * CONFIG_BT_MESH_CRPL)
+
+static uint16_t rpl_hash[RPL_HASH_SIZE];
+static uint16_t rpl_cnt;
+static bool rpl_hash_valid;
+
+BUILD_ASSERT(CONFIG_BT_MESH_CRPL < UINT16_MAX, "RPL index does not fit the hash table");
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static inline uint16_t rpl_hash_next(uint16_t slot)
+{
+	return (slot + 1) < RPL_HASH_SIZE ? (slot + 1) : 0;
+}
+
+static void rpl_hash_insert(uint16_t src, int idx)
+{
+	uint16_t slot = src % RPL_HASH_SIZE;
+
+	while (rpl_hash[slot]) {
+		slot = rpl_hash_next(slot);
+	}
+
+	rpl_hash[slot] = idx + 1;
+}
+
+static struct bt_mesh_rpl *rpl_find(uint16_t src)
+{
+	for (uint16_t slot = src % RPL_HASH_SIZE; rpl_hash[slot]; slot = rpl_hash_next(slot)) {
+		struct bt_mesh_rpl *rpl = &replay_list[rpl_hash[slot] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+	}
+
+	return NULL;
+}
+
+/* Move the used entries to the start of the replay list, keeping their
+ * order, and index them.
+ */
+static void rpl_hash_rebuild(void)
+{
+	rpl_cnt = 0;
+	(void)memset(rpl_hash, 0, sizeof(rpl_hash));
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			continue;
+		}
+
+		if (i != rpl_cnt) {
+			replay_list[rpl_cnt] = replay_list[i];
+			(void)memset(&replay_list[i], 0, sizeof(replay_list[i]));
+		}
+
+		rpl_hash_insert(replay_list[rpl_cnt].src, rpl_cnt);
+		rpl_cnt++;
+	}
+
+	rpl_hash_valid = true;
+
+	BT_DBG("RPL index built, %u entries", rpl_cnt);
+}
+
+/* Index a slot that is about to get a new source address. */
+static void rpl_hash_add(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+	if (!rpl_hash_valid) {
+		return;
+	}
+
+	/* The slot was not the first free entry when it was written, for
+	 * example when two segmented messages from new sources were received
+	 * at the same time. Build the index again on the next check.
+	 */
+	if (rpl->src || rpl_idx(rpl) != rpl_cnt) {
+		rpl_hash_valid = false;
+		return;
+	}
+
+	rpl_hash_insert(src, rpl_cnt);
+	rpl_cnt++;
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
@@ -37,6 +130,10 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
+	if (rpl->src != rx->ctx.addr) {
+		rpl_hash_add(rpl, rx->ctx.addr);
+	}
+
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
@@ -50,7 +147,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -62,55 +159,55 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	if (!rpl_hash_valid) {
+		rpl_hash_rebuild();
+	}
 
-		/* Empty slot */
-		if (!rpl->src) {
-			if (match) {
-				*match = rpl;
-			} else {
-				bt_mesh_rpl_update(rpl, rx);
-			}
+	rpl = rpl_find(rx->ctx.addr);
+	if (!rpl) {
+		if (rpl_cnt >= ARRAY_SIZE(replay_list)) {
+			BT_ERR("RPL is full!");
+			return true;
+		}
 
-			return false;
+		/* First empty slot */
+		rpl = &replay_list[rpl_cnt];
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return false;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* Existing slot for given address */
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
+	if ((!rx->old_iv && rpl->old_iv) ||
+	    rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
 void bt_mesh_rpl_clear(void)
 {
 	(void)memset(replay_list, 0, sizeof(replay_list));
+	rpl_hash_valid = false;
 }
 
 void bt_mesh_rpl_reset(void)
 {
-	int shift = 0;
-	int last = 0;
-
 	/* Discard "old" IV Index entries from RPL and flag
 	 * any other ones (which are valid) as old.
 	 */
@@ -120,21 +217,14 @@ void bt_mesh_rpl_reset(void)
 		if (rpl->src) {
 			if (rpl->old_iv) {
 				(void)memset(rpl, 0, sizeof(*rpl));
-
-				shift++;
 			} else {
 				rpl->old_iv = true;
-
-				if (shift > 0) {
-					replay_list[i - shift] = *rpl;
-				}
 			}
-
-			last = i;
 		}
 	}
 
-	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+	/* Close the gaps of the discarded entries */
+	rpl_hash_rebuild();
 }
 
 void bt_mesh_rpl_pending_store(uint16_t addr)
@@ -12,6 +12,7 @@
 #include "bluetooth/bluetooth.h"
 #include "bluetooth/att.h"
 #include "bluetooth/gatt.h"
+#include "bt_rpc.h"
 
 #include "bt_rpc_common.h"
 #include "bt_rpc_gatt_common.h"
@@ -799,6 +800,76 @@ int bt_gatt_notify_multiple(struct bt_conn *conn, uint16_t num_params,
 }
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
+#if defined(CONFIG_BT_RPC_GATT_NOTIFY_BATCH)
+static void bt_rpc_gatt_notify_batch_cb_t_callback_rpc_handler(const struct nrf_rpc_group *group,
+							      struct nrf_rpc_cbor_ctx *ctx,
+							      void *handler_data)
+{
+	struct bt_conn *conn;
+	uint16_t sent;
+	int err;
+	void *user_data;
+	bt_rpc_gatt_notify_batch_cb_t callback_slot;
+
+	conn = bt_rpc_decode_bt_conn(ctx);
+	sent = ser_decode_uint(ctx);
+	err = ser_decode_int(ctx);
+	user_data = (void *)ser_decode_uint(ctx);
+	callback_slot = (bt_rpc_gatt_notify_batch_cb_t)ser_decode_callback_call(ctx);
+
+	if (!ser_decoding_done_and_check(group, ctx)) {
+		goto decoding_error;
+	}
+
+	callback_slot(conn, sent, err, user_data);
+
+	return;
+decoding_error:
+	report_decoding_error(BT_RPC_GATT_NOTIFY_BATCH_CB_T_CALLBACK_RPC_EVT, handler_data);
+}
+
+NRF_RPC_CBOR_EVT_DECODER(bt_rpc_grp, bt_rpc_gatt_notify_batch_cb_t_callback,
+			 BT_RPC_GATT_NOTIFY_BATCH_CB_T_CALLBACK_RPC_EVT,
+			 bt_rpc_gatt_notify_batch_cb_t_callback_rpc_handler, NULL);
+
+int bt_rpc_gatt_notify_batch(struct bt_conn *conn, const struct bt_gatt_notify_params *params,
+			     uint16_t num_params, bt_rpc_gatt_notify_batch_cb_t cb,
+			     void *user_data)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t scratchpad_size = 0;
+	size_t buffer_size_max = 21;
+
+	if (!params || !num_params) {
+		return -EINVAL;
+	}
+
+	/* The host decodes the notifications one by one,
+	 * so the scratchpad only has to fit the largest one.
+	 */
+	for (size_t i = 0; i < num_params; i++) {
+		buffer_size_max += bt_gatt_notify_params_buf_size(&params[i]);
+		scratchpad_size = MAX(scratchpad_size, bt_gatt_notify_params_sp_size(&params[i]));
+	}
+
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
+	ser_encode_uint(&ctx, scratchpad_size);
+
+	bt_rpc_encode_bt_conn(&ctx, conn);
+	ser_encode_callback(&ctx, cb);
+	ser_encode_uint(&ctx, (uintptr_t)user_data);
+	ser_encode_uint(&ctx, num_params);
+
+	for (size_t i = 0; i < num_params; i++) {
+		bt_gatt_notify_params_enc(&ctx, &params[i]);
+	}
+
+	nrf_rpc_cbor_evt_no_err(&bt_rpc_grp, BT_RPC_GATT_NOTIFY_BATCH_RPC_EVT, &ctx);
+
+	return 0;
+}
+#endif /* CONFIG_BT_RPC_GATT_NOTIFY_BATCH */
+
 size_t bt_gatt_indicate_params_sp_size(const struct bt_gatt_indicate_params *data)
 {
 	size_t scratchpad_size = 0;
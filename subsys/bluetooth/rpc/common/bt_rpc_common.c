@@ -228,7 +228,7 @@ static const CHECK_LIST_ENTRY_TYPE check_table[] = {
 		CONFIG_BT_GATT_CLIENT,
 		CONFIG_BT_RPC_INTERNAL_FUNCTIONS,
 		CONFIG_BT_DEVICE_APPEARANCE_DYNAMIC,
-		0,
+		CONFIG_BT_RPC_GATT_NOTIFY_BATCH,
 		0,
 		0,
 		0),
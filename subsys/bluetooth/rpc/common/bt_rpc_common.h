@@ -206,6 +206,16 @@ enum bt_rpc_cmd_from_host_to_cli {
 enum bt_rpc_evt_from_host_to_cli {
 	/* bluetooth.h API */
 	BT_READY_CB_T_CALLBACK_RPC_EVT,
+	/* gatt.h API */
+	BT_RPC_GATT_NOTIFY_BATCH_CB_T_CALLBACK_RPC_EVT,
+};
+
+/** @brief Client events IDs used in bluetooth API serialization.
+ *         Those events are sent from the client to the host.
+ */
+enum bt_rpc_evt_from_cli_to_host {
+	/* gatt.h API */
+	BT_RPC_GATT_NOTIFY_BATCH_RPC_EVT,
 };
 
 /** @brief Pairing flags IDs. Those flags are used to setup valid callback sets on
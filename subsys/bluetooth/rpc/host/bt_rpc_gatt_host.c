@@ -12,6 +12,7 @@
 #include <zephyr/bluetooth/conn.h>
 
 #include <nrf_rpc_cbor.h>
+#include <bt_rpc.h>
 
 #include "bt_rpc_gatt_common.h"
 #include "bt_rpc_common.h"
@@ -828,6 +829,85 @@ decoding_error:
 NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_gatt_notify_cb, BT_GATT_NOTIFY_CB_RPC_CMD,
 	bt_gatt_notify_cb_rpc_handler, NULL);
 
+#if defined(CONFIG_BT_RPC_GATT_NOTIFY_BATCH)
+static inline void bt_rpc_gatt_notify_batch_cb_t_callback(struct bt_conn *conn, uint16_t sent,
+							  int err, void *user_data,
+							  uint32_t callback_slot)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t buffer_size_max = 21;
+
+	NRF_RPC_CBOR_ALLOC(&bt_rpc_grp, ctx, buffer_size_max);
+
+	bt_rpc_encode_bt_conn(&ctx, conn);
+	ser_encode_uint(&ctx, sent);
+	ser_encode_int(&ctx, err);
+	ser_encode_uint(&ctx, (uintptr_t)user_data);
+	ser_encode_callback_call(&ctx, callback_slot);
+
+	nrf_rpc_cbor_evt_no_err(&bt_rpc_grp, BT_RPC_GATT_NOTIFY_BATCH_CB_T_CALLBACK_RPC_EVT, &ctx);
+}
+
+CBKPROXY_HANDLER(bt_rpc_gatt_notify_batch_cb_t_encoder, bt_rpc_gatt_notify_batch_cb_t_callback,
+		 (struct bt_conn *conn, uint16_t sent, int err, void *user_data),
+		 (conn, sent, err, user_data));
+
+static void bt_rpc_gatt_notify_batch_rpc_handler(const struct nrf_rpc_group *group,
+						 struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct bt_conn *conn;
+	struct bt_gatt_notify_params params;
+	struct ser_scratchpad scratchpad;
+	bt_rpc_gatt_notify_batch_cb_t cb;
+	void *user_data;
+	uint32_t num_params;
+	uint16_t sent = 0;
+	int err = 0;
+
+	SER_SCRATCHPAD_DECLARE(&scratchpad, ctx);
+
+	conn = bt_rpc_decode_bt_conn(ctx);
+	cb = (bt_rpc_gatt_notify_batch_cb_t)ser_decode_callback(ctx,
+							    bt_rpc_gatt_notify_batch_cb_t_encoder);
+	user_data = (void *)ser_decode_uint(ctx);
+	num_params = ser_decode_uint(ctx);
+
+	/* Notifications are passed to the stack as they are decoded,
+	 * so the scratchpad is reused for each of them.
+	 */
+	for (uint32_t i = 0; i < num_params; i++) {
+		net_buf_simple_reset(&scratchpad.buf);
+		bt_gatt_notify_params_dec(&scratchpad, &params);
+
+		if (!ser_decode_valid(ctx)) {
+			break;
+		}
+
+		if (!err) {
+			err = bt_gatt_notify_cb(conn, &params);
+			if (!err) {
+				sent++;
+			}
+		}
+	}
+
+	if (!ser_decoding_done_and_check(group, ctx)) {
+		goto decoding_error;
+	}
+
+	if (cb) {
+		cb(conn, sent, err, user_data);
+	}
+
+	return;
+decoding_error:
+	report_decoding_error(BT_RPC_GATT_NOTIFY_BATCH_RPC_EVT, handler_data);
+}
+
+NRF_RPC_CBOR_EVT_DECODER(bt_rpc_grp, bt_rpc_gatt_notify_batch, BT_RPC_GATT_NOTIFY_BATCH_RPC_EVT,
+			 bt_rpc_gatt_notify_batch_rpc_handler, NULL);
+#endif /* CONFIG_BT_RPC_GATT_NOTIFY_BATCH */
+
 void bt_gatt_indicate_params_dec(struct ser_scratchpad *scratchpad,
 				 struct bt_gatt_indicate_params *data)
 {
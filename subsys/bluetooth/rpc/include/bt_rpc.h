@@ -58,6 +58,47 @@ int bt_rpc_gatt_subscribe_flag_clear(struct bt_gatt_subscribe_params *params, ui
  */
 int bt_rpc_gatt_subscribe_flag_get(struct bt_gatt_subscribe_params *params, uint32_t flags_bit);
 
+/** @brief Callback reporting the result of @ref bt_rpc_gatt_notify_batch.
+ *
+ * @param conn      Connection object.
+ * @param sent      Number of notifications from the batch passed to the Bluetooth stack.
+ * @param err       0 if all notifications were passed to the Bluetooth stack,
+ *                  otherwise the error of the first notification that failed.
+ * @param user_data User data passed to @ref bt_rpc_gatt_notify_batch.
+ */
+typedef void (*bt_rpc_gatt_notify_batch_cb_t)(struct bt_conn *conn, uint16_t sent, int err,
+					      void *user_data);
+
+/** @brief Send a batch of GATT notifications.
+ *
+ * All notifications are sent to the host in a single nRF RPC event and the
+ * function returns without waiting for the host. The host passes the
+ * notifications to the Bluetooth stack in order and stops at the first error.
+ * The result is then reported with the @p cb callback.
+ *
+ * The @a func callback of each notification is called as for the
+ * @ref bt_gatt_notify_cb function. The encoded batch must fit in a single
+ * nRF RPC transport buffer.
+ *
+ * Batches are handled by the host thread pool, so notifications of different
+ * batches may be passed to the Bluetooth stack out of order. Wait for the
+ * @p cb callback before sending the next batch if the order matters.
+ *
+ * Requires the @kconfig{CONFIG_BT_RPC_GATT_NOTIFY_BATCH} option.
+ *
+ * @param conn       Connection object.
+ * @param params     Array of notification parameters.
+ * @param num_params Number of notifications in the array.
+ * @param cb         Callback called when the batch is handled by the host, can be NULL.
+ * @param user_data  User data passed to the @p cb callback.
+ *
+ * @retval 0 If the batch was sent to the host.
+ * @retval -EINVAL Invalid parameters.
+ */
+int bt_rpc_gatt_notify_batch(struct bt_conn *conn, const struct bt_gatt_notify_params *params,
+			     uint16_t num_params, bt_rpc_gatt_notify_batch_cb_t cb,
+			     void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 #include <caf/events/sensor_event.h>
 #include <caf/events/sensor_data_aggregator_event.h>
 #include <caf/sensor_manager.h>
+#include <caf/sensor_data_aggregator.h>
 
 #define MODULE sensor_data_aggregator
 #include <caf/events/module_state_event.h>
@@ -20,38 +21,25 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_SENSOR_DATA_AGGREGATOR_LOG_LEVEL);
 
 #define DT_DRV_COMPAT caf_aggregator
 
-#define __DEFINE_DATA(i, agg_id, size)							\
-	static uint8_t agg_ ## agg_id ## _buff_ ## i ## _data[size] __aligned(4)
-
 #if (DT_INST_NODE_HAS_PROP(agg_id, memory_region))
 
-#define __INITIALIZE_BUF(i, agg_id)							\
-	{										\
-		(uint8_t *) DT_REG_ADDR(DT_INST_PHANDLE(agg_id, memory_region)) +	\
-		i * DT_INST_PROP(agg_id, buf_data_length)				\
-	},
-
-
+#define __BUF_DATA(i) ((uint8_t *) DT_REG_ADDR(DT_INST_PHANDLE(i, memory_region)))
 
 /* buf_len has to be equal to n*sensor_data_size. */
 #define __DEFINE_BUF_DATA(i)									\
-	static struct aggregator_buffer agg_ ## i ## _bufs[] = {				\
-		UTIL_LISTIFY(DT_INST_PROP(i, buf_count), __INITIALIZE_BUF, i)			\
-	};											\
+	static struct aggregator_buffer agg_ ## i ## _bufs[DT_INST_PROP(i, buf_count)];	\
 	BUILD_ASSERT((DT_INST_PROP(i, buf_data_length) % DT_INST_PROP(i, sensor_data_size)) == 0,\
 		"Wrong sensor data or buffer size");
 
 #else
-#define __INITIALIZE_BUF(i, agg_id)							\
-	{(uint8_t *) &agg_ ## agg_id ## _buff_ ## i ## _data}
+
+#define __BUF_DATA(i) ((uint8_t *) agg_ ## i ## _data)
 
 /* buf_len has to be equal to n*sensor_data_size. */
 #define __DEFINE_BUF_DATA(i)									\
-	LISTIFY(DT_INST_PROP(i, buf_count), __DEFINE_DATA, (;), i,				\
-		DT_INST_PROP(i, buf_data_length));						\
-	static struct aggregator_buffer agg_ ## i ## _bufs[] = {				\
-		LISTIFY(DT_INST_PROP(i, buf_count), __INITIALIZE_BUF, (,), i)			\
-	};											\
+	static uint8_t agg_ ## i ## _data[DT_INST_PROP(i, buf_count)]				\
+					 [DT_INST_PROP(i, buf_data_length)] __aligned(4);	\
+	static struct aggregator_buffer agg_ ## i ## _bufs[DT_INST_PROP(i, buf_count)];	\
 	BUILD_ASSERT((DT_INST_PROP(i, buf_data_length) % DT_INST_PROP(i, sensor_data_size)) == 0,\
 		"Wrong sensor data or buffer size");
 
@@ -62,22 +50,18 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_SENSOR_DATA_AGGREGATOR_LOG_LEVEL);
 	[i].sensor_data_size = DT_INST_PROP(i, sensor_data_size),			\
 	[i].buf_count = DT_INST_PROP(i, buf_count),					\
 	[i].buf_len = DT_INST_PROP(i, buf_data_length),					\
+	[i].buf_data = __BUF_DATA(i),							\
 	[i].agg_buffers = (struct aggregator_buffer *) &agg_ ## i ## _bufs,		\
 	[i].active_buf = (struct aggregator_buffer *) &agg_ ## i ## _bufs,
 
-#define __DEFINE_AGG							\
-	static struct aggregator aggregators[] = {			\
-		DT_INST_FOREACH_STATUS_OKAY(__DEFINE_AGGREGATOR)	\
-	}
-
 struct aggregator_buffer {
-	uint8_t *data;		/* Dynamic data. */
 	bool busy;		/* Buffer status. */
 	uint8_t sample_cnt;	/* Number of samples already saved in the buffer. */
 };
 
-struct aggregator {
+struct sensor_data_aggregator {
 	const char *sensor_descr;		/* sensor_description of the sensor. */
+	uint8_t *buf_data;			/* Data of all buffers, one after another. */
 	struct aggregator_buffer *agg_buffers;	/* Buffers. */
 	struct aggregator_buffer *active_buf;	/* Active buffer to which data will be placed. */
 	enum sensor_state sensor_state;		/* Sensors state. */
@@ -87,13 +71,32 @@ struct aggregator {
 };
 
 
+/* Buffer taken with the lock held, to be sent once the lock is released. */
+struct taken_buffer {
+	struct sensor_data_aggregator *agg;
+	uint8_t *data;
+	enum sensor_state sensor_state;
+	uint8_t sample_cnt;
+};
+
+
 DT_INST_FOREACH_STATUS_OKAY(__DEFINE_BUF_DATA) /* no semicolon on purpose. */
-static struct aggregator aggregators[] = {
+static struct sensor_data_aggregator aggregators[] = {
 	DT_INST_FOREACH_STATUS_OKAY(__DEFINE_AGGREGATOR)
 };
 
+/* Samples are written by the sensor manager thread and the buffers are sent and
+ * released by the event handler.
+ */
+static struct k_spinlock lock;
+
+
+static uint8_t *get_buffer_data(struct sensor_data_aggregator *agg, struct aggregator_buffer *ab)
+{
+	return agg->buf_data + (ab - agg->agg_buffers) * agg->buf_len;
+}
 
-static struct aggregator_buffer *get_free_buffer(struct aggregator *agg)
+static struct aggregator_buffer *get_free_buffer(struct sensor_data_aggregator *agg)
 {
 	for (size_t i = 0; i < agg->buf_count; i++) {
 		if (!agg->agg_buffers[i].busy) {
@@ -103,7 +106,7 @@ static struct aggregator_buffer *get_free_buffer(struct aggregator *agg)
 	return NULL;
 }
 
-static struct aggregator *get_aggregator(const char *sensor_descr)
+static struct sensor_data_aggregator *get_aggregator(const char *sensor_descr)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(aggregators); i++) {
 		if (sensor_descr == aggregators[i].sensor_descr) {
@@ -113,7 +116,18 @@ static struct aggregator *get_aggregator(const char *sensor_descr)
 	return NULL;
 }
 
-static void release_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
+static struct aggregator_buffer *get_buffer(struct sensor_data_aggregator *agg, const uint8_t *buf)
+{
+	size_t offset = buf - agg->buf_data;
+	size_t idx = offset / agg->buf_len;
+
+	if ((buf < agg->buf_data) || (idx >= agg->buf_count) || (offset % agg->buf_len)) {
+		return NULL;
+	}
+	return &agg->agg_buffers[idx];
+}
+
+static void release_buffer(struct sensor_data_aggregator *agg, struct aggregator_buffer *ab)
 {
 	__ASSERT_NO_MSG(ab);
 
@@ -124,52 +138,136 @@ static void release_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
 	}
 }
 
-static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
+/* Must be called with the lock taken. The buffer is sent with send_buffer once the
+ * lock is released.
+ */
+static void take_buffer(struct sensor_data_aggregator *agg, struct aggregator_buffer *ab,
+			struct taken_buffer *tb)
 {
 	ab->busy = true;
+	tb->agg = agg;
+	tb->data = get_buffer_data(agg, ab);
+	tb->sample_cnt = ab->sample_cnt;
+	tb->sensor_state = agg->sensor_state;
+
+	agg->active_buf = get_free_buffer(agg);
+}
+
+static void send_buffer(const struct taken_buffer *tb)
+{
+	if (!tb->data) {
+		return;
+	}
+
 	struct sensor_data_aggregator_event *event = new_sensor_data_aggregator_event();
 
-	event->buf = ab->data;
-	event->sample_cnt = ab->sample_cnt;
-	event->sensor_state = agg->sensor_state;
-	event->sensor_descr = agg->sensor_descr;
+	event->buf = tb->data;
+	event->sample_cnt = tb->sample_cnt;
+	event->sensor_state = tb->sensor_state;
+	event->sensor_descr = tb->agg->sensor_descr;
 	APP_EVENT_SUBMIT(event);
 }
 
-static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
+/* Must be called with the lock taken. */
+static void add_sample(struct sensor_data_aggregator *agg, struct taken_buffer *tb)
 {
+	struct aggregator_buffer *ab = agg->active_buf;
+	size_t avail;
+
+	ab->sample_cnt++;
+	avail = agg->buf_len - ab->sample_cnt * agg->sensor_data_size;
+
+	if (avail < agg->sensor_data_size) {
+		take_buffer(agg, ab, tb);
+	}
+}
+
+static int enqueue_sample(struct sensor_data_aggregator *agg, struct sensor_event *event)
+{
+	struct taken_buffer tb = {0};
+	k_spinlock_key_t key;
+	int err = 0;
+
 	if (event->dyndata.size != agg->sensor_data_size) {
 		return -EBADMSG;
 	}
+
+	key = k_spin_lock(&lock);
+
 	if (!agg->active_buf) {
-		return -ENOMEM;
+		err = -ENOMEM;
+	} else {
+		struct aggregator_buffer *ab = agg->active_buf;
+		size_t pos = ab->sample_cnt * agg->sensor_data_size;
+
+		__ASSERT_NO_MSG(agg->buf_len - pos >= agg->sensor_data_size);
+		memcpy(get_buffer_data(agg, ab) + pos, event->dyndata.data, event->dyndata.size);
+		add_sample(agg, &tb);
 	}
-	struct aggregator_buffer *ab = agg->active_buf;
 
-	size_t pos = ab->sample_cnt * agg->sensor_data_size;
-	size_t avail = agg->buf_len - pos;
+	k_spin_unlock(&lock, key);
 
-	if (avail < agg->sensor_data_size) {
-		__ASSERT_NO_MSG(false);
-		return -ENOMEM;
+	send_buffer(&tb);
+
+	return err;
+}
+
+struct sensor_data_aggregator *sensor_data_aggregator_get(const char *sensor_descr)
+{
+	return get_aggregator(sensor_descr);
+}
+
+void *sensor_data_aggregator_sample_claim(struct sensor_data_aggregator *agg, size_t size)
+{
+	k_spinlock_key_t key;
+	void *sample = NULL;
+
+	if (size != agg->sensor_data_size) {
+		return NULL;
 	}
-	memcpy(&ab->data[pos], event->dyndata.data, event->dyndata.size);
-	ab->sample_cnt++;
-	avail -= event->dyndata.size;
 
-	if (avail < agg->sensor_data_size) {
-		send_buffer(agg, ab);
-		agg->active_buf = get_free_buffer(agg);
+	key = k_spin_lock(&lock);
+
+	if (agg->active_buf) {
+		struct aggregator_buffer *ab = agg->active_buf;
+
+		sample = get_buffer_data(agg, ab) + ab->sample_cnt * agg->sensor_data_size;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return sample;
+}
+
+int sensor_data_aggregator_sample_commit(struct sensor_data_aggregator *agg, void *sample)
+{
+	struct taken_buffer tb = {0};
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int err = 0;
+
+	/* The active buffer may have been sent, and even released and reused, after the
+	 * sample was claimed. The sample is added only if it is still the next one.
+	 */
+	if (!agg->active_buf ||
+	    (sample != get_buffer_data(agg, agg->active_buf) +
+		       agg->active_buf->sample_cnt * agg->sensor_data_size)) {
+		err = -ECANCELED;
+	} else {
+		add_sample(agg, &tb);
 	}
 
-	return 0;
+	k_spin_unlock(&lock, key);
+
+	send_buffer(&tb);
+
+	return err;
 }
 
 static bool event_handler(const struct app_event_header *aeh)
 {
 	if (is_sensor_event(aeh)) {
 		struct sensor_event *event = cast_sensor_event(aeh);
-		struct aggregator *agg = get_aggregator(event->descr);
+		struct sensor_data_aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
 			int err = enqueue_sample(agg, event);
@@ -187,15 +285,17 @@ static bool event_handler(const struct app_event_header *aeh)
 	if (is_sensor_data_aggregator_release_buffer_event(aeh)) {
 		const struct sensor_data_aggregator_release_buffer_event *event =
 				cast_sensor_data_aggregator_release_buffer_event(aeh);
-		struct aggregator *agg = get_aggregator(event->sensor_descr);
+		struct sensor_data_aggregator *agg = get_aggregator(event->sensor_descr);
 
 		__ASSERT_NO_MSG(agg);
 
-		for (size_t i = 0; i < agg->buf_count; i++) {
-			if (agg->agg_buffers[i].data == event->buf) {
-				release_buffer(agg, &agg->agg_buffers[i]);
-				break;
-			}
+		struct aggregator_buffer *ab = get_buffer(agg, event->buf);
+
+		if (ab) {
+			k_spinlock_key_t key = k_spin_lock(&lock);
+
+			release_buffer(agg, ab);
+			k_spin_unlock(&lock, key);
 		}
 
 		return false;
@@ -203,14 +303,19 @@ static bool event_handler(const struct app_event_header *aeh)
 
 	if (is_sensor_state_event(aeh)) {
 		struct sensor_state_event *event = cast_sensor_state_event(aeh);
-		struct aggregator *agg = get_aggregator(event->descr);
+		struct sensor_data_aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			struct aggregator_buffer *ab = agg->active_buf;
+			struct taken_buffer tb = {0};
+			k_spinlock_key_t key = k_spin_lock(&lock);
 
 			agg->sensor_state = event->state;
-			send_buffer(agg, ab);
-			agg->active_buf = get_free_buffer(agg);
+			if (agg->active_buf) {
+				take_buffer(agg, agg->active_buf, &tb);
+			}
+			k_spin_unlock(&lock, key);
+
+			send_buffer(&tb);
 		}
 
 		return false;
@@ -10,6 +10,7 @@
 
 #include <caf/events/sensor_event.h>
 #include <caf/sensor_manager.h>
+#include <caf/sensor_data_aggregator.h>
 
 #include CONFIG_CAF_SENSOR_MANAGER_DEF_PATH
 
@@ -31,6 +32,10 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	struct sensor_data_aggregator *agg;
+	unsigned int agg_drops;
+#endif
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
@@ -215,14 +220,58 @@ static void enter_sleep(const struct sm_sensor_config *sc,
 	k_sched_unlock();
 }
 
+/* Claim the place for the sample in the aggregator buffer, so that the sample is written there
+ * without a sensor_event. Returns NULL if the sample should be sent in a sensor_event.
+ */
+static struct sensor_value *claim_aggregator_sample(struct sensor_data *sd, size_t data_cnt)
+{
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	if (sd->agg) {
+		struct sensor_value *sample;
+
+		sample = sensor_data_aggregator_sample_claim(sd->agg,
+							     data_cnt * sizeof(struct sensor_value));
+		if (!sample) {
+			/* Samples are dropped at the sampling rate, only report their number */
+			sd->agg_drops++;
+		} else if (sd->agg_drops > 0) {
+			LOG_WRN("%u samples dropped, no aggregator buffer", sd->agg_drops);
+			sd->agg_drops = 0;
+		}
+		return sample;
+	}
+#endif
+	return NULL;
+}
+
+static void commit_aggregator_sample(struct sensor_data *sd, struct sensor_value *sample)
+{
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	int err = sensor_data_aggregator_sample_commit(sd->agg, sample);
+
+	if (err) {
+		LOG_WRN("Sample dropped by the aggregator (err %d)", err);
+	}
+#endif
+}
+
 static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config *sc)
 {
 	size_t data_idx = 0;
 	size_t data_cnt = get_sensor_data_cnt(sc);
-	struct sensor_value data[data_cnt];
+	struct sensor_value local_data[data_cnt];
+	struct sensor_value *data = local_data;
+	struct sensor_value *agg_sample = NULL;
 
 	int err = sensor_sample_fetch(sc->dev);
 
+	if (!err && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+		agg_sample = claim_aggregator_sample(sd, data_cnt);
+		if (agg_sample) {
+			data = agg_sample;
+		}
+	}
+
 	for (size_t i = 0; !err && (i < sc->chan_cnt); i++) {
 		const struct sm_sampled_channel *sampled_chan = &sc->chans[i];
 
@@ -234,20 +283,28 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 		LOG_ERR("Sensor sampling error (err %d)", err);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
 	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
+		/* The activity is checked before the sample is passed on, because the sample in
+		 * the aggregator buffer may be sent and reused after it is committed.
+		 */
+		bool sleep = false;
+
+		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
+			process_sensor_activity(sc, sd, data);
+			sleep = !is_sensor_active(sd);
+		}
+
+		if (agg_sample) {
+			commit_aggregator_sample(sd, agg_sample);
+		} else if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+			send_sensor_event(sc->event_descr, data, data_cnt,
 					  &sd->event_cnt);
 		} else {
 			LOG_WRN("Did not send event due to too many active events on sensor: %s",
 				sc->dev->name);
 		}
 
-		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
-			process_sensor_activity(sc, sd, data);
-			if (!is_sensor_active(sd)) {
-				enter_sleep(sc, sd);
-			}
-
+		if (sleep) {
+			enter_sleep(sc, sd);
 		}
 	}
 }
@@ -389,6 +446,10 @@ static size_t sensor_init(void)
 		}
 		sd->sampling_period = sc->sampling_period_ms;
 		sd->sample_timeout = cur_uptime + sc->sampling_period_ms;
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+		sd->agg = sensor_data_aggregator_get(sc->event_descr);
+		sd->agg_drops = 0;
+#endif
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
 			int err = sensor_trigger_init(sc, sd);
@@ -60,6 +60,8 @@ LOG_MODULE_REGISTER(nrf_dm, CONFIG_DM_MODULE_LOG_LEVEL);
 #define DM_THREAD_PRIORITY           K_HIGHEST_APPLICATION_THREAD_PRIO
 #define TIMESLOT_TIMEOUT_STEP_MS     120000
 
+#define CALC_BUF_COUNT               2
+
 static K_MUTEX_DEFINE(ranging_mtx);
 static K_TIMER_DEFINE(timer, NULL, NULL);
 
@@ -121,6 +123,109 @@ static mpsl_timeslot_request_t timeslot_request_normal = {
 struct dm_result result;
 static mpsl_timeslot_signal_return_param_t signal_callback_return_param;
 
+#if defined(CONFIG_DM_CALC_WORKER)
+/* Ranging report waiting for or under the distance calculation. */
+struct calc_buf {
+	nrf_dm_report_t report;
+	struct dm_request req;
+	bool status;
+};
+
+static struct calc_buf calc_bufs[CALC_BUF_COUNT];
+static atomic_t calc_bufs_busy;
+K_MSGQ_DEFINE(calc_msgq, sizeof(uint8_t), CALC_BUF_COUNT, 1);
+#endif
+
+#if defined(CONFIG_DM_STATS)
+static struct {
+	struct k_spinlock lock;
+	struct dm_peer_stats peers[CONFIG_DM_STATS_PEER_COUNT];
+	size_t peer_cnt;
+	int64_t start;
+} stats;
+
+/* Must be called with the statistics locked. Returns NULL if the table is full. */
+static struct dm_peer_stats *stats_peer_get(const bt_addr_le_t *bt_addr)
+{
+	struct dm_peer_stats *peer;
+
+	for (size_t i = 0; i < stats.peer_cnt; i++) {
+		if (bt_addr_le_cmp(&stats.peers[i].bt_addr, bt_addr) == 0) {
+			return &stats.peers[i];
+		}
+	}
+
+	if (stats.peer_cnt == ARRAY_SIZE(stats.peers)) {
+		return NULL;
+	}
+
+	peer = &stats.peers[stats.peer_cnt++];
+	memset(peer, 0, sizeof(*peer));
+	bt_addr_le_copy(&peer->bt_addr, bt_addr);
+
+	return peer;
+}
+#endif
+
+static void stats_request(const bt_addr_le_t *bt_addr, int err)
+{
+#if defined(CONFIG_DM_STATS)
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+	struct dm_peer_stats *peer = stats_peer_get(bt_addr);
+
+	if (peer) {
+		switch (err) {
+		case 0:
+			peer->scheduled++;
+			break;
+		case -ENOMEM:
+			peer->rejected_full++;
+			break;
+		case -EAGAIN:
+			peer->rejected_peer_limit++;
+			break;
+		case -EBUSY:
+			peer->rejected_busy++;
+			break;
+		default:
+			break;
+		}
+	}
+
+	k_spin_unlock(&stats.lock, key);
+#endif
+}
+
+static void stats_ranging(const bt_addr_le_t *bt_addr)
+{
+#if defined(CONFIG_DM_STATS)
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+	struct dm_peer_stats *peer = stats_peer_get(bt_addr);
+
+	if (peer) {
+		peer->rangings++;
+	}
+
+	k_spin_unlock(&stats.lock, key);
+#endif
+}
+
+#if defined(CONFIG_DM_CALC_WORKER)
+static void stats_dropped(const bt_addr_le_t *bt_addr)
+{
+#if defined(CONFIG_DM_STATS)
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+	struct dm_peer_stats *peer = stats_peer_get(bt_addr);
+
+	if (peer) {
+		peer->dropped++;
+	}
+
+	k_spin_unlock(&stats.lock, key);
+#endif
+}
+#endif
+
 static int dm_configure(void)
 {
 	static nrf_dm_config_t dm_config;
@@ -247,14 +352,14 @@ static void mpsl_nonpreemptible_thread(void)
 	}
 }
 
-static void process_data(const nrf_dm_report_t *data)
+static void process_data(const nrf_dm_report_t *data, const struct dm_request *req, bool status)
 {
 	if (!data) {
 		result.status = false;
 		return;
 	}
-	result.status = dm_context.ranging_status;
-	bt_addr_le_copy(&result.bt_addr, &timeslot_ctx.curr_req.dm_req.bt_addr);
+	result.status = status;
+	bt_addr_le_copy(&result.bt_addr, &req->bt_addr);
 
 	result.quality = DM_QUALITY_NONE;
 	if (data->quality == NRF_DM_QUALITY_OK) {
@@ -267,7 +372,7 @@ static void process_data(const nrf_dm_report_t *data)
 		result.quality = DM_QUALITY_CRC_FAIL;
 	}
 
-	result.ranging_mode = timeslot_ctx.curr_req.dm_req.ranging_mode;
+	result.ranging_mode = req->ranging_mode;
 	if (result.ranging_mode == DM_RANGING_MODE_RTT) {
 		result.dist_estimates.rtt.rtt = data->distance_estimates.rtt.rtt;
 	} else {
@@ -309,7 +414,6 @@ static int timeslot_request(uint32_t distance_from_last)
 
 static void dm_start_ranging(void)
 {
-	struct timeslot_request *req;
 	int err;
 
 	k_mutex_lock(&ranging_mtx, K_FOREVER);
@@ -329,15 +433,12 @@ static void dm_start_ranging(void)
 		goto out;
 	}
 
-	req = timeslot_queue_peek();
-	if (!req) {
+	if (timeslot_queue_get(&timeslot_ctx.curr_req)) {
 		goto out;
 	}
 
-	memcpy(&timeslot_ctx.curr_req, req, sizeof(timeslot_ctx.curr_req));
-	timeslot_queue_remove_first();
-
-	uint32_t distance = time_distance_get(timeslot_ctx.last_start, req->start_time);
+	uint32_t distance = time_distance_get(timeslot_ctx.last_start,
+					      timeslot_ctx.curr_req.start_time);
 	uint32_t distance_now = time_distance_get(timeslot_ctx.last_start, time_now());
 
 	if (distance_now > distance) {
@@ -361,6 +462,7 @@ static void dm_reschedule(void)
 		if (dm_context.ranging_status) {
 			err = timeslot_queue_append(&timeslot_ctx.curr_req.dm_req,
 						timeslot_ctx.last_start);
+			stats_request(&timeslot_ctx.curr_req.dm_req.bt_addr, err);
 			if (err) {
 				LOG_DBG("Timeslot allocator failed (err %d)", err);
 			}
@@ -369,6 +471,62 @@ static void dm_reschedule(void)
 	}
 }
 
+#if defined(CONFIG_DM_CALC_WORKER)
+/* The distance calculation takes longer than the gap between two timeslots. It runs with
+ * a lower priority than the DM thread, which only copies the report and schedules the next
+ * timeslot.
+ */
+static void calc_thread(void)
+{
+	struct calc_buf *buf;
+	uint8_t idx;
+
+	while (1) {
+		if (k_msgq_get(&calc_msgq, &idx, K_FOREVER) == 0) {
+			buf = &calc_bufs[idx];
+
+			nrf_dm_calc(&buf->report);
+			process_data(&buf->report, &buf->req, buf->status);
+			atomic_clear_bit(&calc_bufs_busy, idx);
+
+			if (dm_context.cb->data_ready != NULL) {
+				dm_context.cb->data_ready(&result);
+			}
+		}
+	}
+}
+
+static void calc_submit(void)
+{
+	struct calc_buf *buf;
+	uint8_t idx;
+
+	/* Both buffers are busy when the calculation falls behind the rangings. Drop the
+	 * report rather than delay the next timeslot.
+	 */
+	for (idx = 0; idx < CALC_BUF_COUNT; idx++) {
+		if (!atomic_test_and_set_bit(&calc_bufs_busy, idx)) {
+			break;
+		}
+	}
+
+	if (idx == CALC_BUF_COUNT) {
+		LOG_DBG("Calculation busy, ranging report dropped");
+		stats_dropped(&timeslot_ctx.curr_req.dm_req.bt_addr);
+		return;
+	}
+
+	buf = &calc_bufs[idx];
+	nrf_dm_populate_report(&buf->report);
+	buf->req = timeslot_ctx.curr_req.dm_req;
+	buf->status = dm_context.ranging_status;
+
+	if (k_msgq_put(&calc_msgq, &idx, K_NO_WAIT)) {
+		atomic_clear_bit(&calc_bufs_busy, idx);
+	}
+}
+#endif
+
 static void calculation(void)
 {
 	if (IS_ENABLED(CONFIG_DM_MODULE_RPC_HOST)) {
@@ -381,15 +539,19 @@ static void calculation(void)
 			dm_rpc_calc_and_process(data, sizeof(*data));
 		}
 	} else {
+#if defined(CONFIG_DM_CALC_WORKER)
+		calc_submit();
+#else
 		static nrf_dm_report_t report;
 
 		nrf_dm_populate_report(&report);
 		nrf_dm_calc(&report);
-		process_data(&report);
+		process_data(&report, &timeslot_ctx.curr_req.dm_req, dm_context.ranging_status);
 
 		if (dm_context.cb->data_ready != NULL) {
 			dm_context.cb->data_ready(&result);
 		}
+#endif
 	}
 }
 
@@ -415,6 +577,7 @@ static void dm_thread(void)
 			case TIMESLOT_NORMAL_END:
 				dm_reschedule();
 				if (dm_context.ranging_status) {
+					stats_ranging(&timeslot_ctx.curr_req.dm_req.bt_addr);
 					calculation();
 				}
 
@@ -444,6 +607,7 @@ int dm_request_add(struct dm_request *req)
 
 	dm_io_set(DM_IO_ADD_REQUEST);
 	err = timeslot_queue_append(req, time_now());
+	stats_request(&req->bt_addr, err);
 	if (err) {
 		LOG_DBG("Timeslot allocation failed (err %d)", err);
 	}
@@ -490,6 +654,8 @@ int dm_init(struct dm_init_param *init_param)
 
 	dm_context.cb = init_param->cb;
 
+	dm_stats_reset();
+
 	err = dm_io_init();
 	if (err) {
 		LOG_ERR("IO init failed (err %d)", err);
@@ -499,7 +665,60 @@ int dm_init(struct dm_init_param *init_param)
 	return 0;
 }
 
+int dm_peer_stats_get(const bt_addr_le_t *bt_addr, struct dm_peer_stats *peer_stats)
+{
+#if defined(CONFIG_DM_STATS)
+	int err = -ENOENT;
+	k_spinlock_key_t key;
+	int64_t elapsed_ms;
+
+	if (!bt_addr || !peer_stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&stats.lock);
+
+	for (size_t i = 0; i < stats.peer_cnt; i++) {
+		if (bt_addr_le_cmp(&stats.peers[i].bt_addr, bt_addr) == 0) {
+			*peer_stats = stats.peers[i];
+			err = 0;
+			break;
+		}
+	}
+
+	elapsed_ms = k_uptime_get() - stats.start;
+
+	k_spin_unlock(&stats.lock, key);
+
+	if (!err && elapsed_ms > 0) {
+		peer_stats->ranging_rate = (uint64_t)peer_stats->rangings * MSEC_PER_SEC *
+					   SEC_PER_MIN / elapsed_ms;
+	}
+
+	return err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+void dm_stats_reset(void)
+{
+#if defined(CONFIG_DM_STATS)
+	k_spinlock_key_t key = k_spin_lock(&stats.lock);
+
+	stats.peer_cnt = 0;
+	stats.start = k_uptime_get();
+
+	k_spin_unlock(&stats.lock, key);
+#endif
+}
+
 K_THREAD_DEFINE(dm_thread_id, STACKSIZE, dm_thread, NULL, NULL, NULL, DM_THREAD_PRIORITY, 0, 0);
 
 K_THREAD_DEFINE(mpsl_nonpreemptible_thread_id, STACKSIZE,
 		mpsl_nonpreemptible_thread, NULL, NULL, NULL, K_PRIO_COOP(MPSL_THREAD_PRIO), 0, 0);
+
+#if defined(CONFIG_DM_CALC_WORKER)
+K_THREAD_DEFINE(calc_thread_id, CONFIG_DM_CALC_THREAD_STACK_SIZE, calc_thread, NULL, NULL, NULL,
+		CONFIG_DM_CALC_THREAD_PRIORITY, 0, 0);
+#endif
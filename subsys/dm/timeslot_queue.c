@@ -14,129 +14,131 @@
 #define MIN_TIME_BETWEEN_TIMESLOTS_US    CONFIG_DM_MIN_TIME_BETWEEN_TIMESLOTS_US
 #define RANGING_OFFSET_US                CONFIG_DM_RANGING_OFFSET_US
 
-static K_MUTEX_DEFINE(list_mtx);
-static sys_slist_t timeslot_list = SYS_SLIST_STATIC_INIT(&timeslot_list);
+BUILD_ASSERT(TIMESLOT_QUEUE_LENGTH <= UINT8_MAX, "Timeslot indices are 8 bits");
 
-struct timeslot_entry {
-	struct timeslot_request timeslot_req;
-	sys_snode_t node;
-};
+static struct k_spinlock queue_lock;
 
-static K_HEAP_DEFINE(heap, TIMESLOT_QUEUE_LENGTH * sizeof(struct timeslot_entry));
-
-static void list_lock(void)
-{
-	k_mutex_lock(&list_mtx, K_FOREVER);
-}
+/* Requests are stored in a fixed pool, and the order array holds the pool indices sorted by
+ * start time.
+ */
+static struct timeslot_request pool[TIMESLOT_QUEUE_LENGTH];
+static uint8_t order[TIMESLOT_QUEUE_LENGTH];
+static uint8_t queue_cnt;
 
-static void list_unlock(void)
-{
-	k_mutex_unlock(&list_mtx);
-}
+/* Stack of the free pool indices */
+static uint8_t free_idx[TIMESLOT_QUEUE_LENGTH];
+static uint8_t free_cnt;
+static bool initialized;
 
-static size_t get_list_size(void)
+/* Signed distance from t1 to t2. The times are at most half the counter range apart. */
+static int32_t time_diff(uint32_t t1, uint32_t t2)
 {
-	size_t ret = 0;
-	sys_snode_t *node, *tmp;
+	uint32_t distance = time_distance_get(t1, t2);
 
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&timeslot_list, node, tmp) {
-		ret++;
+	if (distance > RTC_COUNTER_MAX / 2) {
+		return (int32_t)distance - (int32_t)(RTC_COUNTER_MAX + 1);
 	}
 
-	return ret;
+	return distance;
 }
 
-static bool is_request_exist(struct dm_request *req)
+static void queue_init(void)
 {
-	uint8_t cnt = 0;
-	sys_snode_t *node, *tmp;
-	struct timeslot_entry *item;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&timeslot_list, node, tmp) {
-		item = CONTAINER_OF(node, struct timeslot_entry, node);
-		if (bt_addr_le_cmp(&item->timeslot_req.dm_req.bt_addr, &req->bt_addr) == 0) {
-			cnt++;
-		}
+	for (size_t i = 0; i < TIMESLOT_QUEUE_LENGTH; i++) {
+		free_idx[i] = i;
 	}
 
-	return cnt >= TIMESLOT_QUEUE_COUNT_SAME_PEER;
+	free_cnt = TIMESLOT_QUEUE_LENGTH;
+	initialized = true;
 }
 
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick)
 {
+	const int32_t spacing = US_TO_RTC_TICKS(TIMESLOT_LENGTH_US +
+						 MIN_TIME_BETWEEN_TIMESLOTS_US);
+	struct timeslot_request *item;
+	k_spinlock_key_t key;
 	uint32_t start_time;
 	uint32_t delay;
-	size_t list_size;
-	struct timeslot_entry *last, *item;
+	uint8_t peer_cnt = 0;
+	size_t pos = 0;
+	int err = 0;
 
 	delay = req->start_delay_us + RANGING_OFFSET_US;
 	start_time = (start_ref_tick + US_TO_RTC_TICKS(delay)) % RTC_COUNTER_MAX;
 
-	list_size = get_list_size();
-	if (list_size >= TIMESLOT_QUEUE_LENGTH) {
-		return -ENOMEM;
+	key = k_spin_lock(&queue_lock);
+
+	if (!initialized) {
+		queue_init();
 	}
 
-	if (list_size != 0) {
-		if (is_request_exist(req)) {
-			return -EAGAIN;
-		}
+	if (queue_cnt >= TIMESLOT_QUEUE_LENGTH) {
+		err = -ENOMEM;
+		goto out;
+	}
 
-		list_lock();
-		last = SYS_SLIST_PEEK_TAIL_CONTAINER(&timeslot_list, last, node);
-		list_unlock();
+	/* Count the timeslots of the peer and find the position of the new timeslot */
+	for (size_t i = 0; i < queue_cnt; i++) {
+		item = &pool[order[i]];
 
-		if ((time_distance_get(last->timeslot_req.start_time, start_time) <
-			     US_TO_RTC_TICKS(TIMESLOT_LENGTH_US + MIN_TIME_BETWEEN_TIMESLOTS_US))) {
-			return -EBUSY;
+		if (bt_addr_le_cmp(&item->dm_req.bt_addr, &req->bt_addr) == 0) {
+			peer_cnt++;
+		}
+
+		if (time_diff(item->start_time, start_time) >= 0) {
+			pos = i + 1;
 		}
 	}
 
-	item = k_heap_alloc(&heap, sizeof(struct timeslot_entry), K_NO_WAIT);
-	if (!item) {
-		return -ENOMEM;
+	if (peer_cnt >= TIMESLOT_QUEUE_COUNT_SAME_PEER) {
+		err = -EAGAIN;
+		goto out;
 	}
 
-	item->timeslot_req.start_time = start_time;
+	/* The timeslot must fit in the gap between its neighbors */
+	if ((pos > 0 && time_diff(pool[order[pos - 1]].start_time, start_time) < spacing) ||
+	    (pos < queue_cnt && time_diff(start_time, pool[order[pos]].start_time) < spacing)) {
+		err = -EBUSY;
+		goto out;
+	}
+
+	item = &pool[free_idx[--free_cnt]];
+	item->start_time = start_time;
 	req->access_address++;
 
-	memcpy(&item->timeslot_req.dm_req, req, sizeof(item->timeslot_req.dm_req));
+	memcpy(&item->dm_req, req, sizeof(item->dm_req));
+
+	memmove(&order[pos + 1], &order[pos], queue_cnt - pos);
+	order[pos] = item - pool;
+	queue_cnt++;
 
-	list_lock();
-	sys_slist_append(&timeslot_list, &item->node);
-	list_unlock();
+out:
+	k_spin_unlock(&queue_lock, key);
 
-	return 0;
+	return err;
 }
 
-struct timeslot_request *timeslot_queue_peek(void)
+int timeslot_queue_get(struct timeslot_request *req)
 {
-	struct timeslot_entry *item;
+	k_spinlock_key_t key;
+	int err = 0;
 
-	list_lock();
-	item = SYS_SLIST_PEEK_HEAD_CONTAINER(&timeslot_list, item, node);
-	list_unlock();
+	key = k_spin_lock(&queue_lock);
 
-	if (!item) {
-		return NULL;
+	if (queue_cnt == 0) {
+		err = -ENOENT;
+		goto out;
 	}
 
-	return &item->timeslot_req;
-}
-
-void timeslot_queue_remove_first(void)
-{
-	sys_snode_t *node;
-	struct timeslot_entry *item;
+	memcpy(req, &pool[order[0]], sizeof(*req));
 
-	list_lock();
-	node = sys_slist_get(&timeslot_list);
-	list_unlock();
+	free_idx[free_cnt++] = order[0];
+	queue_cnt--;
+	memmove(&order[0], &order[1], queue_cnt);
 
-	if (!node) {
-		return;
-	}
+out:
+	k_spin_unlock(&queue_lock, key);
 
-	item = CONTAINER_OF(node, struct timeslot_entry, node);
-	k_heap_free(&heap, item);
+	return err;
 }
@@ -30,30 +30,27 @@ struct timeslot_request {
 	uint32_t start_time;
 };
 
-/** @brief Append an element to the end of a queue.
+/** @brief Add a timeslot to the queue.
+ *
+ *  The queue is sorted by start time. The timeslot is added if it fits in the gap
+ *  between the timeslots already scheduled before and after it.
  *
  *  @param req Address of the structure with request parameters.
  *  @param start_ref_tick Referen start time tick.
  *
- *  @retval -ENOMEM when the tiemslot queue is full or a memory allocation error.
+ *  @retval -ENOMEM when the tiemslot queue is full.
  *  @retval -EAGAIN when a single peer has a maximum number of timeslots scheduled.
  *  @retval -EBUSY when the timeslot cannot be scheduled due to time restrictions.
  */
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick);
 
-/** @brief Peek element at the head of queue.
- *
- *  @param None
+/** @brief Get and remove the earliest timeslot of the queue.
  *
- *  @retval Head element, or NULL if queue is empty.
- */
-struct timeslot_request *timeslot_queue_peek(void);
-
-/** @brief Remove the first item from the timeslot queue.
+ *  @param req Address of the structure to copy the timeslot to.
  *
- *  @param None
+ *  @retval -ENOENT when the queue is empty.
  */
-void timeslot_queue_remove_first(void);
+int timeslot_queue_get(struct timeslot_request *req);
 
 #ifdef __cplusplus
 }
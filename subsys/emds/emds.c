@@ -14,6 +14,12 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(emds, CONFIG_EMDS_LOG_LEVEL);
 
+/* Duration of the last store, saved with the entries */
+struct emds_store_time {
+	uint32_t time_us;
+	uint32_t size;
+};
+
 K_SEM_DEFINE(emds_sem, 0, 1);
 static bool emds_ready;
 static bool emds_initialized;
@@ -22,6 +28,8 @@ static uint32_t store_key;
 static sys_slist_t emds_dynamic_entries;
 static struct emds_fs emds_flash;
 static emds_store_cb_t app_store_cb;
+static struct emds_store_time last_store;
+static uint32_t prepared_size;
 
 static void emds_handler(void)
 {
@@ -29,13 +37,15 @@ static void emds_handler(void)
 		k_sem_reset(&emds_sem);
 		k_sem_take(&emds_sem, K_FOREVER);
 
+		uint32_t start = k_cycle_get_32();
+
 		k_sched_lock();
 
 		LOG_DBG("Emergency Data Storeage released");
 
 		STRUCT_SECTION_FOREACH(emds_entry, ch) {
-			ssize_t len = emds_flash_write(&emds_flash,
-						       ch->id, ch->data, ch->len);
+			ssize_t len = emds_flash_write_staged(&emds_flash,
+							      ch->id, ch->data, ch->len);
 			if (len < 0) {
 				LOG_ERR("Write static entry: (%d) error (%d)",
 					ch->id, len);
@@ -48,8 +58,8 @@ static void emds_handler(void)
 		struct emds_dynamic_entry *ch;
 
 		SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-			ssize_t len = emds_flash_write(&emds_flash,
-						       ch->entry.id, ch->entry.data, ch->entry.len);
+			ssize_t len = emds_flash_write_staged(&emds_flash, ch->entry.id,
+							      ch->entry.data, ch->entry.len);
 			if (len < 0) {
 				LOG_ERR("Write dynamic entry: (%d) error (%d).",
 					ch->entry.id, len);
@@ -60,6 +70,20 @@ static void emds_handler(void)
 			}
 		}
 
+		int err = emds_flash_flush(&emds_flash);
+
+		if (err) {
+			LOG_ERR("Flush entries error (%d)", err);
+		} else {
+			struct emds_store_time store_time = {
+				.time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start),
+				.size = prepared_size,
+			};
+
+			(void)emds_flash_write(&emds_flash, EMDS_STORE_TIME_ID, &store_time,
+					       sizeof(store_time));
+		}
+
 		emds_ready = false;
 
 		k_sched_unlock();
@@ -143,6 +167,10 @@ static int emds_entries_size(uint32_t *size)
 		entries++;
 	}
 
+	/* The duration of the store is saved after the entries */
+	*size += NRFX_CEIL_DIV(sizeof(struct emds_store_time), block_size) * block_size;
+	*size += NRFX_CEIL_DIV(emds_flash.ate_size, block_size) * block_size;
+
 	return entries;
 }
 
@@ -179,6 +207,10 @@ int emds_entry_add(struct emds_dynamic_entry *entry)
 		return -ECANCELED;
 	}
 
+	if (entry->entry.id == EMDS_STORE_TIME_ID) {
+		return -EINVAL;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
 		if (ch->entry.id == entry->entry.id) {
 			return -EINVAL;
@@ -210,6 +242,8 @@ int emds_store(void)
 int emds_load(void)
 {
 	struct emds_dynamic_entry *ch;
+	int64_t start = k_uptime_ticks();
+	int entries = 0;
 
 	if (!emds_initialized) {
 		return -ECANCELED;
@@ -220,6 +254,8 @@ int emds_load(void)
 					      ch->entry.id, ch->entry.data,
 					      ch->entry.len);
 
+		entries++;
+
 		if (len < 0) {
 			if (len != -ENXIO) {
 				LOG_ERR("Read dynamic entry: (%d) error (%d)",
@@ -235,6 +271,8 @@ int emds_load(void)
 		ssize_t len = emds_flash_read(&emds_flash,
 					      ch->id, ch->data, ch->len);
 
+		entries++;
+
 		if (len < 0) {
 			if (len != -ENXIO) {
 				LOG_ERR("Read static entry: (%d) error (%d)",
@@ -246,6 +284,15 @@ int emds_load(void)
 		}
 	}
 
+	if (emds_flash_read(&emds_flash, EMDS_STORE_TIME_ID, &last_store,
+			    sizeof(last_store)) != sizeof(last_store)) {
+		last_store.time_us = 0;
+		last_store.size = 0;
+	}
+
+	LOG_DBG("Loaded %d entries in %lld us", entries,
+		k_ticks_to_us_ceil64(k_uptime_ticks() - start));
+
 	return 0;
 }
 
@@ -274,6 +321,8 @@ int emds_prepare(void)
 		return rc;
 	}
 
+	prepared_size = size;
+
 	emds_ready = true;
 
 	return 0;
@@ -284,6 +333,15 @@ uint32_t emds_store_time_get(void)
 	size_t block_size = emds_flash.flash_params->write_block_size;
 	uint32_t store_time_us = CONFIG_EMDS_FLASH_TIME_BASE_OVERHEAD_US;
 
+	/* Scale the duration of the last store to the current size of the entries */
+	if (last_store.size) {
+		uint32_t size;
+
+		(void)emds_entries_size(&size);
+
+		return store_time_us + (uint32_t)NRFX_CEIL_DIV((uint64_t)last_store.time_us * size,
+							       last_store.size);
+	}
 
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
 		store_time_us += NRFX_CEIL_DIV(ch->len, block_size) *
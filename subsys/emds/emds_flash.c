@@ -36,6 +36,80 @@ enum ate_type {
 BUILD_ASSERT(offsetof(struct emds_ate, crc8) == sizeof(struct emds_ate) - sizeof(uint8_t),
 	     "crc8 must be the last member");
 
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+BUILD_ASSERT((CONFIG_EMDS_STORE_BUFFER_SIZE % sizeof(struct emds_ate)) == 0,
+	     "The store buffer must fit a whole number of allocation table entries");
+#endif
+
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+static void index_clear(struct emds_fs *fs)
+{
+	fs->index_cnt = 0;
+	fs->index_overflow = false;
+}
+
+/* Position of the id in the index, or the position to insert it at */
+static uint16_t index_pos(const struct emds_fs *fs, uint16_t id)
+{
+	uint16_t lo = 0;
+	uint16_t hi = fs->index_cnt;
+
+	while (lo < hi) {
+		uint16_t mid = lo + (hi - lo) / 2;
+
+		if (fs->index[mid].id < id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Entries must be added from the oldest to the newest */
+static void index_update(struct emds_fs *fs, const struct emds_ate *entry)
+{
+	uint16_t pos = index_pos(fs, entry->id);
+
+	if (pos == fs->index_cnt || fs->index[pos].id != entry->id) {
+		if (fs->index_cnt == ARRAY_SIZE(fs->index)) {
+			/* Ids which are not indexed are looked up in flash */
+			fs->index_overflow = true;
+			return;
+		}
+
+		memmove(&fs->index[pos + 1], &fs->index[pos],
+			(fs->index_cnt - pos) * sizeof(fs->index[0]));
+		fs->index_cnt++;
+	}
+
+	fs->index[pos].id = entry->id;
+	fs->index[pos].offset = entry->offset;
+	fs->index[pos].len = entry->len;
+	fs->index[pos].crc8_data = entry->crc8_data;
+}
+
+/* Returns 0 if found, -ENXIO if the id is not stored, or -ENOENT if the id must be
+ * looked up in flash.
+ */
+static int index_find(const struct emds_fs *fs, uint16_t id, struct emds_ate *entry)
+{
+	uint16_t pos = index_pos(fs, id);
+
+	if (pos == fs->index_cnt || fs->index[pos].id != id) {
+		return fs->index_overflow ? -ENOENT : -ENXIO;
+	}
+
+	entry->id = id;
+	entry->offset = fs->index[pos].offset;
+	entry->len = fs->index[pos].len;
+	entry->crc8_data = fs->index[pos].crc8_data;
+
+	return 0;
+}
+#endif
+
 static size_t align_size(struct emds_fs *fs, size_t len)
 {
 	uint8_t write_block_size = fs->flash_params->write_block_size;
@@ -154,8 +228,115 @@ static int entry_wrt(struct emds_fs *fs, uint16_t id, const void *data, size_t l
 		return rc;
 	}
 
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	index_update(fs, &entry);
+#endif
+
+	return 0;
+}
+
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+static void store_reset(struct emds_fs *fs)
+{
+	fs->store_buf_len = 0;
+	fs->store_entry_cnt = 0;
+}
+
+/* The buffer holds the data right below the data write address */
+static int store_data_flush(struct emds_fs *fs)
+{
+	int rc;
+
+	if (!fs->store_buf_len) {
+		return 0;
+	}
+
+	rc = flash_write(fs->flash_dev,
+			 fs->offset + fs->data_wra_offset - fs->store_buf_len,
+			 fs->store_buf, fs->store_buf_len);
+	if (rc) {
+		return rc;
+	}
+
+	fs->store_buf_len = 0;
+	return 0;
+}
+
+static int store_data_add(struct emds_fs *fs, const uint8_t *data, size_t len)
+{
+	size_t pad = align_size(fs, len) - len;
+	size_t chunk;
+	int rc;
+
+	while (len) {
+		chunk = MIN(len, sizeof(fs->store_buf) - fs->store_buf_len);
+		memcpy(&fs->store_buf[fs->store_buf_len], data, chunk);
+		fs->store_buf_len += chunk;
+		fs->data_wra_offset += chunk;
+		data += chunk;
+		len -= chunk;
+
+		if (fs->store_buf_len == sizeof(fs->store_buf)) {
+			rc = store_data_flush(fs);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	/* The buffer size is a multiple of the write block size, so the padding always fits */
+	memset(&fs->store_buf[fs->store_buf_len], fs->flash_params->erase_value, pad);
+	fs->store_buf_len += pad;
+	fs->data_wra_offset += pad;
+
+	return 0;
+}
+
+/* Write the allocation table entries of all staged entries. The newest entry has the lowest
+ * address, so the entries are written in reverse order with a single flash write.
+ */
+static int store_ate_flush(struct emds_fs *fs)
+{
+	struct emds_ate *ate_buf = (struct emds_ate *)fs->store_buf;
+	uint16_t cnt = fs->store_entry_cnt;
+	int rc;
+
+	if (!cnt) {
+		return 0;
+	}
+
+	/* An entry must not become valid before its data is in flash */
+	rc = store_data_flush(fs);
+	if (rc) {
+		return rc;
+	}
+
+	for (uint16_t i = 0; i < cnt; i++) {
+		const struct emds_index_entry *staged = &fs->store_entries[cnt - 1 - i];
+		struct emds_ate *entry = &ate_buf[i];
+
+		entry->id = staged->id;
+		entry->offset = staged->offset;
+		entry->len = staged->len;
+		entry->crc8_data = staged->crc8_data;
+		entry->crc8 = crc8_ccitt(0xff, entry, offsetof(struct emds_ate, crc8));
+	}
+
+	rc = flash_write(fs->flash_dev, fs->ate_wra + fs->ate_size, ate_buf, cnt * fs->ate_size);
+	if (rc) {
+		return rc;
+	}
+
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	for (uint16_t i = cnt; i > 0; i--) {
+		index_update(fs, &ate_buf[i - 1]);
+	}
+#endif
+
+	fs->store_entry_cnt = 0;
 	return 0;
 }
+#endif /* CONFIG_EMDS_STORE_BUFFER_SIZE > 0 */
 
 static enum ate_type ate_check(struct emds_fs *fs, uint32_t addr, struct emds_ate *entry)
 {
@@ -191,6 +372,9 @@ static int ate_last_recover(struct emds_fs *fs)
 
 	fs->ate_wra = fs->offset + fs->sector_cnt * fs->sector_size - fs->ate_size;
 	fs->data_wra_offset = 0;
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	index_clear(fs);
+#endif
 	while (type != ATE_TYPE_ERASED) {
 		/* Ate wra has reached the start of the data area */
 		if (fs->ate_wra < fs->offset) {
@@ -209,6 +393,10 @@ static int ate_last_recover(struct emds_fs *fs)
 
 		switch (type) {
 		case ATE_TYPE_VALID:
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+			/* Entries are recovered from the oldest to the newest */
+			index_update(fs, &end_ate);
+#endif
 			fs->data_wra_offset = align_size(fs, end_ate.offset + end_ate.len);
 			fs->ate_wra -= fs->ate_size;
 			expect_field = ATE_TYPE_VALID | ATE_TYPE_ERASED;
@@ -256,6 +444,10 @@ static int old_entries_invalidate(struct emds_fs *fs)
 		addr += fs->ate_size;
 	}
 
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	index_clear(fs);
+#endif
+
 	return 0;
 }
 
@@ -356,25 +548,90 @@ ssize_t emds_flash_write(struct emds_fs *fs, uint16_t id, const void *data, size
 	return len;
 }
 
-ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+ssize_t emds_flash_write_staged(struct emds_fs *fs, uint16_t id, const void *data, size_t len)
 {
-	if (!fs->is_initialized) {
-		LOG_ERR("EMDS flash not initialized");
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+	struct emds_index_entry *staged;
+	int rc = 0;
+
+	if (!fs->is_initialized || !fs->is_prepeared) {
+		LOG_ERR("EMDS flash not initialized or not ready for write");
 		return -EACCES;
 	}
 
+	/* The allocation table is only coalesced when entries are not padded */
+	if (sizeof(struct emds_ate) != fs->ate_size) {
+		return emds_flash_write(fs, id, data, len);
+	}
+
+	if (fs->ate_size + align_size(fs, len) > emds_flash_free_space_get(fs)) {
+		return -ENOMEM;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	k_mutex_lock(&fs->emds_lock, K_FOREVER);
+
+	if (fs->store_entry_cnt == ARRAY_SIZE(fs->store_entries)) {
+		rc = store_ate_flush(fs);
+		if (rc) {
+			goto out;
+		}
+	}
+
+	staged = &fs->store_entries[fs->store_entry_cnt];
+	staged->id = id;
+	staged->offset = fs->data_wra_offset;
+	staged->len = (uint16_t)len;
+	staged->crc8_data = crc8_ccitt(0xff, data, len);
+
+	rc = store_data_add(fs, data, len);
+	if (rc) {
+		goto out;
+	}
+
+	fs->store_entry_cnt++;
+	fs->ate_wra -= fs->ate_size;
+
+out:
+	k_mutex_unlock(&fs->emds_lock);
+	return rc ? rc : len;
+#else
+	return emds_flash_write(fs, id, data, len);
+#endif
+}
+
+int emds_flash_flush(struct emds_fs *fs)
+{
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+	int rc;
+
+	k_mutex_lock(&fs->emds_lock, K_FOREVER);
+	rc = store_ate_flush(fs);
+	k_mutex_unlock(&fs->emds_lock);
+
+	return rc;
+#else
+	return 0;
+#endif
+}
+
+/* Walk the allocation table from the newest entry to find the latest entry of the id */
+static int ate_find(struct emds_fs *fs, uint16_t id, struct emds_ate *wlk_ate)
+{
 	int rc;
 	uint32_t wlk_addr = fs->ate_wra;
-	struct emds_ate wlk_ate;
 
 	while (true) {
-		rc = flash_read(fs->flash_dev, wlk_addr, &wlk_ate, sizeof(struct emds_ate));
+		rc = flash_read(fs->flash_dev, wlk_addr, wlk_ate, sizeof(struct emds_ate));
 		if (rc) {
 			return rc;
 		}
 
-		if ((wlk_ate.id == id) && (is_ate_valid(&wlk_ate))) {
-			break;
+		if ((wlk_ate->id == id) && (is_ate_valid(wlk_ate))) {
+			return 0;
 		}
 
 		wlk_addr += fs->ate_size;
@@ -382,6 +639,29 @@ ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
 			return -ENXIO;
 		}
 	}
+}
+
+ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+{
+	if (!fs->is_initialized) {
+		LOG_ERR("EMDS flash not initialized");
+		return -EACCES;
+	}
+
+	int rc;
+	struct emds_ate wlk_ate;
+
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	rc = index_find(fs, id, &wlk_ate);
+	if (rc == -ENOENT) {
+		rc = ate_find(fs, id, &wlk_ate);
+	}
+#else
+	rc = ate_find(fs, id, &wlk_ate);
+#endif
+	if (rc) {
+		return rc;
+	}
 
 	if (len < wlk_ate.len) {
 		return -ENOMEM;
@@ -421,6 +701,10 @@ int emds_flash_prepare(struct emds_fs *fs, int byte_size)
 		fs->force_erase = false;
 	}
 
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+	store_reset(fs);
+#endif
+
 	fs->is_prepeared = true;
 	return 0;
 }
@@ -15,6 +15,21 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Location of an entry in the emergency data storage
+ *
+ * @param id Id of the entry
+ * @param offset Data offset within the storage area
+ * @param len Data length
+ * @param crc8_data crc8 check of the data
+ */
+struct emds_index_entry {
+	uint16_t id;
+	uint16_t offset;
+	uint16_t len;
+	uint8_t crc8_data;
+};
+
 /**
  * @brief Emergency data storage file system structure
  *
@@ -31,6 +46,13 @@ extern "C" {
  * @param flash_dev Pointer to flash device runtime structure
  * @param flash_params Pointer to flash memory parameters structure
  * @param force_erase Force erase flag
+ * @param index RAM index of the latest valid entry of each id, sorted by id
+ * @param index_cnt Number of entries in the index
+ * @param index_overflow Some ids did not fit in the index
+ * @param store_buf Data of the staged entries which is not yet written to flash
+ * @param store_buf_len Number of bytes in the store buffer
+ * @param store_entries Staged entries with no allocation table entry in flash yet
+ * @param store_entry_cnt Number of staged entries
  */
 struct emds_fs {
 	off_t offset;
@@ -45,6 +67,17 @@ struct emds_fs {
 	const struct device *flash_dev;
 	const struct flash_parameters *flash_params;
 	bool force_erase;
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	struct emds_index_entry index[CONFIG_EMDS_FLASH_INDEX_SIZE];
+	uint16_t index_cnt;
+	bool index_overflow;
+#endif
+#if CONFIG_EMDS_STORE_BUFFER_SIZE > 0
+	uint8_t store_buf[CONFIG_EMDS_STORE_BUFFER_SIZE] __aligned(4);
+	uint16_t store_buf_len;
+	struct emds_index_entry store_entries[CONFIG_EMDS_STORE_BUFFER_SIZE / 8];
+	uint16_t store_entry_cnt;
+#endif
 };
 
 /**
@@ -82,6 +115,34 @@ int emds_flash_clear(struct emds_fs *fs);
  */
 ssize_t emds_flash_write(struct emds_fs *fs, uint16_t id, const void *data, size_t len);
 
+/**
+ * @brief Stage an entry to be written to the EMDS file system.
+ *
+ * The data of consecutive staged entries is packed and written to flash in bursts, and their
+ * allocation table entries are written in a batch after the data. A staged entry is not
+ * readable until it has been written by @ref emds_flash_flush. Staged and direct writes with
+ * @ref emds_flash_write must not be mixed without flushing in between. On flash with a write
+ * block larger than an allocation table entry, the entry is written directly instead.
+ *
+ * @param fs Pointer to file system
+ * @param id Id of the entry to be written
+ * @param data Pointer to the data to be written
+ * @param len Number of bytes to be written
+ *
+ * @return Number of bytes staged. On error, returns negative value of errno.h defined error
+ * codes.
+ */
+ssize_t emds_flash_write_staged(struct emds_fs *fs, uint16_t id, const void *data, size_t len);
+
+/**
+ * @brief Write all staged entries to the EMDS file system.
+ *
+ * @param fs Pointer to file system
+ *
+ * @retval 0 on success or negative error code
+ */
+int emds_flash_flush(struct emds_fs *fs);
+
 /**
  * @brief Read an entry from the EMDS file system.
  *
@@ -5,6 +5,7 @@
  */
 #include <errno.h>
 #include <zephyr/irq.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/byteorder.h>
 #include <nrf.h>
 #include <esb.h>
@@ -104,16 +105,18 @@ struct pipe_info {
 	bool ack_payload; /* State of the transmission of ACK payloads. */
 };
 
-/* Structure used by the PRX to organize ACK payloads for multiple pipes. */
-struct payload_wrap {
-	/* Pointer to the ACK payload. */
-	struct esb_payload  *p_payload;
-	/* Value used to determine if the current payload pointer is used. */
-	bool in_use;
-	/* Pointer to the next ACK payload queued on the same pipe. */
-	struct payload_wrap *p_next;
+/* First-in, first-out queue used by the PRX to organize the ACK payloads of one pipe.
+ * The queue holds indices of the TX FIFO payload buffers.
+ */
+struct ack_pl_fifo {
+	uint8_t slot[CONFIG_ESB_TX_FIFO_SIZE];
+
+	uint8_t front;	/* Front of queue (first out). */
+	uint8_t count;	/* Number of elements in the queue. */
 };
 
+BUILD_ASSERT(CONFIG_ESB_TX_FIFO_SIZE <= UINT8_MAX, "ACK payload queue indices are 8 bits");
+
 /* First-in, first-out queue of payloads to be transmitted. */
 struct payload_tx_fifo {
 	 /* Payload queue */
@@ -176,12 +179,34 @@ static struct esb_payload *current_payload;
 /* FIFOs and buffers */
 static struct payload_tx_fifo tx_fifo;
 static struct payload_rx_fifo rx_fifo;
-static uint8_t tx_payload_buffer[CONFIG_ESB_MAX_PAYLOAD_LENGTH + 2];
+static uint8_t tx_payload_buffers[IS_ENABLED(CONFIG_ESB_BURST_TX) ? 2 : 1]
+				 [CONFIG_ESB_MAX_PAYLOAD_LENGTH + 2];
+static uint8_t *tx_payload_buffer = tx_payload_buffers[0];
 static uint8_t rx_payload_buffer[CONFIG_ESB_MAX_PAYLOAD_LENGTH + 2];
 
-/* Random access buffer variables for ACK payload handling */
-struct payload_wrap ack_pl_wrap[CONFIG_ESB_TX_FIFO_SIZE];
-struct payload_wrap *ack_pl_wrap_pipe[CONFIG_ESB_PIPE_COUNT];
+/* ACK payload queues and the bitmap of the free TX FIFO payload buffers */
+static struct ack_pl_fifo ack_pl_fifos[CONFIG_ESB_PIPE_COUNT];
+static uint32_t ack_pl_free[DIV_ROUND_UP(CONFIG_ESB_TX_FIFO_SIZE, 32)];
+
+#if defined(CONFIG_ESB_IRQ_LOCK_STATS)
+static uint32_t irq_lock_cycles_max;
+#endif
+
+#if defined(CONFIG_ESB_BURST_TX)
+/* Payload prepared in the spare TX buffer, to be sent right after the current one.
+ * It is cleared when the TX FIFO is changed by the application.
+ */
+static struct esb_payload *burst_payload;
+static uint8_t *burst_buffer = tx_payload_buffers[1];
+/* The radio ramps up for the chained payload when the ACK RX window ends */
+static bool burst_chained;
+/* PACKETPTR points to the spare TX buffer for the next transmission */
+static bool burst_armed;
+#endif
+
+#if defined(CONFIG_ESB_PIPE_STATS)
+static struct esb_pipe_stats pipe_stats[CONFIG_ESB_PIPE_COUNT];
+#endif
 
 /* Run time variables */
 static uint8_t pids[CONFIG_ESB_PIPE_COUNT];
@@ -445,12 +470,30 @@ static bool update_radio_parameters(void)
 	return params_valid;
 }
 
+static void reset_ack_pl_fifos(void)
+{
+	for (size_t i = 0; i < CONFIG_ESB_PIPE_COUNT; i++) {
+		ack_pl_fifos[i].front = 0;
+		ack_pl_fifos[i].count = 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(ack_pl_free); i++) {
+		ack_pl_free[i] = UINT32_MAX;
+	}
+
+	if (CONFIG_ESB_TX_FIFO_SIZE % 32) {
+		ack_pl_free[ARRAY_SIZE(ack_pl_free) - 1] = BIT_MASK(CONFIG_ESB_TX_FIFO_SIZE % 32);
+	}
+}
+
 static void reset_fifos(void)
 {
 	tx_fifo.back = 0;
 	tx_fifo.front = 0;
 	tx_fifo.count = 0;
 
+	reset_ack_pl_fifos();
+
 	rx_fifo.back = 0;
 	rx_fifo.front = 0;
 	rx_fifo.count = 0;
@@ -470,16 +513,44 @@ static void initialize_fifos(void)
 	for (size_t i = 0; i < CONFIG_ESB_RX_FIFO_SIZE; i++) {
 		rx_fifo.payload[i] = &rx_payload[i];
 	}
+}
 
-	for (size_t i = 0; i < CONFIG_ESB_TX_FIFO_SIZE; i++) {
-		ack_pl_wrap[i].p_payload = &tx_payload[i];
-		ack_pl_wrap[i].in_use = false;
-		ack_pl_wrap[i].p_next = 0;
+/* Take a free TX FIFO payload buffer, returns its index or -1 if all buffers are used. */
+static int ack_pl_slot_alloc(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(ack_pl_free); i++) {
+		if (ack_pl_free[i]) {
+			uint32_t bit = find_lsb_set(ack_pl_free[i]) - 1;
+
+			ack_pl_free[i] &= ~BIT(bit);
+			return i * 32 + bit;
+		}
 	}
 
-	for (size_t i = 0; i < CONFIG_ESB_PIPE_COUNT; i++) {
-		ack_pl_wrap_pipe[i] = 0;
+	return -1;
+}
+
+static void ack_pl_slot_free(uint8_t slot)
+{
+	ack_pl_free[slot / 32] |= BIT(slot % 32);
+}
+
+static struct esb_payload *ack_pl_front(uint32_t pipe)
+{
+	struct ack_pl_fifo *fifo = &ack_pl_fifos[pipe];
+
+	return fifo->count ? tx_fifo.payload[fifo->slot[fifo->front]] : NULL;
+}
+
+static void ack_pl_remove_front(uint32_t pipe)
+{
+	struct ack_pl_fifo *fifo = &ack_pl_fifos[pipe];
+
+	ack_pl_slot_free(fifo->slot[fifo->front]);
+	if (++fifo->front >= CONFIG_ESB_TX_FIFO_SIZE) {
+		fifo->front = 0;
 	}
+	fifo->count--;
 }
 
 static void tx_fifo_remove_last(void)
@@ -498,6 +569,27 @@ static void tx_fifo_remove_last(void)
 	irq_unlock(key);
 }
 
+static void stats_tx_success(const struct esb_payload *payload, uint32_t attempts)
+{
+#if defined(CONFIG_ESB_PIPE_STATS)
+	struct esb_pipe_stats *stats = &pipe_stats[payload->pipe];
+
+	stats->tx_success++;
+	stats->tx_bytes += payload->length;
+	stats->tx_retransmits += attempts - 1;
+#endif
+}
+
+static void stats_tx_failed(const struct esb_payload *payload, uint32_t attempts)
+{
+#if defined(CONFIG_ESB_PIPE_STATS)
+	struct esb_pipe_stats *stats = &pipe_stats[payload->pipe];
+
+	stats->tx_failed++;
+	stats->tx_retransmits += attempts - 1;
+#endif
+}
+
 /*  Function to push the content of the rx_buffer to the RX FIFO.
  *
  *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for
@@ -536,6 +628,11 @@ static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 	rx_fifo.payload[rx_fifo.back]->pid = pid;
 	rx_fifo.payload[rx_fifo.back]->noack = !(rx_payload_buffer[1] & 0x01);
 
+#if defined(CONFIG_ESB_PIPE_STATS)
+	pipe_stats[pipe].rx_packets++;
+	pipe_stats[pipe].rx_bytes += rx_fifo.payload[rx_fifo.back]->length;
+#endif
+
 	if (++rx_fifo.back >= CONFIG_ESB_RX_FIFO_SIZE) {
 		rx_fifo.back = 0;
 	}
@@ -588,6 +685,116 @@ static void ppi_init(void)
 							(1 << ppi_ch_timer_compare0_radio_disable) | (1 << ppi_ch_timer_compare1_radio_txen);
 }
 
+#if defined(CONFIG_ESB_BURST_TX)
+/* Prepare the next payload of the TX FIFO in the spare TX buffer. The payload can be chained
+ * if the radio configuration does not change, that is if it is sent on the same pipe and
+ * requires an ACK.
+ */
+static bool burst_tx_prepare(void)
+{
+	uint32_t next = tx_fifo.front + 1;
+	struct esb_payload *payload;
+
+	if (esb_cfg.protocol != ESB_PROTOCOL_ESB_DPL ||
+	    esb_cfg.tx_mode == ESB_TXMODE_MANUAL ||
+	    tx_fifo.count < 2) {
+		return false;
+	}
+
+	if (next >= CONFIG_ESB_TX_FIFO_SIZE) {
+		next = 0;
+	}
+
+	payload = tx_fifo.payload[next];
+	if (payload->pipe != current_payload->pipe ||
+	    (payload->noack && esb_cfg.selective_auto_ack)) {
+		return false;
+	}
+
+	burst_buffer[0] = payload->length;
+	burst_buffer[1] = (payload->pid << 1) | (payload->noack ? 0x00 : 0x01);
+	memcpy(&burst_buffer[2], payload->data, payload->length);
+	burst_payload = payload;
+	burst_armed = false;
+
+	return true;
+}
+
+/* PACKETPTR is latched when the ACK reception starts, on the READY event. From then on, it can
+ * be pointed to the spare TX buffer for the chained transmission, well before the DISABLED ->
+ * TXEN shortcut starts the ramp-up.
+ */
+static void burst_tx_arm(void)
+{
+	if (!burst_chained || burst_armed || esb_state != ESB_STATE_PTX_RX_ACK) {
+		return;
+	}
+
+	/* Too late if the ACK RX window has already ended */
+	if (burst_payload && !NRF_RADIO->EVENTS_DISABLED) {
+		NRF_RADIO->PACKETPTR = (uint32_t)burst_buffer;
+		burst_armed = true;
+	}
+}
+
+/* Check, once the ACK RX window has ended, that the transmission of the chained payload will
+ * use the spare TX buffer. If the buffer could not be armed on the READY event, it is only used
+ * if the radio is still ramping up.
+ */
+static bool burst_tx_in_time(void)
+{
+	if (burst_armed) {
+		return true;
+	}
+
+	if (!burst_payload) {
+		return false;
+	}
+
+	NRF_RADIO->PACKETPTR = (uint32_t)burst_buffer;
+
+	return NRF_RADIO->STATE == RADIO_STATE_STATE_TxRu;
+}
+
+/* The radio is ramping up to send the chained payload from the spare TX buffer */
+static void burst_tx_start(void)
+{
+	uint8_t *buffer = tx_payload_buffer;
+
+	tx_payload_buffer = burst_buffer;
+	burst_buffer = buffer;
+
+	NRF_RADIO->SHORTS = radio_shorts_common |
+			    RADIO_SHORTS_DISABLED_RXEN_Msk;
+
+	current_payload = burst_payload;
+	last_tx_attempts = 1;
+	retransmits_remaining = esb_cfg.retransmit_count;
+	on_radio_disabled = on_radio_disabled_tx;
+	esb_state = ESB_STATE_PTX_TX_ACK;
+
+#if defined(CONFIG_ESB_PIPE_STATS)
+	pipe_stats[current_payload->pipe].tx_chained++;
+#endif
+}
+
+/* Stop the ramp-up or the transmission of the chained payload when it must not be sent.
+ * The transaction continues with the given handler once the radio is disabled.
+ */
+static void burst_tx_abort(void (*next)(void))
+{
+	NRF_RADIO->SHORTS = radio_shorts_common;
+	on_radio_disabled = next;
+	NRF_RADIO->TASKS_DISABLE = 1;
+}
+
+/* Clear the chained payload, the TX FIFO has been changed by the application */
+static void burst_tx_invalidate(void)
+{
+	burst_payload = NULL;
+}
+#endif /* defined(CONFIG_ESB_BURST_TX) */
+
 static void start_tx_transaction(void)
 {
 	bool ack;
@@ -668,6 +875,7 @@ static void start_tx_transaction(void)
 static void on_radio_disabled_tx_noack(void)
 {
 	interrupt_flags |= INT_TX_SUCCESS_MSK;
+	stats_tx_success(current_payload, 1);
 	tx_fifo_remove_last();
 
 	if (tx_fifo.count == 0) {
@@ -711,6 +919,64 @@ static void on_radio_disabled_tx(void)
 	NRF_RADIO->PACKETPTR = (uint32_t)rx_payload_buffer;
 	on_radio_disabled = on_radio_disabled_tx_wait_for_ack;
 	esb_state = ESB_STATE_PTX_RX_ACK;
+
+#if defined(CONFIG_ESB_BURST_TX)
+	burst_chained = burst_tx_prepare();
+	if (burst_chained) {
+		/* Start the ramp-up for the next payload as soon as the radio is disabled after the
+		 * RX window. The ramp-up is stopped if the ACK is not received.
+		 */
+		NRF_RADIO->SHORTS = radio_shorts_common |
+				    RADIO_SHORTS_DISABLED_TXEN_Msk;
+	}
+#endif
+}
+
+/* Start the next transaction once the current payload is acknowledged */
+static void tx_next_transaction(void)
+{
+	if ((tx_fifo.count == 0) ||
+	    (esb_cfg.tx_mode == ESB_TXMODE_MANUAL)) {
+		esb_state = ESB_STATE_IDLE;
+		NVIC_SetPendingIRQ(ESB_EVT_IRQ);
+	} else {
+		NVIC_SetPendingIRQ(ESB_EVT_IRQ);
+		start_tx_transaction();
+	}
+}
+
+/* Retransmit the current payload when no ACK is received, or report the failure */
+static void tx_retransmit(void)
+{
+	if (retransmits_remaining-- == 0) {
+		ESB_SYS_TIMER->TASKS_SHUTDOWN = 1;
+
+		/* All retransmits are expended, and the TX operation is
+		 * suspended
+		 */
+		last_tx_attempts = esb_cfg.retransmit_count + 1;
+		interrupt_flags |= INT_TX_FAILED_MSK;
+		stats_tx_failed(current_payload, last_tx_attempts);
+
+		esb_state = ESB_STATE_IDLE;
+		NVIC_SetPendingIRQ(ESB_EVT_IRQ);
+	} else {
+		/* There are still more retransmits left, TX mode should
+		 * be entered again as soon as the system timer reaches
+		 * CC[1].
+		 */
+		NRF_RADIO->SHORTS = radio_shorts_common |
+				    RADIO_SHORTS_DISABLED_RXEN_Msk;
+		update_rf_payload_format(current_payload->length);
+		NRF_RADIO->PACKETPTR = (uint32_t)tx_payload_buffer;
+		on_radio_disabled = on_radio_disabled_tx;
+		esb_state = ESB_STATE_PTX_TX_ACK;
+		ESB_SYS_TIMER->TASKS_START = 1;
+		nrfx_gppi_channels_enable(1 << ppi_ch_timer_compare1_radio_txen);
+		if (ESB_SYS_TIMER->EVENTS_COMPARE[1]) {
+			NRF_RADIO->TASKS_TXEN = 1;
+		}
+	}
 }
 
 static void on_radio_disabled_tx_wait_for_ack(void)
@@ -722,6 +988,10 @@ static void on_radio_disabled_tx_wait_for_ack(void)
 	 */
 	nrfx_gppi_channels_disable(ppi_all_channels_mask);
 
+#if defined(CONFIG_ESB_BURST_TX)
+	bool burst_in_time = burst_chained && burst_tx_in_time();
+#endif
+
 	/* If the radio has received a packet and the CRC status is OK */
 	if (NRF_RADIO->EVENTS_END && NRF_RADIO->CRCSTATUS != 0) {
 		ESB_SYS_TIMER->TASKS_SHUTDOWN = 1;
@@ -729,6 +999,7 @@ static void on_radio_disabled_tx_wait_for_ack(void)
 		interrupt_flags |= INT_TX_SUCCESS_MSK;
 		last_tx_attempts = esb_cfg.retransmit_count -
 				   retransmits_remaining + 1;
+		stats_tx_success(current_payload, last_tx_attempts);
 
 		tx_fifo_remove_last();
 
@@ -741,43 +1012,34 @@ static void on_radio_disabled_tx_wait_for_ack(void)
 			}
 		}
 
-		if ((tx_fifo.count == 0) ||
-		    (esb_cfg.tx_mode == ESB_TXMODE_MANUAL)) {
-			esb_state = ESB_STATE_IDLE;
-			NVIC_SetPendingIRQ(ESB_EVT_IRQ);
-		} else {
-			NVIC_SetPendingIRQ(ESB_EVT_IRQ);
-			start_tx_transaction();
-		}
-	} else {
-		if (retransmits_remaining-- == 0) {
-			ESB_SYS_TIMER->TASKS_SHUTDOWN = 1;
-
-			/* All retransmits are expended, and the TX operation is
-			 * suspended
-			 */
-			last_tx_attempts = esb_cfg.retransmit_count + 1;
-			interrupt_flags |= INT_TX_FAILED_MSK;
+#if defined(CONFIG_ESB_BURST_TX)
+		if (burst_chained) {
+			burst_chained = false;
 
-			esb_state = ESB_STATE_IDLE;
-			NVIC_SetPendingIRQ(ESB_EVT_IRQ);
-		} else {
-			/* There are still more retransmits left, TX mode should
-			 * be entered again as soon as the system timer reaches
-			 * CC[1].
-			 */
-			NRF_RADIO->SHORTS = radio_shorts_common |
-					    RADIO_SHORTS_DISABLED_RXEN_Msk;
-			update_rf_payload_format(current_payload->length);
-			NRF_RADIO->PACKETPTR = (uint32_t)tx_payload_buffer;
-			on_radio_disabled = on_radio_disabled_tx;
-			esb_state = ESB_STATE_PTX_TX_ACK;
-			ESB_SYS_TIMER->TASKS_START = 1;
-			nrfx_gppi_channels_enable(1 << ppi_ch_timer_compare1_radio_txen);
-			if (ESB_SYS_TIMER->EVENTS_COMPARE[1]) {
-				NRF_RADIO->TASKS_TXEN = 1;
+			/* The chained payload must still be the next one of the FIFO */
+			if (burst_in_time && tx_fifo.count > 0 &&
+			    burst_payload == tx_fifo.payload[tx_fifo.front]) {
+				burst_tx_start();
+				NVIC_SetPendingIRQ(ESB_EVT_IRQ);
+				return;
 			}
+
+			burst_tx_abort(tx_next_transaction);
+			return;
+		}
+#endif
+
+		tx_next_transaction();
+	} else {
+#if defined(CONFIG_ESB_BURST_TX)
+		if (burst_chained) {
+			burst_chained = false;
+			burst_tx_abort(tx_retransmit);
+			return;
 		}
+#endif
+
+		tx_retransmit();
 	}
 }
 
@@ -805,20 +1067,16 @@ static void on_radio_disabled_rx_dpl(bool retransmit_payload,
 {
 	uint32_t pipe = NRF_RADIO->RXMATCH;
 
-	if (tx_fifo.count > 0 && ack_pl_wrap_pipe[pipe] != 0) {
-		current_payload = ack_pl_wrap_pipe[pipe]->p_payload;
+	if (ack_pl_fifos[pipe].count > 0) {
+		current_payload = ack_pl_front(pipe);
 
 		/* Pipe stays in ACK with payload until TX FIFO is empty */
 		/* Do not report TX success on first ack payload or retransmit */
 		if (pipe_info->ack_payload == true && !retransmit_payload) {
-			ack_pl_wrap_pipe[pipe]->in_use = false;
-			ack_pl_wrap_pipe[pipe] = ack_pl_wrap_pipe[pipe]->p_next;
+			stats_tx_success(current_payload, 1);
+			ack_pl_remove_front(pipe);
 			tx_fifo.count--;
-			if (tx_fifo.count > 0 && ack_pl_wrap_pipe[pipe] != 0) {
-				current_payload = ack_pl_wrap_pipe[pipe]->p_payload;
-			} else {
-				current_payload = 0;
-			}
+			current_payload = ack_pl_front(pipe);
 
 			/* ACK payloads also require TX_DS */
 			/* (page 40 of the 'nRF24LE1_Product_Specification_rev1_6.pdf') */
@@ -945,6 +1203,9 @@ static void radio_irq_handler(void)
 	    (NRF_RADIO->INTENSET & RADIO_INTENSET_READY_Msk)) {
 		NRF_RADIO->EVENTS_READY = 0;
 		ESB_SYS_TIMER->TASKS_START;
+#if defined(CONFIG_ESB_BURST_TX)
+		burst_tx_arm();
+#endif
 	}
 
 	if (NRF_RADIO->EVENTS_END &&
@@ -1038,6 +1299,9 @@ int esb_init(const struct esb_config *config)
 
 	memset(rx_pipe_info, 0, sizeof(rx_pipe_info));
 	memset(pids, 0, sizeof(pids));
+#if defined(CONFIG_ESB_PIPE_STATS)
+	memset(pipe_stats, 0, sizeof(pipe_stats));
+#endif
 
 	update_radio_parameters();
 
@@ -1097,6 +1361,11 @@ void esb_disable(void)
 
 	esb_state = ESB_STATE_IDLE;
 	esb_initialized = false;
+#if defined(CONFIG_ESB_BURST_TX)
+	burst_chained = false;
+	burst_armed = false;
+	burst_tx_invalidate();
+#endif
 
 	reset_fifos();
 
@@ -1118,15 +1387,6 @@ bool esb_is_idle(void)
 	return (esb_state == ESB_STATE_IDLE);
 }
 
-static struct payload_wrap *find_free_payload_cont(void)
-{
-	for (int i = 0; i < CONFIG_ESB_TX_FIFO_SIZE; i++) {
-		if (!ack_pl_wrap[i].in_use)
-			return &ack_pl_wrap[i];
-	}
-	return 0;
-}
-
 int esb_write_payload(const struct esb_payload *payload)
 {
 	if (!esb_initialized) {
@@ -1149,6 +1409,9 @@ int esb_write_payload(const struct esb_payload *payload)
 	}
 
 	uint32_t key = irq_lock();
+#if defined(CONFIG_ESB_IRQ_LOCK_STATS)
+	uint32_t lock_start = k_cycle_get_32();
+#endif
 
 	if (esb_cfg.mode == ESB_MODE_PTX) {
 		memcpy(tx_fifo.payload[tx_fifo.back], payload,
@@ -1163,30 +1426,31 @@ int esb_write_payload(const struct esb_payload *payload)
 
 		tx_fifo.count++;
 	} else {
-		struct payload_wrap *new_ack_payload = find_free_payload_cont();
+		struct ack_pl_fifo *fifo = &ack_pl_fifos[payload->pipe];
+		int slot = ack_pl_slot_alloc();
 
-		if (new_ack_payload != 0) {
-			new_ack_payload->in_use = true;
-			new_ack_payload->p_next = 0;
-			memcpy(new_ack_payload->p_payload, payload, sizeof(struct esb_payload));
+		if (slot >= 0) {
+			struct esb_payload *ack_payload = tx_fifo.payload[slot];
+			uint32_t back = fifo->front + fifo->count;
 
-			pids[payload->pipe] = (pids[payload->pipe] + 1) % (PID_MAX + 1);
-			new_ack_payload->p_payload->pid = pids[payload->pipe];
+			memcpy(ack_payload, payload, sizeof(struct esb_payload));
 
-			if (ack_pl_wrap_pipe[payload->pipe] == 0) {
-				ack_pl_wrap_pipe[payload->pipe] = new_ack_payload;
-			} else {
-				struct payload_wrap *pl = ack_pl_wrap_pipe[payload->pipe];
+			pids[payload->pipe] = (pids[payload->pipe] + 1) % (PID_MAX + 1);
+			ack_payload->pid = pids[payload->pipe];
 
-				while (pl->p_next != 0) {
-					pl = (struct payload_wrap *)pl->p_next;
-				}
-				pl->p_next = (struct payload_wrap *)new_ack_payload;
+			if (back >= CONFIG_ESB_TX_FIFO_SIZE) {
+				back -= CONFIG_ESB_TX_FIFO_SIZE;
 			}
+
+			fifo->slot[back] = slot;
+			fifo->count++;
 			tx_fifo.count++;
 		}
 	}
 
+#if defined(CONFIG_ESB_IRQ_LOCK_STATS)
+	irq_lock_cycles_max = MAX(irq_lock_cycles_max, k_cycle_get_32() - lock_start);
+#endif
 	irq_unlock(key);
 
 	if (esb_cfg.mode == ESB_MODE_PTX &&
@@ -1310,6 +1574,12 @@ int esb_flush_tx(void)
 	tx_fifo.back = 0;
 	tx_fifo.front = 0;
 
+	reset_ack_pl_fifos();
+
+#if defined(CONFIG_ESB_BURST_TX)
+	burst_tx_invalidate();
+#endif
+
 	irq_unlock(key);
 
 	return 0;
@@ -1331,6 +1601,10 @@ int esb_pop_tx(void)
 	}
 	tx_fifo.count--;
 
+#if defined(CONFIG_ESB_BURST_TX)
+	burst_tx_invalidate();
+#endif
+
 	irq_unlock(key);
 
 	return 0;
@@ -1543,3 +1817,57 @@ int esb_reuse_pid(uint8_t pipe)
 
 	return 0;
 }
+
+int esb_irq_lock_time_get(uint32_t *time_ns)
+{
+#if defined(CONFIG_ESB_IRQ_LOCK_STATS)
+	if (time_ns == NULL) {
+		return -EINVAL;
+	}
+
+	uint32_t key = irq_lock();
+
+	*time_ns = k_cyc_to_ns_ceil32(irq_lock_cycles_max);
+	irq_lock_cycles_max = 0;
+
+	irq_unlock(key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int esb_pipe_stats_get(uint8_t pipe, struct esb_pipe_stats *stats)
+{
+#if defined(CONFIG_ESB_PIPE_STATS)
+	if (stats == NULL || pipe >= CONFIG_ESB_PIPE_COUNT) {
+		return -EINVAL;
+	}
+
+	uint32_t key = irq_lock();
+
+	*stats = pipe_stats[pipe];
+
+	irq_unlock(key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int esb_pipe_stats_reset(void)
+{
+#if defined(CONFIG_ESB_PIPE_STATS)
+	uint32_t key = irq_lock();
+
+	memset(pipe_stats, 0, sizeof(pipe_stats));
+
+	irq_unlock(key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
@@ -35,6 +35,10 @@ int url_parse_host(const char *url, char *host, size_t len);
 int http_parse(struct download_client *client, size_t len);
 int http_get_request_send(struct download_client *client);
 
+void journal_start(struct download_client *client, size_t from);
+void journal_fragment(struct download_client *client, const void *buf, size_t len);
+void journal_done(struct download_client *client);
+
 int coap_block_init(struct download_client *client, size_t from);
 int coap_get_recv_timeout(struct download_client *dl);
 int coap_initiate_retransmission(struct download_client *dl);
@@ -333,7 +337,8 @@ cleanup:
 	return err;
 }
 
-int socket_send(const struct download_client *client, size_t len, int timeout)
+int socket_send(const struct download_client *client, const char *buf, size_t len,
+		int timeout)
 {
 	int err;
 	int sent;
@@ -345,7 +350,7 @@ int socket_send(const struct download_client *client, size_t len, int timeout)
 	}
 
 	while (len) {
-		sent = send(client->fd, client->buf + off, len, 0);
+		sent = send(client->fd, buf + off, len, 0);
 		if (sent < 0) {
 			return -errno;
 		}
@@ -357,8 +362,77 @@ int socket_send(const struct download_client *client, size_t len, int timeout)
 	return 0;
 }
 
+void stats_http_request_sent(struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	uint8_t idx;
+
+	client->stats.stats.requests++;
+
+	if (client->stats.req_cnt == ARRAY_SIZE(client->stats.req_time)) {
+		/* Not expected, drop the oldest request */
+		client->stats.req_head = (client->stats.req_head + 1) %
+					 ARRAY_SIZE(client->stats.req_time);
+		client->stats.req_cnt--;
+	}
+
+	idx = (client->stats.req_head + client->stats.req_cnt) %
+	      ARRAY_SIZE(client->stats.req_time);
+	client->stats.req_time[idx] = k_uptime_get();
+	client->stats.req_cnt++;
+#endif
+}
+
+void stats_http_response_received(struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	uint32_t rtt;
+
+	if (client->stats.req_cnt == 0) {
+		return;
+	}
+
+	/* Responses arrive in the order of the requests */
+	rtt = k_uptime_get() - client->stats.req_time[client->stats.req_head];
+	client->stats.req_head = (client->stats.req_head + 1) %
+				 ARRAY_SIZE(client->stats.req_time);
+	client->stats.req_cnt--;
+
+	client->stats.stats.rtt_min_ms = MIN(client->stats.stats.rtt_min_ms, rtt);
+	client->stats.stats.rtt_max_ms = MAX(client->stats.stats.rtt_max_ms, rtt);
+	client->stats.rtt_sum += rtt;
+	client->stats.rtt_cnt++;
+#endif
+}
+
+static void stats_reset(struct download_client *client, size_t from)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	memset(&client->stats, 0, sizeof(client->stats));
+	client->stats.stats.rtt_min_ms = UINT32_MAX;
+	client->stats.start = k_uptime_get();
+	client->stats.from = from;
+#endif
+}
+
+/* Requests in flight are lost when the connection is closed, request again from the progress */
+static void pipeline_reset(struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+	client->http.in_flight = 0;
+	client->http.next_req = client->progress;
+	client->http.carry = 0;
+#endif
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	client->stats.req_head = 0;
+	client->stats.req_cnt = 0;
+#endif
+}
+
 static int request_send(struct download_client *dl)
 {
+	int err;
+
 	switch (dl->proto) {
 	case IPPROTO_TCP:
 	case IPPROTO_TLS_1_2:
@@ -366,7 +440,13 @@ static int request_send(struct download_client *dl)
 	case IPPROTO_UDP:
 	case IPPROTO_DTLS_1_2:
 		if (IS_ENABLED(CONFIG_COAP)) {
-			return coap_request_send(dl);
+			err = coap_request_send(dl);
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+			if (!err) {
+				dl->stats.stats.requests++;
+			}
+#endif
+			return err;
 		}
 	}
 
@@ -417,6 +497,12 @@ static int reconnect(struct download_client *dl)
 		return err;
 	}
 
+	pipeline_reset(dl);
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	dl->stats.stats.reconnects++;
+#endif
+
 	return 0;
 }
 
@@ -449,6 +535,18 @@ static size_t socket_recv(struct download_client *dl)
 		return -1;
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+	/* Hand out what was received of the next response with the last fragment */
+	if (dl->http.carry) {
+		size_t len = dl->http.carry;
+
+		memmove(dl->buf + dl->offset, dl->buf + dl->http.content_len, len);
+		dl->http.carry = 0;
+
+		return len;
+	}
+#endif
+
 	return recv(dl->fd, dl->buf + dl->offset, sizeof(dl->buf) - dl->offset, 0);
 }
 
@@ -517,6 +615,10 @@ wait_for_download:
 					LOG_INF("Fragment refused, download stopped.");
 					break;
 				}
+
+				if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_JOURNAL)) {
+					journal_fragment(dl, dl->buf, dl->offset);
+				}
 			}
 
 			error_cause = ECONNRESET;
@@ -575,10 +677,11 @@ wait_for_download:
 		}
 
 		if (rc < 0) {
-			/* Something was wrong with the packet
+			/* Something was wrong with the packet,
+			 * or the resource has changed on the server.
 			 * Restart and suspend
 			 */
-			error_evt_send(dl, EBADMSG);
+			error_evt_send(dl, rc == -ESTALE ? ESTALE : EBADMSG);
 			break;
 		}
 
@@ -600,8 +703,18 @@ wait_for_download:
 			break;
 		}
 
+		if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_JOURNAL)) {
+			journal_fragment(dl, dl->buf, dl->offset);
+		}
+
 		if (dl->progress == dl->file_size) {
 			LOG_INF("Download complete");
+			if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_JOURNAL)) {
+				journal_done(dl);
+			}
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+			dl->stats.end = k_uptime_get();
+#endif
 			const struct download_client_evt evt = {
 				.id = DOWNLOAD_CLIENT_EVT_DONE,
 			};
@@ -758,6 +871,13 @@ int download_client_start(struct download_client *client, const char *file,
 	client->offset = 0;
 	client->http.has_header = false;
 
+	pipeline_reset(client);
+	stats_reset(client, from);
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_JOURNAL)) {
+		journal_start(client, from);
+	}
+
 	if (client->proto == IPPROTO_UDP || client->proto == IPPROTO_DTLS_1_2) {
 		if (IS_ENABLED(CONFIG_COAP)) {
 			coap_block_init(client, from);
@@ -797,3 +917,33 @@ int download_client_file_size_get(struct download_client *client, size_t *size)
 
 	return 0;
 }
+
+int download_client_stats_get(struct download_client *client,
+			      struct download_client_stats *stats)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_STATS)
+	int64_t end;
+
+	if (!client || !stats) {
+		return -EINVAL;
+	}
+
+	end = client->stats.end ? client->stats.end : k_uptime_get();
+
+	*stats = client->stats.stats;
+	stats->bytes = client->progress - client->stats.from;
+	stats->duration_ms = end - client->stats.start;
+	stats->throughput = stats->duration_ms ?
+			    ((uint64_t)stats->bytes * MSEC_PER_SEC) / stats->duration_ms : 0;
+
+	if (client->stats.rtt_cnt) {
+		stats->rtt_avg_ms = client->stats.rtt_sum / client->stats.rtt_cnt;
+	} else {
+		stats->rtt_min_ms = 0;
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
@@ -42,9 +42,31 @@ LOG_MODULE_DECLARE(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 
 int url_parse_host(const char *url, char *host, size_t len);
 int url_parse_file(const char *url, char *file, size_t len);
-int socket_send(const struct download_client *client, size_t len, int timeout);
+int socket_send(const struct download_client *client, const char *buf, size_t len,
+		int timeout);
+void stats_http_request_sent(struct download_client *client);
+void stats_http_response_received(struct download_client *client);
+int journal_response_check(struct download_client *client, const char *etag);
 
-int http_get_request_send(struct download_client *client)
+static size_t frag_size_get(const struct download_client *client)
+{
+	return client->config.frag_size_override ? client->config.frag_size_override
+						 : CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE;
+}
+
+/* Range requests are pipelined when each fragment is requested with a range */
+static bool http_pipelined(const struct download_client *client)
+{
+	return IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE) &&
+	       (client->proto == IPPROTO_TLS_1_2 ||
+		IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS));
+}
+
+/* Send a request for the fragment starting at offset `from`.
+ * The offset of the last byte requested is returned in `last`, if a range was requested.
+ */
+static int http_request_send(struct download_client *client, size_t from, char *buf,
+			     size_t buf_size, size_t *last)
 {
 	int err;
 	int len;
@@ -66,12 +88,7 @@ int http_get_request_send(struct download_client *client)
 	}
 
 	/* Offset of last byte in range (Content-Range) */
-	if (client->config.frag_size_override) {
-		off = client->progress + client->config.frag_size_override - 1;
-	} else {
-		off = client->progress +
-			CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE - 1;
-	}
+	off = from + frag_size_get(client) - 1;
 
 	if (client->file_size != 0) {
 		/* Don't request bytes past the end of file */
@@ -80,41 +97,108 @@ int http_get_request_send(struct download_client *client)
 
 	if (client->proto == IPPROTO_TLS_1_2
 	   || IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS)) {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
-			HTTP_GET_RANGE, file, host, client->progress, off);
-	} else if (client->progress) {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
-			HTTP_GET_OFFSET, file, host, client->progress);
+		len = snprintf(buf, buf_size,
+			HTTP_GET_RANGE, file, host, from, off);
+		if (last) {
+			*last = off;
+		}
+	} else if (from) {
+		len = snprintf(buf, buf_size,
+			HTTP_GET_OFFSET, file, host, from);
 	} else {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
+		len = snprintf(buf, buf_size,
 			HTTP_GET, file, host);
 	}
 
-	if (len < 0 || len > CONFIG_DOWNLOAD_CLIENT_BUF_SIZE) {
+	if (len < 0 || len > buf_size) {
 		LOG_ERR("Cannot create GET request, buffer too small");
 		return -ENOMEM;
 	}
 
 	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(client->buf, len, "HTTP request");
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
 	}
 
-	err = socket_send(client, len, 0);
+	err = socket_send(client, buf, len, 0);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
 	}
 
+	stats_http_request_sent(client);
+
+	return 0;
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+/* Send range requests until the pipeline is full or the whole file has been requested.
+ * Only one request is sent until the file size is known.
+ */
+static int http_pipeline_fill(struct download_client *client)
+{
+	int err;
+	size_t last;
+	const uint8_t depth = client->file_size ? CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH : 1;
+
+	while (client->http.in_flight < depth &&
+	       (client->file_size == 0 || client->http.next_req < client->file_size)) {
+		err = http_request_send(client, client->http.next_req, client->http.req_buf,
+					sizeof(client->http.req_buf), &last);
+		if (err) {
+			return err;
+		}
+
+		client->http.next_req = last + 1;
+		client->http.in_flight++;
+	}
+
 	return 0;
 }
+#endif
+
+int http_get_request_send(struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+	if (http_pipelined(client)) {
+		return http_pipeline_fill(client);
+	}
+#endif
+
+	return http_request_send(client, client->progress, client->buf, sizeof(client->buf),
+				 NULL);
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+/* Copy the value of the ETag header, or an empty string if there is none.
+ * The header has been converted to lowercase, which is fine to compare ETags
+ * of the same server.
+ */
+static void http_etag_parse(const struct download_client *client, size_t hdr_len,
+			    char *etag, size_t len)
+{
+	const char *p;
+	size_t i = 0;
+
+	p = strstr(client->buf, "\r\netag:");
+	if (p && p < client->buf + hdr_len) {
+		p += strlen("\r\netag:");
+		while (*p == ' ') {
+			p++;
+		}
+		while (i < len - 1 && *p != '\r') {
+			etag[i++] = *p++;
+		}
+	}
+
+	etag[i] = '\0';
+}
+#endif
 
 /* Returns:
  *  1 while the header is being received
  *  0 if the header has been fully received
  * -1 on error
+ * -ESTALE if the resource has changed since the download was journaled
  */
 static int http_header_parse(struct download_client *client, size_t *hdr_len)
 {
@@ -128,8 +212,9 @@ static int http_header_parse(struct download_client *client, size_t *hdr_len)
 
 	const unsigned int expected_status = using_range_requests ? 206 : 200;
 
+	/* The buffer can hold stale bytes after the offset, from a previous response */
 	p = strstr(client->buf, "\r\n\r\n");
-	if (!p || p > client->buf + client->offset) {
+	if (!p || p + strlen("\r\n\r\n") > client->buf + client->offset) {
 		/* Waiting full HTTP header */
 		LOG_DBG("Waiting full header in response");
 		return 1;
@@ -221,21 +306,141 @@ static int http_header_parse(struct download_client *client, size_t *hdr_len)
 		client->http.connection_close = true;
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+	char etag[CONFIG_DOWNLOAD_CLIENT_JOURNAL_ETAG_SIZE];
+	int err;
+
+	http_etag_parse(client, *hdr_len, etag, sizeof(etag));
+
+	err = journal_response_check(client, etag);
+	if (err) {
+		return err;
+	}
+#endif
+
 	client->http.has_header = true;
 
+	stats_http_response_received(client);
+
+	return 0;
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+/* Get the payload size of a range response from "Content-Range: bytes <first>-<last>/<size>" */
+static int http_content_range_parse(struct download_client *client, size_t *content_len)
+{
+	char *p;
+	char *q;
+	size_t first;
+	size_t last;
+
+	p = strstr(client->buf, "content-range");
+	if (p) {
+		p = strstr(p, "bytes ");
+	}
+	if (!p) {
+		LOG_ERR("Server did not send \"Content-Range\" in response");
+		return -1;
+	}
+	p += strlen("bytes ");
+
+	first = strtoul(p, &q, 10);
+	if (*q != '-') {
+		LOG_ERR("Malformed \"Content-Range\" in response");
+		return -1;
+	}
+
+	last = strtoul(q + 1, &q, 10);
+	if (*q != '/' || last < first) {
+		LOG_ERR("Malformed \"Content-Range\" in response");
+		return -1;
+	}
+
+	/* Responses arrive in the order of the requests */
+	if (first != client->progress) {
+		LOG_ERR("Unexpected range %u-%u, expected offset %u", first, last,
+			client->progress);
+		return -1;
+	}
+
+	*content_len = last - first + 1;
+
+	return 0;
+}
+
+/* Parse the response to a pipelined range request.
+ * The buffer can contain the beginning of the next response after the fragment,
+ * those bytes are kept for the next fragment.
+ */
+static int http_pipeline_parse(struct download_client *client, size_t len)
+{
+	int rc;
+	size_t hdr_len;
+	size_t prev = client->http.has_header ? client->offset : 0;
+
+	client->offset += len;
+
+	if (!client->http.has_header) {
+		rc = http_header_parse(client, &hdr_len);
+		if (rc > 0) {
+			/* Wait for header */
+			return 1;
+		}
+		if (rc < 0) {
+			return rc;
+		}
+
+		rc = http_content_range_parse(client, &client->http.content_len);
+		if (rc) {
+			return -1;
+		}
+
+		memmove(client->buf, client->buf + hdr_len, client->offset - hdr_len);
+		client->offset -= hdr_len;
+
+		/* The file size is known now, keep the pipeline full
+		 * while the payload is being received.
+		 */
+		rc = http_pipeline_fill(client);
+		if (rc) {
+			LOG_WRN("Failed to send range request, err %d", rc);
+		}
+	}
+
+	if (client->offset > client->http.content_len) {
+		client->http.carry = client->offset - client->http.content_len;
+		client->offset = client->http.content_len;
+	}
+
+	client->progress += client->offset - prev;
+
+	if (client->offset < client->http.content_len) {
+		return 1;
+	}
+
+	client->http.in_flight--;
+
 	return 0;
 }
+#endif /* CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE */
 
 /* Returns:
  *  1 if more data is expected
  *  0 if a whole fragment has been received
  * -1 on error
+ * -ESTALE if the resource has changed since the download was journaled
  */
 int http_parse(struct download_client *client, size_t len)
 {
 	int rc;
 	size_t hdr_len;
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE)
+	if (http_pipelined(client)) {
+		return http_pipeline_parse(client, len);
+	}
+#endif
+
 	/* Accumulate buffer offset */
 	client->offset += len;
 
@@ -247,7 +452,7 @@ int http_parse(struct download_client *client, size_t len)
 		}
 		if (rc < 0) {
 			/* Something is wrong with the header */
-			return -1;
+			return rc;
 		}
 
 		if (client->offset != hdr_len) {
@@ -280,9 +485,7 @@ int http_parse(struct download_client *client, size_t len)
 
 	/* Have we received a whole fragment or the whole file? */
 	if (client->progress != client->file_size &&
-	    client->offset < (client->config.frag_size_override != 0 ?
-			      client->config.frag_size_override :
-			      CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE)) {
+	    client->offset < frag_size_get(client)) {
 		return 1;
 	}
 
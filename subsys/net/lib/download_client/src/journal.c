@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/logging/log.h>
+#include <net/download_client.h>
+
+LOG_MODULE_DECLARE(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
+
+#define SETTINGS_NAME "dl_client"
+#define SETTINGS_KEY_JOURNAL "journal"
+#define SETTINGS_FULL_JOURNAL SETTINGS_NAME "/" SETTINGS_KEY_JOURNAL
+
+/* Bytes read at once when verifying a journal */
+#define VERIFY_CHUNK_SIZE 64
+
+static struct download_client_journal stored;
+/* Last journal verified against the data of the application */
+static struct download_client_journal verified;
+
+static int journal_settings_set(const char *key, size_t len_rd,
+				settings_read_cb read_cb, void *cb_arg)
+{
+	ssize_t len;
+
+	if (strcmp(key, SETTINGS_KEY_JOURNAL)) {
+		return -ENOENT;
+	}
+
+	/* The layout depends on the configuration, ignore journals of other builds */
+	if (len_rd != sizeof(stored)) {
+		LOG_WRN("Ignoring journal of unexpected size %u", len_rd);
+		return 0;
+	}
+
+	len = read_cb(cb_arg, &stored, sizeof(stored));
+	if (len != sizeof(stored)) {
+		LOG_ERR("Failed to read journal, err %d", len);
+		memset(&stored, 0, sizeof(stored));
+		return len < 0 ? len : -EIO;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(download_client, SETTINGS_NAME, NULL,
+			       journal_settings_set, NULL, NULL);
+
+static int journal_load(void)
+{
+	int err;
+
+	/* A deleted journal is not passed to the handler */
+	memset(&stored, 0, sizeof(stored));
+
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("Failed to initialize settings, err %d", err);
+		return err;
+	}
+
+	err = settings_load_subtree(SETTINGS_NAME);
+	if (err) {
+		LOG_ERR("Failed to load journal, err %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+static uint32_t url_hash(const char *host, const char *file)
+{
+	uint32_t hash;
+
+	hash = crc32_ieee((const uint8_t *)host, strlen(host));
+	hash = crc32_ieee_update(hash, (const uint8_t *)"/", 1);
+
+	return crc32_ieee_update(hash, (const uint8_t *)file, strlen(file));
+}
+
+static int journal_save(struct download_client *client)
+{
+	int err;
+
+	err = settings_save_one(SETTINGS_FULL_JOURNAL, &client->journal.entry,
+				sizeof(client->journal.entry));
+	if (err) {
+		/* Not critical, the download resumes from an older offset */
+		LOG_WRN("Failed to save journal, err %d", err);
+		return err;
+	}
+
+	client->journal.saved = client->journal.entry.offset;
+
+	return 0;
+}
+
+static bool journal_is_verified(void)
+{
+	return stored.url_hash == verified.url_hash &&
+	       stored.file_size == verified.file_size &&
+	       stored.offset == verified.offset &&
+	       stored.crc_offset == verified.crc_offset &&
+	       stored.crc == verified.crc &&
+	       !strncmp(stored.etag, verified.etag, sizeof(stored.etag));
+}
+
+/* Pick up the journal of a previous download of the same resource, if any.
+ * It is kept until the first fragment is accepted, so that it can be checked
+ * against the server even when the download is started from the beginning.
+ * A download is only resumed on a journal that matches the data of the application.
+ */
+void journal_start(struct download_client *client, size_t from)
+{
+	struct download_client_journal *entry = &client->journal.entry;
+	uint32_t hash;
+	bool found;
+
+	if (!client->config.journal) {
+		return;
+	}
+
+	hash = url_hash(client->host, client->file);
+	found = journal_load() == 0 && stored.url_hash == hash;
+
+	if (found && from != 0 && !journal_is_verified()) {
+		LOG_WRN("Journal has not been verified, ignoring it");
+		found = false;
+	}
+
+	if (found) {
+		LOG_INF("Journal found, %u bytes of %u", stored.offset, stored.file_size);
+		*entry = stored;
+	} else {
+		memset(entry, 0, sizeof(*entry));
+		entry->url_hash = hash;
+		entry->offset = from;
+		entry->crc_offset = from;
+	}
+
+	client->journal.saved = entry->offset;
+}
+
+/* Check the ETag and file size of a response against the journal.
+ * A change is only an error if data of the old resource may have been used,
+ * that is, when the download is resumed or already in progress.
+ */
+int journal_response_check(struct download_client *client, const char *etag)
+{
+	struct download_client_journal *entry = &client->journal.entry;
+
+	if (!client->config.journal) {
+		return 0;
+	}
+
+	if (entry->file_size == 0) {
+		strncpy(entry->etag, etag, sizeof(entry->etag) - 1);
+		entry->file_size = client->file_size;
+		return 0;
+	}
+
+	if (!strncmp(entry->etag, etag, sizeof(entry->etag) - 1) &&
+	    entry->file_size == client->file_size) {
+		return 0;
+	}
+
+	if (client->progress == 0) {
+		LOG_INF("Resource has changed, discarding journal");
+		memset(entry, 0, sizeof(*entry));
+		entry->url_hash = url_hash(client->host, client->file);
+		strncpy(entry->etag, etag, sizeof(entry->etag) - 1);
+		entry->file_size = client->file_size;
+		client->journal.saved = 0;
+		return 0;
+	}
+
+	LOG_ERR("Resource has changed on the server (ETag \"%s\", size %u)",
+		etag, client->file_size);
+
+	(void)download_client_journal_clear();
+	memset(entry, 0, sizeof(*entry));
+
+	return -ESTALE;
+}
+
+/* Account a fragment accepted by the application */
+void journal_fragment(struct download_client *client, const void *buf, size_t len)
+{
+	struct download_client_journal *entry = &client->journal.entry;
+	const size_t from = client->progress - len;
+
+	if (!client->config.journal) {
+		return;
+	}
+
+	/* The running hash can only continue from where it stopped */
+	if (entry->offset != from) {
+		entry->offset = from;
+		entry->crc_offset = from;
+		entry->crc = 0;
+	}
+
+	entry->crc = crc32_ieee_update(entry->crc, buf, len);
+	entry->offset += len;
+
+	if (entry->offset < client->journal.saved ||
+	    entry->offset - client->journal.saved >= CONFIG_DOWNLOAD_CLIENT_JOURNAL_SAVE_INTERVAL) {
+		(void)journal_save(client);
+	}
+}
+
+void journal_done(struct download_client *client)
+{
+	if (!client->config.journal) {
+		return;
+	}
+
+	(void)download_client_journal_clear();
+	memset(&client->journal, 0, sizeof(client->journal));
+}
+
+int download_client_journal_get(const char *host, const char *file,
+				struct download_client_journal *journal)
+{
+	int err;
+
+	if (!host || !file || !journal) {
+		return -EINVAL;
+	}
+
+	err = journal_load();
+	if (err) {
+		return err;
+	}
+
+	if (stored.url_hash != url_hash(host, file) || stored.offset == 0) {
+		return -ENOENT;
+	}
+
+	*journal = stored;
+
+	return 0;
+}
+
+int download_client_journal_verify(const struct download_client_journal *journal,
+				   download_client_journal_read_t read, void *user_data)
+{
+	uint8_t buf[VERIFY_CHUNK_SIZE];
+	uint32_t crc = 0;
+	size_t offset;
+	size_t len;
+	int err;
+
+	if (!journal || journal->crc_offset > journal->offset) {
+		return -EINVAL;
+	}
+
+	/* Data that cannot be read back is only checked against the server */
+	if (!read) {
+		verified = *journal;
+		return 0;
+	}
+
+	for (offset = journal->crc_offset; offset < journal->offset; offset += len) {
+		len = MIN(sizeof(buf), journal->offset - offset);
+
+		err = read(offset, buf, len, user_data);
+		if (err) {
+			LOG_ERR("Failed to read back %u bytes at %u, err %d", len, offset, err);
+			return err;
+		}
+
+		crc = crc32_ieee_update(crc, buf, len);
+	}
+
+	if (crc != journal->crc) {
+		LOG_ERR("Data does not match the journal, discarding it");
+		(void)download_client_journal_clear();
+		return -EBADMSG;
+	}
+
+	verified = *journal;
+
+	return 0;
+}
+
+int download_client_journal_clear(void)
+{
+	int err;
+
+	memset(&verified, 0, sizeof(verified));
+
+	/* The journal can be cleared before it has ever been loaded */
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("Failed to initialize settings, err %d", err);
+		return err;
+	}
+
+	err = settings_delete(SETTINGS_FULL_JOURNAL);
+	if (err) {
+		LOG_ERR("Failed to delete journal, err %d", err);
+		return err;
+	}
+
+	return 0;
+}
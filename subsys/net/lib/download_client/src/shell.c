@@ -173,6 +173,27 @@ static int cmd_dc_disconnect(const struct shell *shell, size_t argc,
 	return download_client_disconnect(&downloader);
 }
 
+static int cmd_dc_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	int err;
+	struct download_client_stats stats;
+
+	err = download_client_stats_get(&downloader, &stats);
+	if (err) {
+		shell_error(shell, "Failed to get statistics, err %d", err);
+		return err;
+	}
+
+	shell_print(shell, "%u bytes in %u ms (%u B/s)",
+		    stats.bytes, stats.duration_ms, stats.throughput);
+	shell_print(shell, "requests: %u, reconnects: %u",
+		    stats.requests, stats.reconnects);
+	shell_print(shell, "response time min/avg/max: %u/%u/%u ms",
+		    stats.rtt_min_ms, stats.rtt_avg_ms, stats.rtt_max_ms);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_config,
 	SHELL_CMD(pdn_id, NULL, "Set PDN ID", cmd_dc_config_pdn_id),
 	SHELL_CMD(sec_tag, NULL, "Set security tag", cmd_dc_config_sec_tag),
@@ -187,6 +208,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_dc,
 	SHELL_CMD(download, NULL, "Download a file", cmd_dc_download),
 	SHELL_CMD(pause, NULL, "Pause download", cmd_dc_pause),
 	SHELL_CMD(resume, NULL, "Resume download", cmd_dc_resume),
+	SHELL_CMD(stats, NULL, "Show download statistics", cmd_dc_stats),
 	SHELL_SUBCMD_SET_END
 );
 
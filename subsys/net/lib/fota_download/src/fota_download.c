@@ -24,6 +24,10 @@
 #include <dfu/dfu_target_mcuboot.h>
 #endif
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL) && defined(CONFIG_DFU_TARGET_MCUBOOT)
+#include <zephyr/storage/flash_map.h>
+#endif
+
 /* If bootloader upgrades are supported we need room for two file strings. */
 #ifdef PM_S1_ADDRESS
 /* One file string for each of s0 and s1, and a space separator */
@@ -239,6 +243,10 @@ static int download_client_callback(const struct download_client_evt *event)
 			 */
 		} else {
 			download_client_disconnect(&dlc);
+			if (event->error == -ESTALE) {
+				LOG_ERR("Image has changed on the server since "
+					"the download was interrupted");
+			}
 			LOG_ERR("Download client error");
 			err = dfu_target_done(false);
 			if (err == -EACCES) {
@@ -260,6 +268,63 @@ static int download_client_callback(const struct download_client_evt *event)
 	return 0;
 }
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+#if defined(CONFIG_DFU_TARGET_MCUBOOT)
+static int journal_read(size_t offset, void *buf, size_t len, void *user_data)
+{
+	const struct flash_area *fa = user_data;
+
+	return flash_area_read(fa, offset, buf, len);
+}
+#endif
+
+/* Verify the journal of the download against the image stored so far,
+ * so that the download client checks the image on the server when resuming.
+ * Returns -EBADMSG if the stored image does not match the journal.
+ */
+static int journal_verify(size_t offset)
+{
+	struct download_client_journal journal;
+	int err;
+
+	err = download_client_journal_get(dlc.host, dlc.file, &journal);
+	if (err) {
+		return 0;
+	}
+
+	if (journal.offset > offset) {
+		/* Some of the data in the journal did not make it to flash */
+		LOG_WRN("Journal is ahead of the stored image, ignoring it");
+		return 0;
+	}
+
+#if defined(CONFIG_DFU_TARGET_MCUBOOT)
+	if (img_type == DFU_TARGET_IMAGE_TYPE_MCUBOOT) {
+		const struct flash_area *fa;
+
+		err = flash_area_open(PM_MCUBOOT_SECONDARY_ID, &fa);
+		if (err) {
+			LOG_ERR("Failed to open secondary slot, err %d", err);
+			return 0;
+		}
+
+		err = download_client_journal_verify(&journal, journal_read, (void *)fa);
+		flash_area_close(fa);
+
+		return err == -EBADMSG ? err : 0;
+	}
+#endif
+
+	/* The image cannot be read back, like a modem delta image. The journal
+	 * is accepted without its running hash, the ETag and size of the
+	 * resource are still checked against the server when resuming.
+	 */
+	(void)download_client_journal_verify(&journal, NULL, NULL);
+
+	return 0;
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_JOURNAL */
+
 static void download_with_offset(struct k_work *unused)
 {
 	int offset;
@@ -270,6 +335,20 @@ static void download_with_offset(struct k_work *unused)
 		return;
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+	err = journal_verify(offset);
+	if (err != 0) {
+		LOG_ERR("Stored image does not match the download journal");
+		err = dfu_target_done(false);
+		if (err != 0) {
+			LOG_ERR("Unable to free DFU target resources");
+		}
+		first_fragment = true;
+		send_error_evt(FOTA_DOWNLOAD_ERROR_CAUSE_INVALID_UPDATE);
+		return;
+	}
+#endif
+
 	err = download_client_connect(&dlc, dlc.host, &dlc.config);
 	if (err != 0) {
 		LOG_ERR("%s failed to connect with error %d", __func__, err);
@@ -377,6 +456,7 @@ int fota_download_start_with_image_type(const char *host, const char *file,
 		.sec_tag = sec_tag,
 		.pdn_id = pdn_id,
 		.frag_size_override = fragment_size,
+		.journal = IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_JOURNAL),
 	};
 
 	if (host == NULL || file == NULL || callback == NULL) {
@@ -1530,6 +1530,7 @@ static void end_transfer_handler(int transfer_result)
 int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 {
 	int err = 0;
+	int64_t init_start = k_uptime_get();
 	struct nrf_cloud_pgps_event evt = {
 		.type = PGPS_EVT_INIT,
 	};
@@ -1629,6 +1630,8 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 		LOG_INF("Checking stored P-GPS data; count:%u, period_min:%u",
 			count, period_min);
 		num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+		LOG_INF("Checked stored P-GPS data in %d ms; valid:%u",
+			(int32_t)(k_uptime_get() - init_start), num_valid);
 	}
 
 	struct nrf_cloud_pgps_prediction *found_prediction = NULL;
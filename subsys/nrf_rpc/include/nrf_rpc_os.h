@@ -89,6 +89,40 @@ static inline void nrf_rpc_os_tls_set(void *data)
 uint32_t nrf_rpc_os_ctx_pool_reserve(void);
 void nrf_rpc_os_ctx_pool_release(uint32_t number);
 
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+/** Number of buckets of the queue wait time histogram. */
+#define NRF_RPC_OS_WAIT_HIST_SIZE 16
+
+/** @brief Thread pool statistics. */
+struct nrf_rpc_os_thread_pool_stats {
+	/** Number of messages dispatched while a given number of threads was occupied. */
+	uint32_t occupancy[CONFIG_NRF_RPC_THREAD_POOL_SIZE + 1];
+
+	/** Number of messages that waited in a queue for a given time.
+	 *  Bucket n counts waits shorter than 2^n microseconds and not shorter
+	 *  than the previous bucket. The last bucket counts all longer waits.
+	 */
+	uint32_t wait[NRF_RPC_OS_WAIT_HIST_SIZE];
+
+	/** Number of messages handled by the same thread as the previous
+	 *  message from the same remote context.
+	 */
+	uint32_t affinity_hits;
+
+	/** Number of messages stolen from the queue of another thread. */
+	uint32_t steals;
+};
+
+/** @brief Get the thread pool statistics.
+ *
+ * @param[out] stats Thread pool statistics.
+ */
+void nrf_rpc_os_thread_pool_stats_get(struct nrf_rpc_os_thread_pool_stats *stats);
+
+/** @brief Reset the thread pool statistics. */
+void nrf_rpc_os_thread_pool_stats_reset(void);
+#endif /* CONFIG_NRF_RPC_THREAD_POOL_STATS */
+
 #ifdef __cplusplus
 }
 #endif
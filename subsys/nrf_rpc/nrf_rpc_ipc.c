@@ -18,6 +18,10 @@ LOG_MODULE_REGISTER(nrf_rpc_ipc, CONFIG_NRF_RPC_TR_LOG_LEVEL);
 
 #define EPT_BIND_TIMEOUT K_MSEC(CONFIG_NRF_RPC_IPC_SERVICE_BIND_TIMEOUT_MS)
 
+/* Tx buffers used when the endpoint does not provide shared memory buffers. */
+K_MEM_SLAB_DEFINE(tx_pool, CONFIG_NRF_RPC_IPC_SERVICE_TX_POOL_BUF_SIZE,
+		  CONFIG_NRF_RPC_IPC_SERVICE_TX_POOL_BUF_COUNT, 4);
+
 /* Utility macro for dumping content of the packets with limit of 32 bytes
  * to prevent overflowing the logs.
  */
@@ -64,6 +68,100 @@ static int translate_error(int ll_err)
 	return 0;
 }
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_STATS)
+static void stats_alloc_failure(struct nrf_rpc_ipc *ipc_config)
+{
+	atomic_inc(&ipc_config->stats.alloc_failures);
+}
+
+static void stats_heap_alloc(struct nrf_rpc_ipc *ipc_config)
+{
+	atomic_inc(&ipc_config->stats.heap_allocs);
+}
+
+static void stats_sent(struct nrf_rpc_ipc *ipc_config, uint32_t start, bool nocopy)
+{
+	uint32_t time_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	atomic_val_t max;
+	k_spinlock_key_t key;
+
+	atomic_inc(&ipc_config->stats.sent);
+	if (nocopy) {
+		atomic_inc(&ipc_config->stats.sent_nocopy);
+	}
+
+	do {
+		max = atomic_get(&ipc_config->stats.send_time_max_us);
+		if (time_us <= (uint32_t)max) {
+			break;
+		}
+	} while (!atomic_cas(&ipc_config->stats.send_time_max_us, max, time_us));
+
+	key = k_spin_lock(&ipc_config->stats.lock);
+	ipc_config->stats.send_time_us += time_us;
+	k_spin_unlock(&ipc_config->stats.lock, key);
+}
+#else
+static void stats_alloc_failure(struct nrf_rpc_ipc *ipc_config) {}
+static void stats_heap_alloc(struct nrf_rpc_ipc *ipc_config) {}
+static void stats_sent(struct nrf_rpc_ipc *ipc_config, uint32_t start, bool nocopy) {}
+#endif /* CONFIG_NRF_RPC_IPC_SERVICE_STATS */
+
+static bool tx_pool_buf(const void *buf)
+{
+	const char *pool_start = tx_pool.buffer;
+	const char *pool_end = pool_start + tx_pool.num_blocks * tx_pool.block_size;
+
+	return ((const char *)buf >= pool_start) && ((const char *)buf < pool_end);
+}
+
+static void *tx_pool_buf_alloc(struct nrf_rpc_ipc *ipc_config, size_t size)
+{
+	void *data;
+
+	if ((size <= tx_pool.block_size) && !k_mem_slab_alloc(&tx_pool, &data, K_NO_WAIT)) {
+		return data;
+	}
+
+	/* The packet is too large for the pool or the pool is exhausted. */
+	data = k_malloc(size);
+	if (data) {
+		stats_heap_alloc(ipc_config);
+	}
+
+	return data;
+}
+
+static void tx_pool_buf_free(void *buf)
+{
+	if (tx_pool_buf(buf)) {
+		k_mem_slab_free(&tx_pool, &buf);
+	} else {
+		k_free(buf);
+	}
+}
+
+/* Check if the endpoint backend provides Tx buffers in the shared memory. */
+static bool nocopy_supported(struct nrf_rpc_ipc_endpoint *endpoint)
+{
+	void *data;
+	uint32_t size = 1;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_NRF_RPC_IPC_SERVICE_NOCOPY)) {
+		return false;
+	}
+
+	err = ipc_service_get_tx_buffer(&endpoint->ept, &data, &size, K_NO_WAIT);
+	if (!err) {
+		(void)ipc_service_drop_tx_buffer(&endpoint->ept, data);
+		return true;
+	}
+
+	/* Supported, but no buffer is available at the moment. */
+	return (err == -ENOBUFS);
+}
+
 static void ept_bound(void *priv)
 {
 	const struct nrf_rpc_tr *transport = priv;
@@ -142,6 +240,11 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		return -NRF_EPIPE;
 	}
 
+	ipc_config->nocopy = nocopy_supported(endpoint);
+
+	LOG_DBG("Tx buffers allocated from %s",
+		ipc_config->nocopy ? "shared memory" : "buffer pool");
+
 	return 0;
 }
 
@@ -150,6 +253,7 @@ int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
 	int err;
 	struct nrf_rpc_ipc *ipc_config = transport->ctx;
 	struct nrf_rpc_ipc_endpoint *endpoint = &ipc_config->endpoint;
+	uint32_t start = k_cycle_get_32();
 
 	if (!ipc_config->used) {
 		LOG_ERR("nRF RPC transport is not initialized");
@@ -159,32 +263,63 @@ int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
 	LOG_DBG("Sending %u bytes", length);
 	DUMP_LIMITED_DBG(data, length, "Data: ");
 
-	err = ipc_service_send(&endpoint->ept, data, length);
-	if (err < 0) {
-		LOG_ERR("ipc_service_send returned err: %d", err);
-	} else if (err > 0) {
+	if (ipc_config->nocopy) {
+		err = ipc_service_send_nocopy(&endpoint->ept, data, length);
+		if (err < 0) {
+			LOG_ERR("ipc_service_send_nocopy returned err: %d", err);
+
+			/* The buffer is not released if sending fails. */
+			(void)ipc_service_drop_tx_buffer(&endpoint->ept, data);
+		}
+	} else {
+		err = ipc_service_send(&endpoint->ept, data, length);
+		if (err < 0) {
+			LOG_ERR("ipc_service_send returned err: %d", err);
+		}
+
+		tx_pool_buf_free((void *)data);
+	}
+
+	if (err > 0) {
 		LOG_DBG("Sent %u bytes", err);
 		err = 0;
 	}
 
-	k_free((void *)data);
+	if (!err) {
+		stats_sent(ipc_config, start, ipc_config->nocopy);
+	}
 
 	return translate_error(err);
 }
 
 void *tx_buf_alloc(const struct nrf_rpc_tr *transport, size_t *size)
 {
+	int err;
 	void *data = NULL;
 	struct nrf_rpc_ipc *ipc_config = transport->ctx;
+	uint32_t buf_size = *size;
 
 	if (!ipc_config->used) {
 		LOG_ERR("nRF RPC transport is not initialized");
 		goto error;
 	}
 
-	data = k_malloc(*size);
+	if (ipc_config->nocopy) {
+		err = ipc_service_get_tx_buffer(&ipc_config->endpoint.ept, &data, &buf_size,
+						K_FOREVER);
+		if (err) {
+			LOG_ERR("Failed to get Tx buffer of %u bytes, err: %d", *size, err);
+			stats_alloc_failure(ipc_config);
+			goto error;
+		}
+
+		return data;
+	}
+
+	data = tx_pool_buf_alloc(ipc_config, *size);
 	if (!data) {
 		LOG_ERR("Failed to allocate Tx buffer.");
+		stats_alloc_failure(ipc_config);
 		goto error;
 	}
 
@@ -206,7 +341,37 @@ void tx_buf_free(const struct nrf_rpc_tr *transport, void *buf)
 		return;
 	}
 
-	k_free(buf);
+	if (ipc_config->nocopy) {
+		(void)ipc_service_drop_tx_buffer(&ipc_config->endpoint.ept, buf);
+	} else {
+		tx_pool_buf_free(buf);
+	}
+}
+
+int nrf_rpc_ipc_stats_get(const struct nrf_rpc_tr *transport, struct nrf_rpc_ipc_stats *stats)
+{
+	if (!transport || !stats) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_STATS)
+	struct nrf_rpc_ipc *ipc_config = transport->ctx;
+	k_spinlock_key_t key;
+
+	stats->sent = atomic_get(&ipc_config->stats.sent);
+	stats->sent_nocopy = atomic_get(&ipc_config->stats.sent_nocopy);
+	stats->alloc_failures = atomic_get(&ipc_config->stats.alloc_failures);
+	stats->heap_allocs = atomic_get(&ipc_config->stats.heap_allocs);
+	stats->send_time_max_us = atomic_get(&ipc_config->stats.send_time_max_us);
+
+	key = k_spin_lock(&ipc_config->stats.lock);
+	stats->send_time_us = ipc_config->stats.send_time_us;
+	k_spin_unlock(&ipc_config->stats.lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
 }
 
 const struct nrf_rpc_tr_api nrf_rpc_ipc_service_api = {
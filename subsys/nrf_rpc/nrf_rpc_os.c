@@ -7,8 +7,14 @@
 #define NRF_RPC_LOG_MODULE NRF_RPC_OS
 #include <nrf_rpc_log.h>
 
+#include <zephyr/sys/math_extras.h>
+
 #include "nrf_rpc_os.h"
 
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS_CMDS)
+#include <zephyr/shell/shell.h>
+#endif
+
 /* Maximum number of remote thread that this implementation allows. */
 #define MAX_REMOTE_THREADS 255
 
@@ -19,15 +25,42 @@
 	(~(((atomic_val_t)1 << (8 * sizeof(atomic_val_t) -		       \
 				CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE)) - 1))
 
+/* Offset of the source context id in the packet header. Packets coming from
+ * the same remote context are preferably handled by the same pool thread.
+ */
+#define PACKET_SRC_OFFSET 0
+
 struct pool_start_msg {
 	const uint8_t *data;
 	size_t len;
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+	uint32_t timestamp;
+#endif
+};
+
+/* Pool thread with its own queue. Idle threads steal the oldest message
+ * from the longest queue, so a message never waits behind a long-running
+ * command while another thread is free.
+ */
+struct pool_thread {
+	struct k_thread thread;
+	struct k_sem wakeup;
+	struct pool_start_msg queue[CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t count;
+	bool busy;
 };
 
 static nrf_rpc_os_work_t thread_pool_callback;
 
-static struct pool_start_msg pool_start_msg_buf[2];
-static struct k_msgq pool_start_msg;
+static struct pool_thread pool[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
+static struct k_spinlock pool_lock;
+static struct k_sem pool_space;
+static uint8_t pool_affinity[MAX_REMOTE_THREADS + 1];
+
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+static struct nrf_rpc_os_thread_pool_stats pool_stats;
+#endif
 
 static struct k_sem context_reserved;
 static atomic_t context_mask;
@@ -36,21 +69,153 @@ static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks,
 	CONFIG_NRF_RPC_THREAD_POOL_SIZE,
 	CONFIG_NRF_RPC_THREAD_STACK_SIZE);
 
-static struct k_thread pool_threads[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
-
 BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE > 0,
 	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE must be greaten than zero");
 BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= 8 * sizeof(atomic_val_t),
 	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE too big");
 BUILD_ASSERT(sizeof(uint32_t) == sizeof(atomic_val_t),
 	     "Only atomic_val_t is implemented that is the same as uint32_t");
+BUILD_ASSERT(CONFIG_NRF_RPC_THREAD_POOL_SIZE <= UINT8_MAX,
+	     "CONFIG_NRF_RPC_THREAD_POOL_SIZE too big");
+
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+/* Must be called with the pool lock held. */
+static void stats_dispatch(bool affinity_hit)
+{
+	uint32_t occupied = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].busy || pool[i].count) {
+			occupied++;
+		}
+	}
+
+	pool_stats.occupancy[occupied]++;
+
+	if (affinity_hit) {
+		pool_stats.affinity_hits++;
+	}
+}
+
+/* Must be called with the pool lock held. */
+static void stats_start(const struct pool_start_msg *msg, bool stolen)
+{
+	uint32_t wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - msg->timestamp);
+	uint32_t bucket = MIN(32 - u32_count_leading_zeros(wait_us), NRF_RPC_OS_WAIT_HIST_SIZE - 1);
+
+	pool_stats.wait[bucket]++;
+
+	if (stolen) {
+		pool_stats.steals++;
+	}
+}
+#else
+static void stats_dispatch(bool affinity_hit) {}
+static void stats_start(const struct pool_start_msg *msg, bool stolen) {}
+#endif /* CONFIG_NRF_RPC_THREAD_POOL_STATS */
+
+static void queue_push(struct pool_thread *thread, const struct pool_start_msg *msg)
+{
+	uint8_t tail = (thread->head + thread->count) % ARRAY_SIZE(thread->queue);
+
+	__ASSERT_NO_MSG(thread->count < ARRAY_SIZE(thread->queue));
+
+	thread->queue[tail] = *msg;
+	thread->count++;
+}
+
+static bool queue_pop(struct pool_thread *thread, struct pool_start_msg *msg)
+{
+	if (thread->count == 0) {
+		return false;
+	}
+
+	*msg = thread->queue[thread->head];
+	thread->head = (thread->head + 1) % ARRAY_SIZE(thread->queue);
+	thread->count--;
+
+	return true;
+}
+
+static bool thread_idle(const struct pool_thread *thread)
+{
+	return !thread->busy && (thread->count == 0);
+}
+
+/* Select the thread for a new message. Must be called with the pool lock held. */
+static struct pool_thread *thread_select(uint8_t affinity, bool *affinity_hit)
+{
+	struct pool_thread *selected = &pool[affinity];
+
+	*affinity_hit = thread_idle(selected);
+	if (*affinity_hit) {
+		return selected;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (thread_idle(&pool[i])) {
+			return &pool[i];
+		}
+	}
+
+	/* All threads are occupied, queue the message where the fewest are waiting.
+	 * The pool space semaphore guarantees that some queue is not full.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if (pool[i].count < selected->count) {
+			selected = &pool[i];
+		}
+	}
+
+	return selected;
+}
+
+/* Take the oldest message from the longest queue of other threads.
+ * Must be called with the pool lock held.
+ */
+static bool queue_steal(struct pool_thread *self, struct pool_start_msg *msg)
+{
+	struct pool_thread *victim = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pool); i++) {
+		if ((&pool[i] != self) && pool[i].count &&
+		    (!victim || (pool[i].count > victim->count))) {
+			victim = &pool[i];
+		}
+	}
+
+	return victim && queue_pop(victim, msg);
+}
 
 static void thread_pool_entry(void *p1, void *p2, void *p3)
 {
+	struct pool_thread *self = p1;
 	struct pool_start_msg msg;
+	k_spinlock_key_t key;
+	bool stolen;
 
 	do {
-		k_msgq_get(&pool_start_msg, &msg, K_FOREVER);
+		key = k_spin_lock(&pool_lock);
+
+		stolen = false;
+		self->busy = queue_pop(self, &msg);
+		if (!self->busy) {
+			self->busy = queue_steal(self, &msg);
+			stolen = self->busy;
+		}
+
+		if (self->busy) {
+			stats_start(&msg, stolen);
+		}
+
+		k_spin_unlock(&pool_lock, key);
+
+		if (!self->busy) {
+			k_sem_take(&self->wakeup, K_FOREVER);
+			continue;
+		}
+
+		k_sem_give(&pool_space);
 		thread_pool_callback(msg.data, msg.len);
 	} while (1);
 }
@@ -72,15 +237,15 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 
 	atomic_set(&context_mask, CONTEXT_MASK_INIT_VALUE);
 
-	k_msgq_init(&pool_start_msg, (char *)pool_start_msg_buf,
-		    sizeof(struct pool_start_msg),
-		    ARRAY_SIZE(pool_start_msg_buf));
+	k_sem_init(&pool_space, ARRAY_SIZE(pool) * CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE,
+		   ARRAY_SIZE(pool) * CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE);
 
 	for (i = 0; i < CONFIG_NRF_RPC_THREAD_POOL_SIZE; i++) {
-		k_thread_create(&pool_threads[i], pool_stacks[i],
+		k_sem_init(&pool[i].wakeup, 0, 1);
+		k_thread_create(&pool[i].thread, pool_stacks[i],
 			K_THREAD_STACK_SIZEOF(pool_stacks[i]),
 			thread_pool_entry,
-			NULL, NULL, NULL,
+			&pool[i], NULL, NULL,
 			CONFIG_NRF_RPC_THREAD_PRIORITY, 0, K_NO_WAIT);
 	}
 
@@ -90,12 +255,51 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 void nrf_rpc_os_thread_pool_send(const uint8_t *data, size_t len)
 {
 	struct pool_start_msg msg;
+	struct pool_thread *thread;
+	k_spinlock_key_t key;
+	uint8_t src = (len > PACKET_SRC_OFFSET) ? data[PACKET_SRC_OFFSET] : 0;
+	bool affinity_hit;
 
 	msg.data = data;
 	msg.len = len;
-	k_msgq_put(&pool_start_msg, &msg, K_FOREVER);
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+	msg.timestamp = k_cycle_get_32();
+#endif
+
+	k_sem_take(&pool_space, K_FOREVER);
+
+	key = k_spin_lock(&pool_lock);
+
+	thread = thread_select(pool_affinity[src], &affinity_hit);
+	stats_dispatch(affinity_hit);
+	queue_push(thread, &msg);
+	pool_affinity[src] = thread - pool;
+
+	k_spin_unlock(&pool_lock, key);
+
+	k_sem_give(&thread->wakeup);
+}
+
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS)
+void nrf_rpc_os_thread_pool_stats_get(struct nrf_rpc_os_thread_pool_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+
+	*stats = pool_stats;
+
+	k_spin_unlock(&pool_lock, key);
 }
 
+void nrf_rpc_os_thread_pool_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+
+	memset(&pool_stats, 0, sizeof(pool_stats));
+
+	k_spin_unlock(&pool_lock, key);
+}
+#endif /* CONFIG_NRF_RPC_THREAD_POOL_STATS */
+
 void nrf_rpc_os_msg_set(struct nrf_rpc_os_msg *msg, const uint8_t *data,
 			size_t len)
 {
@@ -140,3 +344,46 @@ void nrf_rpc_os_ctx_pool_release(uint32_t number)
 	atomic_or(&context_mask, 0x80000000u >> number);
 	k_sem_give(&context_reserved);
 }
+
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_STATS_CMDS)
+static int cmd_pool_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct nrf_rpc_os_thread_pool_stats stats;
+
+	nrf_rpc_os_thread_pool_stats_get(&stats);
+
+	shell_print(shell, "Dispatched threads occupancy:");
+	for (size_t i = 0; i < ARRAY_SIZE(stats.occupancy); i++) {
+		shell_print(shell, "  %2zu busy: %u", i, stats.occupancy[i]);
+	}
+
+	shell_print(shell, "Queue wait time:");
+	for (size_t i = 0; i < ARRAY_SIZE(stats.wait); i++) {
+		shell_print(shell, "  %s%6u us: %u",
+			    (i == ARRAY_SIZE(stats.wait) - 1) ? ">=" : "< ",
+			    (unsigned int)((i == ARRAY_SIZE(stats.wait) - 1) ? BIT(i - 1) : BIT(i)),
+			    stats.wait[i]);
+	}
+
+	shell_print(shell, "Affinity hits: %u", stats.affinity_hits);
+	shell_print(shell, "Steals: %u", stats.steals);
+
+	return 0;
+}
+
+static int cmd_pool_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	nrf_rpc_os_thread_pool_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_pool,
+	SHELL_CMD_ARG(stats, NULL, "Show thread pool statistics", cmd_pool_stats, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Reset thread pool statistics", cmd_pool_reset, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_ARG_REGISTER(nrf_rpc_pool, &sub_cmd_pool, "nRF RPC thread pool",
+		       cmd_pool_stats, 1, 1);
+#endif /* CONFIG_NRF_RPC_THREAD_POOL_STATS_CMDS */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ztest.h>
+#include <zephyr/kernel.h>
+
+#include "qspi_if.h"
+#include "rpu_hw_if.h"
+
+/* Frames are written to a window at the end of the nRF7002 packet RAM, which
+ * is not used by the driver in radio test mode, and read back to check them.
+ */
+#define SCRATCH_ADDR 0x0E0000
+#define FRAME_LEN 1600
+#define FRAME_CNT 8
+#define ROUND_CNT 64
+#define TOTAL_LEN ((uint64_t)ROUND_CNT * FRAME_CNT * FRAME_LEN)
+
+static uint32_t frames[FRAME_CNT][FRAME_LEN / 4];
+static uint32_t readback[FRAME_LEN / 4];
+
+static struct qspi_xfer xfers[FRAME_CNT];
+static struct qspi_req reqs[FRAME_CNT];
+static struct k_sem frame_free[FRAME_CNT];
+static atomic_t req_errors;
+
+static uint32_t blocking_us;
+
+static unsigned int frame_addr(size_t idx)
+{
+	return SCRATCH_ADDR + idx * FRAME_LEN;
+}
+
+/* Stands for the work done by the host on each frame before it is written,
+ * which the queued writes overlap with the QSPI transfers.
+ */
+static void frame_fill(uint32_t *frame, uint32_t seed)
+{
+	for (size_t i = 0; i < FRAME_LEN / 4; i++) {
+		frame[i] = seed ^ (i * 0x9E3779B1);
+	}
+}
+
+static void frames_verify(void)
+{
+	for (size_t i = 0; i < FRAME_CNT; i++) {
+		zassert_ok(rpu_read(frame_addr(i), readback, FRAME_LEN),
+			   "Frame %zu read failed", i);
+		zassert_mem_equal(readback, frames[i], FRAME_LEN,
+				  "Frame %zu does not match", i);
+	}
+}
+
+static void req_done(struct qspi_req *req, int status)
+{
+	if (status) {
+		atomic_inc(&req_errors);
+	}
+
+	k_sem_give(req->user_data);
+}
+
+static void req_prepare(size_t idx, unsigned int addr, uint32_t *data, size_t len)
+{
+	xfers[idx].addr = addr;
+	xfers[idx].data = data;
+	xfers[idx].len = len;
+	xfers[idx].write = true;
+
+	reqs[idx].xfers = &xfers[idx];
+	reqs[idx].xfer_cnt = 1;
+	reqs[idx].cb = req_done;
+	reqs[idx].user_data = &frame_free[idx];
+}
+
+static void throughput_print(const char *name, uint32_t us_spent)
+{
+	printk(" Time: %u us\n", us_spent);
+	printk(" %s write speed %llu kB/s\n", name, (TOTAL_LEN * 1000) / (1024 * us_spent));
+}
+
+static void test_blocking_throughput(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (size_t round = 0; round < ROUND_CNT; round++) {
+		for (size_t i = 0; i < FRAME_CNT; i++) {
+			frame_fill(frames[i], (round << 16) | i);
+			zassert_ok(rpu_write(frame_addr(i), frames[i], FRAME_LEN),
+				   "Frame %zu write failed", i);
+		}
+	}
+
+	blocking_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	frames_verify();
+	throughput_print("Blocking", blocking_us);
+}
+
+static void test_queued_throughput(void)
+{
+	uint32_t queued_us;
+	uint32_t start;
+
+	atomic_clear(&req_errors);
+
+	for (size_t i = 0; i < FRAME_CNT; i++) {
+		k_sem_init(&frame_free[i], 1, 1);
+		req_prepare(i, frame_addr(i), frames[i], FRAME_LEN);
+	}
+
+	start = k_cycle_get_32();
+
+	for (size_t round = 0; round < ROUND_CNT; round++) {
+		for (size_t i = 0; i < FRAME_CNT; i++) {
+			/* Wait for the write of the previous round. */
+			k_sem_take(&frame_free[i], K_FOREVER);
+			frame_fill(frames[i], ~((round << 16) | i));
+			zassert_ok(qspi_submit(&reqs[i]), "Frame %zu submit failed", i);
+		}
+	}
+
+	qspi_flush();
+
+	queued_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	zassert_equal(atomic_get(&req_errors), 0, "Queued writes failed");
+
+	for (size_t i = 0; i < FRAME_CNT; i++) {
+		zassert_equal(k_sem_count_get(&frame_free[i]), 1,
+			      "Frame %zu not completed after flush", i);
+	}
+
+	frames_verify();
+	throughput_print("Queued", queued_us);
+
+	if (blocking_us) {
+		printk(" Queued writes take %u%% of the blocking time\n",
+		       (uint32_t)(((uint64_t)queued_us * 100) / blocking_us));
+	}
+}
+
+static void test_queued_order(void)
+{
+	atomic_clear(&req_errors);
+
+	frame_fill(frames[0], 0xA5A5A5A5);
+	frame_fill(frames[1], 0x5A5A5A5A);
+
+	for (size_t i = 0; i < 2; i++) {
+		k_sem_init(&frame_free[i], 0, 1);
+		req_prepare(i, SCRATCH_ADDR, frames[i], FRAME_LEN);
+		zassert_ok(qspi_submit(&reqs[i]), "Submit failed");
+	}
+
+	/* A blocking read issued after the requests runs once they complete. */
+	zassert_ok(rpu_read(SCRATCH_ADDR, readback, FRAME_LEN), "Read failed");
+
+	for (size_t i = 0; i < 2; i++) {
+		zassert_equal(k_sem_count_get(&frame_free[i]), 1,
+			      "Request %zu not completed before the read", i);
+	}
+
+	zassert_equal(atomic_get(&req_errors), 0, "Queued writes failed");
+	zassert_mem_equal(readback, frames[1], FRAME_LEN, "Requests completed out of order");
+}
+
+static void test_unaligned_req(void)
+{
+	req_prepare(0, SCRATCH_ADDR, frames[0], FRAME_LEN - 2);
+	zassert_equal(qspi_submit(&reqs[0]), -EINVAL, "Unaligned length accepted");
+
+	req_prepare(0, SCRATCH_ADDR + 2, frames[0], FRAME_LEN);
+	zassert_equal(qspi_submit(&reqs[0]), -EINVAL, "Unaligned address accepted");
+
+	req_prepare(0, SCRATCH_ADDR, (uint32_t *)((uint8_t *)frames[0] + 2), FRAME_LEN - 4);
+	zassert_equal(qspi_submit(&reqs[0]), -EINVAL, "Unaligned buffer accepted");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(qspi_loopback,
+			 ztest_unit_test(test_blocking_throughput),
+			 ztest_unit_test(test_queued_throughput),
+			 ztest_unit_test(test_queued_order),
+			 ztest_unit_test(test_unaligned_req)
+			 );
+
+	ztest_run_test_suite(qspi_loopback);
+}
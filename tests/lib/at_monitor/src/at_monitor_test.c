@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <modem/at_monitor.h>
+#include <mock_nrf_modem_at.h>
+
+#include "test_monitors.h"
+
+/* Overlapping prefixes */
+AT_MONITOR(mon_cereg, "+CEREG", on_cereg);
+AT_MONITOR(mon_cereg_home, "+CEREG: 1", on_cereg_home);
+AT_MONITOR(mon_cereg_roam, "+CEREG: 5", on_cereg_roam);
+/* A filter which is a suffix of another */
+AT_MONITOR(mon_sleep, "SLEEP", on_sleep);
+AT_MONITOR(mon_xmodemsleep, "%XMODEMSLEEP", on_xmodemsleep);
+/* Needs a suffix link to match after a partial match, as in "ABABAC" */
+AT_MONITOR(mon_abac, "ABAC", on_abac);
+AT_MONITOR(mon_any, ANY, on_any);
+AT_MONITOR(mon_cscon, "+CSCON", on_cscon, PAUSED);
+AT_MONITOR_ISR(mon_ncellmeas, "%NCELLMEAS", on_ncellmeas);
+/* Keeps a reference to the notifications it receives, when enabled */
+AT_MONITOR(mon_hold, "+HOLD", on_hold);
+
+static const struct test_monitor monitors[] = {
+	{ &mon_cereg, MON_CEREG },
+	{ &mon_cereg_home, MON_CEREG_HOME },
+	{ &mon_cereg_roam, MON_CEREG_ROAM },
+	{ &mon_sleep, MON_SLEEP },
+	{ &mon_xmodemsleep, MON_XMODEMSLEEP },
+	{ &mon_abac, MON_ABAC },
+	{ &mon_any, MON_ANY },
+	{ &mon_cscon, MON_CSCON },
+	{ &mon_ncellmeas, MON_NCELLMEAS },
+	{ &mon_hold, MON_HOLD },
+};
+
+static const char * const notifs[] = {
+	"+CEREG: 1,\"002F\",\"0012BEEF\",7\r\n",
+	"+CEREG: 5,\"002F\",\"0012BEEF\",7\r\n",
+	"+CEREG: 2\r\n",
+	"+CERE\r\n",
+	"%XMODEMSLEEP: 1,86400000\r\n",
+	"%XMODEMSLEE\r\n",
+	"%XSLEEP\r\n",
+	"ABABAC\r\n",
+	"ABABAB\r\n",
+	"+CGEV: ME PDN ACT 0\r\n",
+	"+CGEV: ME DETACH\r\n",
+	"+CSCON: 1\r\n",
+	"%NCELLMEAS: 0,\"0012BEEF\"\r\n",
+	"+CEREG: 1 +CGEV: ME PDN ACT 0 %XMODEMSLEEP ABAC\r\n",
+	"\r\n",
+};
+
+static atomic_t received;
+static bool len_mismatch;
+
+#define HOLD_MAX 128
+
+static bool hold;
+static const char *held[HOLD_MAX];
+static size_t held_head;
+static size_t held_tail;
+
+/* at_monitor_dispatch() is implemented in at_monitor library and
+ * we'll call it directly to fake received AT notifications
+ */
+extern void at_monitor_dispatch(const char *at_notif);
+
+void monitor_received(enum test_monitor_id id, const char *notif)
+{
+	atomic_or(&received, BIT(id));
+
+	/* Notifications for the workqueue are copied along with their length */
+	if (id != MON_NCELLMEAS && at_monitor_notif_len(notif) != strlen(notif)) {
+		len_mismatch = true;
+	}
+}
+
+/* Dispatch a notification and return the monitors which received it. */
+static uint32_t dispatch(const char *notif)
+{
+	atomic_clear(&received);
+	at_monitor_dispatch(notif);
+	/* Let the system workqueue run the deferred monitors */
+	k_sleep(K_MSEC(10));
+
+	return atomic_get(&received);
+}
+
+static uint32_t expected_add(const struct test_monitor *tm, size_t cnt, const char *notif)
+{
+	uint32_t expected = 0;
+
+	for (size_t i = 0; i < cnt; i++) {
+		const struct at_monitor_entry *mon = tm[i].mon;
+
+		if (mon->flags.paused) {
+			continue;
+		}
+
+		if (mon->filter == ANY || strstr(notif, mon->filter)) {
+			expected |= BIT(tm[i].id);
+		}
+	}
+
+	return expected;
+}
+
+/* The monitors expected to receive a notification, using a plain substring search. */
+static uint32_t expected(const char *notif)
+{
+	return expected_add(monitors, ARRAY_SIZE(monitors), notif) |
+	       expected_add(ext_monitors, ext_monitors_cnt, notif);
+}
+
+/* Dispatch "+HOLD: <n>" and return whether it was received. */
+static bool dispatch_hold(size_t n)
+{
+	char notif[32];
+
+	snprintf(notif, sizeof(notif), "+HOLD: %04u\r\n", (unsigned int)n);
+
+	return dispatch(notif) & BIT(MON_HOLD);
+}
+
+/* Release the oldest held notification, checking it was not overwritten. */
+static void release_oldest(size_t n)
+{
+	char notif[32];
+	const char *held_notif;
+
+	TEST_ASSERT_NOT_EQUAL(held_head, held_tail);
+
+	held_notif = held[held_tail++ % HOLD_MAX];
+
+	snprintf(notif, sizeof(notif), "+HOLD: %04u\r\n", (unsigned int)n);
+	TEST_ASSERT_EQUAL_STRING(notif, held_notif);
+
+	at_monitor_notif_unref(held_notif);
+}
+
+static void release_all(void)
+{
+	while (held_tail != held_head) {
+		at_monitor_notif_unref(held[held_tail++ % HOLD_MAX]);
+	}
+}
+
+void setUp(void)
+{
+	mock_nrf_modem_at_Init();
+
+	atomic_clear(&received);
+	len_mismatch = false;
+	hold = false;
+	held_head = 0;
+	held_tail = 0;
+}
+
+void tearDown(void)
+{
+	struct at_monitor_stats stats;
+
+	release_all();
+
+	/* All notifications are released */
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&stats));
+	TEST_ASSERT_EQUAL(0, stats.used);
+
+	at_monitor_resume(&mon_any);
+	at_monitor_pause(&mon_cscon);
+
+	TEST_ASSERT_FALSE(len_mismatch);
+
+	mock_nrf_modem_at_Verify();
+}
+
+void test_at_monitor_overlapping_prefixes(void)
+{
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CEREG) | BIT(MON_CEREG_HOME),
+				dispatch("+CEREG: 1,\"002F\",\"0012BEEF\",7\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CEREG) | BIT(MON_CEREG_ROAM),
+				dispatch("+CEREG: 5,\"002F\",\"0012BEEF\",7\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CEREG),
+				dispatch("+CEREG: 2\r\n"));
+	/* A prefix of a filter is no match */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("+CERE\r\n"));
+	/* A filter which does not start the notification */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CEREG) | BIT(MON_CEREG_HOME),
+				dispatch("OK +CEREG: 1\r\n"));
+}
+
+void test_at_monitor_suffix_filter(void)
+{
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_SLEEP) | BIT(MON_XMODEMSLEEP),
+				dispatch("%XMODEMSLEEP: 1,86400000\r\n"));
+	/* Only the suffix matches */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_SLEEP), dispatch("%XSLEEP\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("%XMODEMSLEE\r\n"));
+	/* The partial match "ABAB" must fall back to "AB" to find "ABAC" */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_ABAC), dispatch("ABABAC\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("ABABAB\r\n"));
+	/* Filters of monitors defined in another file */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CGEV) | BIT(MON_PDN_ACT),
+				dispatch("+CGEV: ME PDN ACT 0\r\n"));
+}
+
+void test_at_monitor_any(void)
+{
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("+CGSN: \"352656100367872\"\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch(""));
+
+	/* Notifications which no monitor in the workqueue wants are not copied */
+	at_monitor_pause(&mon_any);
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&before));
+	TEST_ASSERT_EQUAL_HEX32(0, dispatch("+CGSN: \"352656100367872\"\r\n"));
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_NCELLMEAS), dispatch("%NCELLMEAS: 1\r\n"));
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&after));
+	TEST_ASSERT_EQUAL(before.notif_cnt, after.notif_cnt);
+	TEST_ASSERT_EQUAL(0, after.used);
+}
+
+void test_at_monitor_pause_resume(void)
+{
+	/* Defined paused */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("+CSCON: 1\r\n"));
+
+	at_monitor_resume(&mon_cscon);
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CSCON), dispatch("+CSCON: 1\r\n"));
+
+	at_monitor_pause(&mon_cscon);
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("+CSCON: 0\r\n"));
+
+	at_monitor_pause(&mon_ncellmeas);
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY), dispatch("%NCELLMEAS: 1\r\n"));
+	at_monitor_resume(&mon_ncellmeas);
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_NCELLMEAS), dispatch("%NCELLMEAS: 1\r\n"));
+}
+
+/* A monitor paused after a notification was matched, but before the workqueue ran. */
+void test_at_monitor_pause_pending(void)
+{
+	k_sched_lock();
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	at_monitor_pause(&mon_cereg_home);
+	k_sched_unlock();
+	k_sleep(K_MSEC(10));
+
+	at_monitor_resume(&mon_cereg_home);
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_CEREG), atomic_get(&received));
+}
+
+void test_at_monitor_isr(void)
+{
+	/* Monitors in the ISR are called before at_monitor_dispatch() returns */
+	k_sched_lock();
+	at_monitor_dispatch("%NCELLMEAS: 0,\"0012BEEF\"\r\n");
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_NCELLMEAS), atomic_get(&received));
+	k_sched_unlock();
+	k_sleep(K_MSEC(10));
+
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_NCELLMEAS), atomic_get(&received));
+}
+
+/* Every monitor receives the notifications its filter occurs in, and no other. */
+void test_at_monitor_match_all(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(notifs); i++) {
+		TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected(notifs[i]), dispatch(notifs[i]),
+						notifs[i]);
+	}
+
+	/* Again with monitors resumed at runtime and others paused */
+	at_monitor_resume(&mon_cscon);
+	at_monitor_pause(&mon_any);
+	at_monitor_pause(&mon_sleep);
+
+	for (size_t i = 0; i < ARRAY_SIZE(notifs); i++) {
+		TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected(notifs[i]), dispatch(notifs[i]),
+						notifs[i]);
+	}
+
+	at_monitor_resume(&mon_sleep);
+}
+
+/* Notifications held in order, with the oldest released as new ones arrive,
+ * so the ring buffer wraps around many times.
+ */
+void test_at_monitor_wrap_around(void)
+{
+	const size_t window = 4;
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&before));
+
+	hold = true;
+
+	for (size_t n = 0; n < 100; n++) {
+		TEST_ASSERT_TRUE(dispatch_hold(n));
+
+		if (n >= window) {
+			release_oldest(n - window);
+		}
+	}
+
+	for (size_t n = 100 - window; n < 100; n++) {
+		release_oldest(n);
+	}
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&after));
+	TEST_ASSERT_EQUAL(before.dropped_cnt, after.dropped_cnt);
+	TEST_ASSERT_EQUAL(0, after.used);
+}
+
+/* A held notification holds back the space of the notifications received after it. */
+void test_at_monitor_held_blocks_reclaim(void)
+{
+	struct at_monitor_stats stats;
+	uint32_t dropped;
+	size_t used_held;
+	size_t n;
+
+	if (!IS_ENABLED(CONFIG_AT_MONITOR_RING)) {
+		TEST_IGNORE();
+	}
+
+	hold = true;
+	TEST_ASSERT_TRUE(dispatch_hold(0));
+	hold = false;
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&stats));
+	used_held = stats.used;
+	dropped = stats.dropped_cnt;
+
+	/* Released right after dispatching, but not reclaimed behind the held one */
+	for (n = 1; n < HOLD_MAX && dispatch_hold(n); n++) {
+	}
+
+	TEST_ASSERT_LESS_THAN(HOLD_MAX, n);
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&stats));
+	TEST_ASSERT_EQUAL(dropped + 1, stats.dropped_cnt);
+	TEST_ASSERT_GREATER_THAN(used_held, stats.used);
+
+	/* Releasing the held notification reclaims all of them */
+	release_oldest(0);
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&stats));
+	TEST_ASSERT_EQUAL(0, stats.used);
+	TEST_ASSERT_TRUE(dispatch_hold(n));
+}
+
+/* Notifications that do not fit are dropped and counted, the others are still received. */
+void test_at_monitor_exhaustion(void)
+{
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+	size_t n;
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&before));
+
+	hold = true;
+
+	for (n = 0; n < HOLD_MAX && dispatch_hold(n); n++) {
+	}
+
+	TEST_ASSERT_LESS_THAN(HOLD_MAX, n);
+	TEST_ASSERT_GREATER_THAN(0, n);
+	/* The dropped notification was not received by any monitor in the workqueue */
+	TEST_ASSERT_EQUAL_HEX32(0, atomic_get(&received));
+
+	TEST_ASSERT_EQUAL(0, at_monitor_stats_get(&after));
+	TEST_ASSERT_EQUAL(before.dropped_cnt + 1, after.dropped_cnt);
+	TEST_ASSERT_EQUAL(before.notif_cnt + n + 1, after.notif_cnt);
+	TEST_ASSERT_LESS_OR_EQUAL(after.size, after.used_max);
+
+	/* ISR monitors do not need space */
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_NCELLMEAS), dispatch("%NCELLMEAS: 1\r\n"));
+
+	release_all();
+	hold = false;
+
+	TEST_ASSERT_EQUAL_HEX32(BIT(MON_ANY) | BIT(MON_HOLD), dispatch("+HOLD: 0\r\n"));
+}
+
+/* This is needed because AT Monitor library is initialized in SYS_INIT. */
+static int at_monitor_test_sys_init(const struct device *unused)
+{
+	__wrap_nrf_modem_at_notif_handler_set_ExpectAnyArgsAndReturn(0);
+
+	return 0;
+}
+
+static void on_cereg(const char *notif)
+{
+	monitor_received(MON_CEREG, notif);
+}
+
+static void on_cereg_home(const char *notif)
+{
+	monitor_received(MON_CEREG_HOME, notif);
+}
+
+static void on_cereg_roam(const char *notif)
+{
+	monitor_received(MON_CEREG_ROAM, notif);
+}
+
+static void on_sleep(const char *notif)
+{
+	monitor_received(MON_SLEEP, notif);
+}
+
+static void on_xmodemsleep(const char *notif)
+{
+	monitor_received(MON_XMODEMSLEEP, notif);
+}
+
+static void on_abac(const char *notif)
+{
+	monitor_received(MON_ABAC, notif);
+}
+
+static void on_any(const char *notif)
+{
+	monitor_received(MON_ANY, notif);
+}
+
+static void on_cscon(const char *notif)
+{
+	monitor_received(MON_CSCON, notif);
+}
+
+static void on_ncellmeas(const char *notif)
+{
+	monitor_received(MON_NCELLMEAS, notif);
+}
+
+static void on_hold(const char *notif)
+{
+	monitor_received(MON_HOLD, notif);
+
+	if (hold && held_head - held_tail < HOLD_MAX) {
+		at_monitor_notif_ref(notif);
+		held[held_head++ % HOLD_MAX] = notif;
+	}
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+void main(void)
+{
+	(void)unity_main();
+}
+
+SYS_INIT(at_monitor_test_sys_init, POST_KERNEL, 0);
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <modem/at_monitor.h>
+
+#include "test_monitors.h"
+
+AT_MONITOR(mon_cgev, "+CGEV", on_cgev);
+/* Found in the middle of notifications which also match "+CGEV" */
+AT_MONITOR(mon_pdn_act, "PDN ACT", on_pdn_act);
+
+const struct test_monitor ext_monitors[] = {
+	{ &mon_cgev, MON_CGEV },
+	{ &mon_pdn_act, MON_PDN_ACT },
+};
+
+const size_t ext_monitors_cnt = ARRAY_SIZE(ext_monitors);
+
+static void on_cgev(const char *notif)
+{
+	monitor_received(MON_CGEV, notif);
+}
+
+static void on_pdn_act(const char *notif)
+{
+	monitor_received(MON_PDN_ACT, notif);
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_MONITORS_H_
+#define TEST_MONITORS_H_
+
+#include <stdint.h>
+#include <modem/at_monitor.h>
+
+/* Bit set by each monitor in the received mask. */
+enum test_monitor_id {
+	MON_ANY,
+	MON_CEREG,
+	MON_CEREG_HOME,
+	MON_CEREG_ROAM,
+	MON_SLEEP,
+	MON_XMODEMSLEEP,
+	MON_ABAC,
+	MON_CSCON,
+	MON_NCELLMEAS,
+	MON_CGEV,
+	MON_PDN_ACT,
+	MON_HOLD,
+	MON_CNT,
+};
+
+struct test_monitor {
+	struct at_monitor_entry *mon;
+	enum test_monitor_id id;
+};
+
+/* Monitors defined in another file, placed elsewhere in the monitor section. */
+extern const struct test_monitor ext_monitors[];
+extern const size_t ext_monitors_cnt;
+
+void monitor_received(enum test_monitor_id id, const char *notif);
+
+#endif /* TEST_MONITORS_H_ */
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <pm_config.h>
+
+#include "trace_backend.h"
+#include "nrf_modem_lib_trace.h"
+
+#include "mock_flash_map.h"
+
+#define TRACE_BLOCK_SIZE CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_BLOCK_SIZE
+#define TRACE_DATA_SIZE (4 * TRACE_BLOCK_SIZE + 100)
+
+static uint8_t partition[PM_MODEM_TRACE_SIZE];
+static const struct flash_area trace_area = {
+	.fa_id = PM_MODEM_TRACE_ID,
+	.fa_size = PM_MODEM_TRACE_SIZE,
+};
+
+static uint8_t trace_data[TRACE_DATA_SIZE];
+static uint8_t read_data[2 * TRACE_DATA_SIZE];
+static uint8_t partition_copy[PM_MODEM_TRACE_SIZE];
+static size_t processed;
+
+static int callback(size_t len)
+{
+	processed += len;
+	return 0;
+}
+
+extern int unity_main(void);
+
+/* Suite teardown shall finalize with mandatory call to generic_suiteTearDown. */
+extern int generic_suiteTearDown(int num_failures);
+
+static int flash_area_open_stub(uint8_t id, const struct flash_area **fa, int num_calls)
+{
+	TEST_ASSERT_EQUAL(PM_MODEM_TRACE_ID, id);
+
+	*fa = &trace_area;
+
+	return 0;
+}
+
+static uint8_t flash_area_align_stub(const struct flash_area *fa, int num_calls)
+{
+	return 4;
+}
+
+static int flash_area_read_stub(const struct flash_area *fa, off_t off, void *dst, size_t len,
+				int num_calls)
+{
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(partition), off + len);
+
+	memcpy(dst, &partition[off], len);
+
+	return 0;
+}
+
+static int flash_area_write_stub(const struct flash_area *fa, off_t off, const void *src,
+				 size_t len, int num_calls)
+{
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(partition), off + len);
+	TEST_ASSERT_EQUAL(0, off % 4);
+	TEST_ASSERT_EQUAL(0, len % 4);
+
+	/* Flash can only clear bits, so writes must go to erased flash. */
+	for (size_t i = 0; i < len; i++) {
+		TEST_ASSERT_EQUAL_HEX8(0xff, partition[off + i]);
+	}
+
+	memcpy(&partition[off], src, len);
+
+	return 0;
+}
+
+static int flash_area_erase_stub(const struct flash_area *fa, off_t off, size_t len,
+				 int num_calls)
+{
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(partition), off + len);
+
+	memset(&partition[off], 0xff, len);
+
+	return 0;
+}
+
+/* Trace-like data, repeating headers with a changing counter. */
+static void trace_data_fill(void)
+{
+	for (size_t i = 0; i < sizeof(trace_data); i++) {
+		trace_data[i] = (i % 16 < 4) ? (i / 16) & 0xff : i % 16;
+	}
+}
+
+static size_t partition_used(void)
+{
+	size_t used = sizeof(partition);
+
+	while (used && (partition[used - 1] == 0xff)) {
+		used--;
+	}
+
+	return used;
+}
+
+static void trace_write(const uint8_t *data, size_t len)
+{
+	size_t off = 0;
+	int ret;
+
+	while (off < len) {
+		/* Modem traces come in pieces that do not line up with the blocks. */
+		ret = trace_backend_write(&data[off], MIN(len - off, 100));
+		TEST_ASSERT_GREATER_THAN(0, ret);
+		off += ret;
+	}
+}
+
+static size_t trace_read(uint8_t *buf, size_t len)
+{
+	size_t off = 0;
+	int ret;
+
+	while ((ret = nrf_modem_lib_trace_read(&buf[off], MIN(len - off, 60))) > 0) {
+		off += ret;
+	}
+
+	TEST_ASSERT_EQUAL(-ENODATA, ret);
+
+	return off;
+}
+
+void setUp(void)
+{
+	mock_flash_map_Init();
+
+	__wrap_flash_area_open_Stub(flash_area_open_stub);
+	__wrap_flash_area_align_Stub(flash_area_align_stub);
+	__wrap_flash_area_read_Stub(flash_area_read_stub);
+	__wrap_flash_area_write_Stub(flash_area_write_stub);
+	__wrap_flash_area_erase_Stub(flash_area_erase_stub);
+	__wrap_flash_area_close_Ignore();
+
+	trace_data_fill();
+	processed = 0;
+
+	/* Start each test with an empty partition, which is scanned again on init. */
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_trace_clear());
+	TEST_ASSERT_EQUAL(0, trace_backend_deinit());
+}
+
+void tearDown(void)
+{
+	mock_flash_map_Verify();
+}
+
+int test_suiteTearDown(int num_failures)
+{
+	return generic_suiteTearDown(num_failures);
+}
+
+void test_trace_backend_init_flash_efault(void)
+{
+	int ret;
+
+	ret = trace_backend_init(NULL);
+	TEST_ASSERT_EQUAL(-EFAULT, ret);
+}
+
+void test_trace_backend_clear_flash(void)
+{
+	memset(partition, 0, sizeof(partition));
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_trace_clear());
+	TEST_ASSERT_EQUAL(0, partition_used());
+	TEST_ASSERT_EQUAL(-ENODATA, nrf_modem_lib_trace_read(read_data, sizeof(read_data)));
+}
+
+/* Test that the traces are stored compressed and read back as written. */
+void test_trace_backend_write_read_flash(void)
+{
+	size_t len;
+
+	TEST_ASSERT_EQUAL(0, trace_backend_init(callback));
+
+	trace_write(trace_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL(sizeof(trace_data), processed);
+
+	/* The traces of the last block are still in RAM and are written out by the read. */
+	len = trace_read(read_data, sizeof(read_data));
+	TEST_ASSERT_EQUAL(sizeof(trace_data), len);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(trace_data, read_data, len);
+	TEST_ASSERT_LESS_THAN(sizeof(trace_data), partition_used());
+
+	TEST_ASSERT_EQUAL(0, trace_backend_deinit());
+}
+
+/* Test that a corrupt record is skipped and the traces after it are read. */
+void test_trace_backend_read_corrupt_flash(void)
+{
+	size_t len;
+
+	TEST_ASSERT_EQUAL(0, trace_backend_init(callback));
+
+	trace_write(trace_data, sizeof(trace_data));
+	trace_write(trace_data, TRACE_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL(0, trace_backend_deinit());
+
+	/* Corrupt the payload of the first record, once it is in flash. */
+	partition[20] ^= 0x55;
+
+	len = trace_read(read_data, sizeof(read_data));
+	TEST_ASSERT_EQUAL(sizeof(trace_data), len);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(&trace_data[TRACE_BLOCK_SIZE], read_data,
+				      sizeof(trace_data) - TRACE_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(trace_data, &read_data[sizeof(trace_data) - TRACE_BLOCK_SIZE],
+				      TRACE_BLOCK_SIZE);
+}
+
+/* Test that the traces stored before a reset are found and new traces are appended to them. */
+void test_trace_backend_append_flash(void)
+{
+	size_t used;
+	size_t len;
+
+	TEST_ASSERT_EQUAL(0, trace_backend_init(callback));
+	trace_write(trace_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL(0, trace_backend_deinit());
+
+	used = partition_used();
+	TEST_ASSERT_GREATER_THAN(0, used);
+	memcpy(partition_copy, partition, used);
+
+	/* The partition is scanned on init, and the writes go to erased flash after the records. */
+	TEST_ASSERT_EQUAL(0, trace_backend_init(callback));
+	trace_write(trace_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL(0, trace_backend_deinit());
+
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(partition_copy, partition, used);
+	TEST_ASSERT_GREATER_THAN(used, partition_used());
+
+	len = trace_read(read_data, sizeof(read_data));
+	TEST_ASSERT_EQUAL(2 * sizeof(trace_data), len);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(trace_data, read_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(trace_data, &read_data[sizeof(trace_data)],
+				      sizeof(trace_data));
+}
+
+void main(void)
+{
+	(void)unity_main();
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+
+#define PM_MODEM_TRACE_ID 1
+#define PM_MODEM_TRACE_SIZE 0x2000
+
+#endif /* PM_CONFIG_H__ */
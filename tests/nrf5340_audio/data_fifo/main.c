@@ -191,6 +191,116 @@ void test_data_fifo_data_put_size_zero(void)
 	zassert_equal(ret, -EINVAL, "block_lock did not return -EINVAL");
 }
 
+void test_data_fifo_free_out_of_order(void)
+{
+	DATA_FIFO_DEFINE(data_fifo, 4, 128);
+
+	int ret;
+	uint8_t *data_ptr[3];
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(data_ptr); i++) {
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr[i],
+							 K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+		data_ptr[i][0] = i;
+
+		ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr[i], 1);
+		zassert_equal(ret, 0, "block_lock did not return 0");
+	}
+
+	void *data_ptr_read[ARRAY_SIZE(data_ptr)];
+	size_t data_size;
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(data_ptr); i++) {
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, &data_ptr_read[i], &data_size,
+							K_NO_WAIT);
+		zassert_equal(ret, 0, "_last_filled_get did not return 0");
+		zassert_equal(((uint8_t *)data_ptr_read[i])[0], i, "blocks read out of order");
+	}
+
+	internal_test_remaining_elements(&data_fifo, 3, 0, __LINE__);
+
+	/* Free the newest block first, the block must be reusable */
+	ret = data_fifo_block_free(&data_fifo, &data_ptr_read[2]);
+	zassert_equal(ret, 0, "block_free did not return 0");
+	ret = data_fifo_block_free(&data_fifo, &data_ptr_read[0]);
+	zassert_equal(ret, 0, "block_free did not return 0");
+
+	internal_test_remaining_elements(&data_fifo, 1, 0, __LINE__);
+
+	for (uint32_t i = 0; i < 3; i++) {
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr[i],
+							 K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+	}
+
+	internal_test_remaining_elements(&data_fifo, 4, 0, __LINE__);
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr[0], K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "first_vacant_get did not return -ENOMEM");
+
+	ret = data_fifo_pointer_last_filled_get(&data_fifo, &data_ptr_read[0], &data_size,
+						K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, "_last_filled_get did not return -ENOMSG");
+}
+
+void test_data_fifo_watermarks(void)
+{
+	DATA_FIFO_DEFINE(data_fifo, 8, 128);
+
+	int ret;
+	uint8_t *data_ptr;
+	void *data_ptr_read;
+	size_t data_size;
+	uint32_t alloced_max;
+	uint32_t locked_max;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_watermarks_get(&data_fifo, &alloced_max, &locked_max);
+	zassert_equal(ret, 0, "watermarks_get did not return 0");
+	zassert_equal(alloced_max, 0, "alloced_max not zero after init");
+	zassert_equal(locked_max, 0, "locked_max not zero after init");
+
+	for (uint32_t i = 0; i < 3; i++) {
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+		ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr, 1);
+		zassert_equal(ret, 0, "block_lock did not return 0");
+	}
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	for (uint32_t i = 0; i < 3; i++) {
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, &data_ptr_read, &data_size,
+							K_NO_WAIT);
+		zassert_equal(ret, 0, "_last_filled_get did not return 0");
+		ret = data_fifo_block_free(&data_fifo, &data_ptr_read);
+		zassert_equal(ret, 0, "block_free did not return 0");
+	}
+
+	ret = data_fifo_watermarks_get(&data_fifo, &alloced_max, &locked_max);
+	zassert_equal(ret, 0, "watermarks_get did not return 0");
+	zassert_equal(alloced_max, 4, "alloced_max %d", alloced_max);
+	zassert_equal(locked_max, 3, "locked_max %d", locked_max);
+
+	/* Watermarks are kept when the FIFO is emptied */
+	ret = data_fifo_empty(&data_fifo);
+	zassert_equal(ret, 0, "empty did not return 0");
+
+	internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+
+	ret = data_fifo_watermarks_get(&data_fifo, &alloced_max, &locked_max);
+	zassert_equal(ret, 0, "watermarks_get did not return 0");
+	zassert_equal(alloced_max, 4, "alloced_max %d", alloced_max);
+	zassert_equal(locked_max, 3, "locked_max %d", locked_max);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_suite_data_fifo,
@@ -198,7 +308,9 @@ void test_main(void)
 		ztest_unit_test(test_data_fifo_data_put_get_ok),
 		ztest_unit_test(test_data_fifo_data_put_too_many),
 		ztest_unit_test(test_data_fifo_data_put_too_much_data),
-		ztest_unit_test(test_data_fifo_data_put_size_zero)
+		ztest_unit_test(test_data_fifo_data_put_size_zero),
+		ztest_unit_test(test_data_fifo_free_out_of_order),
+		ztest_unit_test(test_data_fifo_watermarks)
 	);
 
 	ztest_run_test_suite(test_suite_data_fifo);
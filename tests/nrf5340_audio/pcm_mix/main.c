@@ -6,6 +6,7 @@
 
 #include <ztest.h>
 #include <errno.h>
+#include <string.h>
 #include "pcm_mix.h"
 
 #define ZEQ(a, b) zassert_equal(a, b, "fail")
@@ -127,6 +128,198 @@ void test_mono_into_stereo_r(void)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+void test_mix_24_bit(void)
+{
+	int ret;
+	/* Packed 24-bit samples: 0x7FFFF0, 0x000010, 0x800005 */
+	uint8_t sample_a[] = { 0xF0, 0xFF, 0x7F, 0x10, 0x00, 0x00, 0x05, 0x00, 0x80 };
+	/* 0x000020, 0xFFFFF0 (-16), 0xFFFFF0 (-16) */
+	uint8_t sample_b[] = { 0x20, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xF0, 0xFF, 0xFF };
+	/* Clipped to max, 0, clipped to min */
+	uint8_t sample_r[] = { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80 };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+				B_MONO_INTO_A_MONO, 24);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r), "fail");
+}
+
+void test_mix_32_bit(void)
+{
+	int ret;
+	int32_t sample_a[] = { INT32_MAX, INT32_MIN, 100, -100 };
+	int32_t sample_b[] = { 1, INT32_MIN };
+	int32_t sample_r[] = { INT32_MAX, INT32_MIN + 1, INT32_MIN + 100, INT32_MIN };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+				B_MONO_INTO_A_STEREO_LR, 32);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r), "fail");
+}
+
+void test_invalid_bit_depth(void)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1, 2 };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_a, sizeof(sample_a),
+				B_MONO_INTO_A_MONO, 8);
+	ZEQ(ret, -EINVAL);
+}
+
+#define REF_MAX_SAMPLES 64
+#define REF_ITERATIONS 100
+
+static uint32_t prng_state = 1;
+
+static uint32_t prng(void)
+{
+	/* Numerical Recipes LCG, deterministic between runs */
+	prng_state = prng_state * 1664525UL + 1013904223UL;
+	return prng_state;
+}
+
+static int32_t ref_load(uint8_t const *p, uint8_t bytes_per_sample)
+{
+	uint32_t val = 0;
+
+	for (uint8_t i = 0; i < bytes_per_sample; i++) {
+		val |= (uint32_t)p[i] << (i * 8);
+	}
+
+	/* Sign extend */
+	return (int32_t)(val << (32 - bytes_per_sample * 8)) >> (32 - bytes_per_sample * 8);
+}
+
+static void ref_store(uint8_t *p, int32_t val, uint8_t bytes_per_sample)
+{
+	for (uint8_t i = 0; i < bytes_per_sample; i++) {
+		p[i] = (uint8_t)(val >> (i * 8));
+	}
+}
+
+static void ref_add(uint8_t *p, int32_t b, uint8_t pcm_bit_depth)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+	int64_t max = (1LL << (pcm_bit_depth - 1)) - 1;
+	int64_t min = -(1LL << (pcm_bit_depth - 1));
+	int64_t res = (int64_t)ref_load(p, bytes_per_sample) + b;
+
+	if (res > max) {
+		res = max;
+	} else if (res < min) {
+		res = min;
+	}
+
+	ref_store(p, (int32_t)res, bytes_per_sample);
+}
+
+/* Scalar reference, one sample at a time */
+static void ref_mix(uint8_t *pcm_a, uint8_t const *pcm_b, size_t samples_b,
+		    enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth)
+{
+	uint8_t bps = pcm_bit_depth / 8;
+
+	for (size_t i = 0; i < samples_b; i++) {
+		int32_t b = ref_load(&pcm_b[i * bps], bps);
+
+		switch (mix_mode) {
+		case B_STEREO_INTO_A_STEREO:
+		case B_MONO_INTO_A_MONO:
+			ref_add(&pcm_a[i * bps], b, pcm_bit_depth);
+			break;
+		case B_MONO_INTO_A_STEREO_LR:
+			ref_add(&pcm_a[i * 2 * bps], b, pcm_bit_depth);
+			ref_add(&pcm_a[(i * 2 + 1) * bps], b, pcm_bit_depth);
+			break;
+		case B_MONO_INTO_A_STEREO_L:
+			ref_add(&pcm_a[i * 2 * bps], b, pcm_bit_depth);
+			break;
+		case B_MONO_INTO_A_STEREO_R:
+			ref_add(&pcm_a[(i * 2 + 1) * bps], b, pcm_bit_depth);
+			break;
+		}
+	}
+}
+
+static void fill_random(uint8_t *buf, size_t size)
+{
+	for (size_t i = 0; i < size; i++) {
+		buf[i] = (uint8_t)(prng() >> 24);
+	}
+}
+
+void test_mix_matches_reference(void)
+{
+	static const uint8_t bit_depths[] = { 16, 24, 32 };
+	static const enum pcm_mix_mode modes[] = {
+		B_STEREO_INTO_A_STEREO, B_MONO_INTO_A_MONO, B_MONO_INTO_A_STEREO_LR,
+		B_MONO_INTO_A_STEREO_L, B_MONO_INTO_A_STEREO_R
+	};
+	static uint8_t pcm_a[REF_MAX_SAMPLES * 2 * sizeof(int32_t)];
+	static uint8_t pcm_r[REF_MAX_SAMPLES * 2 * sizeof(int32_t)];
+	static uint8_t pcm_b[REF_MAX_SAMPLES * sizeof(int32_t)];
+
+	for (size_t d = 0; d < ARRAY_SIZE(bit_depths); d++) {
+		uint8_t bps = bit_depths[d] / 8;
+
+		for (size_t m = 0; m < ARRAY_SIZE(modes); m++) {
+			for (size_t it = 0; it < REF_ITERATIONS; it++) {
+				/* Odd number of samples is used to test the scalar tail */
+				size_t samples_b = (prng() % REF_MAX_SAMPLES) + 1;
+				size_t samples_a = (modes[m] >= B_MONO_INTO_A_STEREO_LR) ?
+						   (samples_b * 2) : samples_b;
+				int ret;
+
+				fill_random(pcm_a, sizeof(pcm_a));
+				fill_random(pcm_b, sizeof(pcm_b));
+				memcpy(pcm_r, pcm_a, sizeof(pcm_r));
+
+				ref_mix(pcm_r, pcm_b, samples_b, modes[m], bit_depths[d]);
+				ret = pcm_mix_bit_depth(pcm_a, samples_a * bps, pcm_b,
+							samples_b * bps, modes[m], bit_depths[d]);
+				ZEQ(ret, 0);
+
+				zassert_mem_equal(pcm_a, pcm_r, sizeof(pcm_r),
+						  "Mismatch: bit depth %d, mode %d, samples %d",
+						  bit_depths[d], modes[m], samples_b);
+			}
+		}
+	}
+}
+
+#define BENCH_SAMPLES 960
+#define BENCH_ITERATIONS 20
+
+void test_mix_benchmark(void)
+{
+	static int16_t pcm_a[BENCH_SAMPLES * 2];
+	static int16_t pcm_b[BENCH_SAMPLES];
+	uint32_t simd_cycles = 0;
+	uint32_t ref_cycles = 0;
+	uint32_t start;
+
+	fill_random((uint8_t *)pcm_a, sizeof(pcm_a));
+	fill_random((uint8_t *)pcm_b, sizeof(pcm_b));
+
+	for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+		start = k_cycle_get_32();
+		(void)pcm_mix(pcm_a, sizeof(pcm_a), pcm_b, sizeof(pcm_b),
+			      B_MONO_INTO_A_STEREO_LR);
+		simd_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		ref_mix((uint8_t *)pcm_a, (uint8_t *)pcm_b, BENCH_SAMPLES,
+			B_MONO_INTO_A_STEREO_LR, 16);
+		ref_cycles += k_cycle_get_32() - start;
+	}
+
+	printk("Mono into stereo 16-bit, %d samples: pcm_mix %u cycles, reference %u cycles\n",
+	       BENCH_SAMPLES, simd_cycles / BENCH_ITERATIONS, ref_cycles / BENCH_ITERATIONS);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_suite_pcm_mix,
@@ -137,7 +330,12 @@ void test_main(void)
 		ztest_unit_test(test_high_values),
 		ztest_unit_test(test_mono_into_stereo_lr),
 		ztest_unit_test(test_mono_into_stereo_l),
-		ztest_unit_test(test_mono_into_stereo_r)
+		ztest_unit_test(test_mono_into_stereo_r),
+		ztest_unit_test(test_mix_24_bit),
+		ztest_unit_test(test_mix_32_bit),
+		ztest_unit_test(test_invalid_bit_depth),
+		ztest_unit_test(test_mix_matches_reference),
+		ztest_unit_test(test_mix_benchmark)
 	);
 
 	ztest_run_test_suite(test_suite_pcm_mix);
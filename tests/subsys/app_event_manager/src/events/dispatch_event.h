@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _DISPATCH_EVENT_H_
+#define _DISPATCH_EVENT_H_
+
+/**
+ * @brief Dispatch Event
+ * @defgroup dispatch_event Event used to test event dispatching
+ * @{
+ */
+
+#include <app_event_manager.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct dispatch_event {
+	struct app_event_header header;
+
+	/* Index of the listener that consumes the event. */
+	uint32_t consumer;
+};
+
+APP_EVENT_TYPE_DECLARE(dispatch_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _DISPATCH_EVENT_H_ */
@@ -28,6 +28,7 @@ enum test_id {
 	TEST_SUBSCRIBER_ORDER,
 	TEST_OOM,
 	TEST_MULTICONTEXT,
+	TEST_PRIORITY_LANES,
 
 	TEST_CNT
 };
@@ -9,6 +9,8 @@
 
 #include "sized_events.h"
 #include "test_events.h"
+#include "test_config.h"
+#include "test_dispatch.h"
 
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
@@ -77,6 +79,44 @@ static void test_multicontext(void)
 	test_start(TEST_MULTICONTEXT);
 }
 
+static void test_priority_lanes(void)
+{
+	test_start(TEST_PRIORITY_LANES);
+
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)) {
+		return;
+	}
+
+	struct app_event_manager_lane_stats stats;
+	int err = app_event_manager_lane_stats_get(APP_EVENT_MANAGER_LANE_HIGH, &stats);
+
+	zassert_equal(err, 0, "Cannot get lane statistics");
+	zassert_equal(stats.processed_cnt, TEST_PRIORITY_EVENT_CNT,
+		      "Unexpected number of high priority events");
+	zassert_equal(stats.depth, 0, "High priority lane should be empty");
+	zassert_true(stats.max_depth >= 1, "Unexpected lane maximum depth");
+}
+
+static void test_dispatch_table(void)
+{
+	test_dispatch_table_run();
+}
+
+static void test_dispatch_order(void)
+{
+	test_dispatch_order_run();
+}
+
+static void test_dispatch_consume(void)
+{
+	test_dispatch_consume_run();
+}
+
+static void test_dispatch_benchmark(void)
+{
+	test_dispatch_benchmark_run();
+}
+
 static void test_event_size_static(void)
 {
 	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROVIDE_EVENT_SIZE)) {
@@ -92,22 +132,22 @@ static void test_event_size_static(void)
 	ev_s1 = new_test_size1_event();
 	zassert_equal(sizeof(*ev_s1), app_event_manager_event_size(&ev_s1->header),
 		"Event size1 unexpected size");
-	app_event_manager_free(ev_s1);
+	APP_EVENT_FREE(ev_s1);
 
 	ev_s2 = new_test_size2_event();
 	zassert_equal(sizeof(*ev_s2), app_event_manager_event_size(&ev_s2->header),
 		"Event size2 unexpected size");
-	app_event_manager_free(ev_s2);
+	APP_EVENT_FREE(ev_s2);
 
 	ev_s3 = new_test_size3_event();
 	zassert_equal(sizeof(*ev_s3), app_event_manager_event_size(&ev_s3->header),
 		"Event size3 unexpected size");
-	app_event_manager_free(ev_s3);
+	APP_EVENT_FREE(ev_s3);
 
 	ev_sb = new_test_size_big_event();
 	zassert_equal(sizeof(*ev_sb), app_event_manager_event_size(&ev_sb->header),
 		"Event size_big unexpected size");
-	app_event_manager_free(ev_sb);
+	APP_EVENT_FREE(ev_sb);
 }
 
 static void test_event_size_dynamic(void)
@@ -122,17 +162,17 @@ static void test_event_size_dynamic(void)
 	ev = new_test_dynamic_event(0);
 	zassert_equal(sizeof(*ev) + 0, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 0 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 
 	ev = new_test_dynamic_event(10);
 	zassert_equal(sizeof(*ev) + 10, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 10 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 
 	ev = new_test_dynamic_event(100);
 	zassert_equal(sizeof(*ev) + 100, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 100 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 }
 
 static void test_event_size_dynamic_with_data(void)
@@ -147,17 +187,17 @@ static void test_event_size_dynamic_with_data(void)
 	ev = new_test_dynamic_with_data_event(0);
 	zassert_equal(sizeof(*ev) + 0, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 0 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 
 	ev = new_test_dynamic_with_data_event(10);
 	zassert_equal(sizeof(*ev) + 10, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 10 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 
 	ev = new_test_dynamic_with_data_event(100);
 	zassert_equal(sizeof(*ev) + 100, app_event_manager_event_size(&ev->header),
 		"Event dynamic with 100 elements unexpected size");
-	app_event_manager_free(ev);
+	APP_EVENT_FREE(ev);
 }
 
 static void test_event_size_disabled(void)
@@ -175,7 +215,45 @@ static void test_event_size_disabled(void)
 		"Event size1 unexpected size");
 	zassert_false(expect_assert,
 		"Assertion during app_event_manager_event_size function execution was expected");
-	app_event_manager_free(ev_s1);
+	APP_EVENT_FREE(ev_s1);
+}
+
+static void test_event_pools(void)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct test_size1_event *ev_tab[CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE + 1];
+	struct app_event_manager_pool_stats stats;
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(ev_tab); i++) {
+		ev_tab[i] = new_test_size1_event();
+		zassert_not_null(ev_tab[i], "Event allocation failed");
+	}
+
+	err = app_event_manager_pool_stats_get(_EVENT_ID(test_size1_event), &stats);
+	zassert_equal(err, 0, "Cannot get pool statistics");
+	zassert_equal(stats.block_cnt, CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE,
+		      "Unexpected pool size");
+	zassert_equal(stats.used_cnt, CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE,
+		      "Pool should be exhausted");
+	zassert_equal(stats.max_used_cnt, CONFIG_APP_EVENT_MANAGER_EVENT_POOL_SIZE,
+		      "Unexpected pool high-water mark");
+	zassert_equal(stats.heap_fallback_cnt, 1, "Expected single heap fallback");
+
+	for (size_t i = 0; i < ARRAY_SIZE(ev_tab); i++) {
+		APP_EVENT_FREE(ev_tab[i]);
+	}
+
+	err = app_event_manager_pool_stats_get(_EVENT_ID(test_size1_event), &stats);
+	zassert_equal(err, 0, "Cannot get pool statistics");
+	zassert_equal(stats.used_cnt, 0, "Pool blocks not released");
+
+	err = app_event_manager_pool_stats_get(_EVENT_ID(test_dynamic_event), &stats);
+	zassert_equal(err, -ENOENT, "Events with dynamic data should not use pool");
 }
 
 void test_main(void)
@@ -188,10 +266,16 @@ void test_main(void)
 			 ztest_unit_test(test_subs_order),
 			 ztest_unit_test(test_oom),
 			 ztest_unit_test(test_multicontext),
+			 ztest_unit_test(test_priority_lanes),
+			 ztest_unit_test(test_dispatch_table),
+			 ztest_unit_test(test_dispatch_order),
+			 ztest_unit_test(test_dispatch_consume),
+			 ztest_unit_test(test_dispatch_benchmark),
 			 ztest_unit_test(test_event_size_static),
 			 ztest_unit_test(test_event_size_dynamic),
 			 ztest_unit_test(test_event_size_dynamic_with_data),
-			 ztest_unit_test(test_event_size_disabled)
+			 ztest_unit_test(test_event_size_disabled),
+			 ztest_unit_test(test_event_pools)
 			 );
 
 	ztest_run_test_suite(app_event_manager_tests);
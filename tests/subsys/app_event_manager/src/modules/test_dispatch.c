@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <ztest.h>
+
+#include "dispatch_event.h"
+#include "test_dispatch.h"
+
+enum dispatch_listener {
+	DISPATCH_FIRST,
+	DISPATCH_EARLY,
+	DISPATCH_NORMAL,
+	DISPATCH_FINAL,
+
+	DISPATCH_LISTENER_CNT
+};
+
+static const char * const listener_names[] = {
+	[DISPATCH_FIRST] = "dispatch_first",
+	[DISPATCH_EARLY] = "dispatch_early",
+	[DISPATCH_NORMAL] = "dispatch_normal",
+	[DISPATCH_FINAL] = "dispatch_final",
+};
+
+#define BENCH_ITERATIONS	1000
+
+static K_SEM_DEFINE(dispatch_done_sem, 0, 1);
+static enum dispatch_listener notified[DISPATCH_LISTENER_CNT];
+static size_t notified_cnt;
+
+static bool bench_running;
+static uint32_t bench_notify_cnt;
+
+
+static bool notify(const struct app_event_header *aeh, enum dispatch_listener listener)
+{
+	const struct dispatch_event *event = cast_dispatch_event(aeh);
+	bool consume = (event->consumer == listener);
+
+	if (bench_running) {
+		bench_notify_cnt++;
+		return false;
+	}
+
+	zassert_true(notified_cnt < ARRAY_SIZE(notified), "Listener notified too many times");
+	notified[notified_cnt++] = listener;
+
+	if (consume || (listener == DISPATCH_FINAL)) {
+		k_sem_give(&dispatch_done_sem);
+	}
+
+	return consume;
+}
+
+static bool dispatch_first_handler(const struct app_event_header *aeh)
+{
+	return notify(aeh, DISPATCH_FIRST);
+}
+
+static bool dispatch_early_handler(const struct app_event_header *aeh)
+{
+	return notify(aeh, DISPATCH_EARLY);
+}
+
+static bool dispatch_normal_handler(const struct app_event_header *aeh)
+{
+	return notify(aeh, DISPATCH_NORMAL);
+}
+
+static bool dispatch_final_handler(const struct app_event_header *aeh)
+{
+	return notify(aeh, DISPATCH_FINAL);
+}
+
+/* Subscribed in reverse order to make sure the order comes from the priorities. */
+APP_EVENT_LISTENER(dispatch_final, dispatch_final_handler);
+APP_EVENT_SUBSCRIBE_FINAL(dispatch_final, dispatch_event);
+
+APP_EVENT_LISTENER(dispatch_normal, dispatch_normal_handler);
+APP_EVENT_SUBSCRIBE(dispatch_normal, dispatch_event);
+
+APP_EVENT_LISTENER(dispatch_early, dispatch_early_handler);
+APP_EVENT_SUBSCRIBE_EARLY(dispatch_early, dispatch_event);
+
+APP_EVENT_LISTENER(dispatch_first, dispatch_first_handler);
+APP_EVENT_SUBSCRIBE_FIRST(dispatch_first, dispatch_event);
+
+
+static void dispatch(enum dispatch_listener consumer)
+{
+	struct dispatch_event *event = new_dispatch_event();
+
+	zassert_not_null(event, "Cannot allocate event");
+
+	notified_cnt = 0;
+	event->consumer = consumer;
+	APP_EVENT_SUBMIT(event);
+
+	int err = k_sem_take(&dispatch_done_sem, K_SECONDS(1));
+
+	zassert_equal(err, 0, "Event not dispatched");
+}
+
+void test_dispatch_table_run(void)
+{
+	const struct event_type *et = _EVENT_ID(dispatch_event);
+	size_t idx = 0;
+
+	zassert_equal(et->subs_stop - et->subs_start, DISPATCH_LISTENER_CNT,
+		      "Unexpected number of subscribers");
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     es != et->subs_stop;
+	     es++, idx++) {
+		const struct event_listener *el = _event_listener_get(es);
+
+		zassert_not_null(es->notification, "No handler in subscriber");
+		zassert_not_null(el, "No listener found for subscriber");
+		zassert_equal(el->notification, es->notification, "Listener mismatch");
+		zassert_equal(strcmp(el->name, listener_names[idx]), 0,
+			      "Subscriber %zu is %s, expected %s", idx, el->name,
+			      listener_names[idx]);
+	}
+}
+
+void test_dispatch_order_run(void)
+{
+	dispatch(DISPATCH_LISTENER_CNT);
+
+	zassert_equal(notified_cnt, DISPATCH_LISTENER_CNT, "Not all listeners were notified");
+
+	for (size_t i = 0; i < notified_cnt; i++) {
+		zassert_equal(notified[i], i, "Listener %s notified at position %zu",
+			      listener_names[notified[i]], i);
+	}
+}
+
+void test_dispatch_consume_run(void)
+{
+	for (enum dispatch_listener consumer = DISPATCH_FIRST;
+	     consumer < DISPATCH_LISTENER_CNT;
+	     consumer++) {
+		dispatch(consumer);
+
+		zassert_equal(notified_cnt, consumer + 1,
+			      "Listeners notified after %s consumed the event",
+			      listener_names[consumer]);
+		zassert_equal(notified[consumer], consumer, "Wrong listener consumed the event");
+	}
+}
+
+/* Subscriber record as it was before the handlers were placed in the
+ * subscriber array, reaching the handler through the listener.
+ */
+struct listener_subscriber {
+	const struct event_listener *listener;
+};
+
+static struct listener_subscriber listener_subs[DISPATCH_LISTENER_CNT];
+
+/* Dispatch through the listener of each subscriber, as done previously. */
+static void dispatch_listener_walk(const struct app_event_header *aeh)
+{
+	bool consumed = false;
+
+	for (const struct listener_subscriber *ls = listener_subs;
+	     (ls != &listener_subs[ARRAY_SIZE(listener_subs)]) && !consumed;
+	     ls++) {
+		consumed = ls->listener->notification(aeh);
+	}
+}
+
+/* Dispatch through the handlers stored in the subscriber array. */
+static void dispatch_handler_table(const struct app_event_header *aeh)
+{
+	const struct event_type *et = aeh->type_id;
+	bool consumed = false;
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
+		consumed = es->notification(aeh);
+	}
+}
+
+static uint32_t bench_run(void (*dispatch_fn)(const struct app_event_header *aeh),
+			  const struct app_event_header *aeh)
+{
+	uint32_t start;
+	uint32_t cycles;
+	unsigned int key;
+
+	bench_notify_cnt = 0;
+
+	key = irq_lock();
+	start = k_cycle_get_32();
+
+	for (size_t i = 0; i < BENCH_ITERATIONS; i++) {
+		dispatch_fn(aeh);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	irq_unlock(key);
+
+	zassert_equal(bench_notify_cnt, BENCH_ITERATIONS * DISPATCH_LISTENER_CNT,
+		      "Not all listeners were notified");
+
+	return cycles;
+}
+
+void test_dispatch_benchmark_run(void)
+{
+	struct dispatch_event *event = new_dispatch_event();
+	const struct event_type *et = event->header.type_id;
+	uint32_t walk_cycles;
+	uint32_t table_cycles;
+	size_t idx = 0;
+
+	zassert_equal(et->subs_stop - et->subs_start, DISPATCH_LISTENER_CNT,
+		      "Unexpected number of subscribers");
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     es != et->subs_stop;
+	     es++, idx++) {
+		listener_subs[idx].listener = _event_listener_get(es);
+		zassert_not_null(listener_subs[idx].listener, "No listener found for subscriber");
+	}
+
+	/* No listener consumes the event, so every listener is notified. */
+	event->consumer = DISPATCH_LISTENER_CNT;
+	bench_running = true;
+
+	walk_cycles = bench_run(dispatch_listener_walk, &event->header);
+	table_cycles = bench_run(dispatch_handler_table, &event->header);
+
+	bench_running = false;
+	APP_EVENT_FREE(event);
+
+	printk("Dispatch cost per event (%d listeners): listener walk %u cycles, "
+	       "handler table %u cycles\n",
+	       DISPATCH_LISTENER_CNT,
+	       walk_cycles / BENCH_ITERATIONS,
+	       table_cycles / BENCH_ITERATIONS);
+}
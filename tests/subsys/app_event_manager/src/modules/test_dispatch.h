@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _TEST_DISPATCH_H_
+#define _TEST_DISPATCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Check that the subscriber array of an event type holds the
+ *  handlers of all its listeners, ordered by subscription priority.
+ */
+void test_dispatch_table_run(void);
+
+/** @brief Check that all listeners are notified in order of priority. */
+void test_dispatch_order_run(void);
+
+/** @brief Check that no listener is notified after the event is consumed. */
+void test_dispatch_consume_run(void);
+
+/** @brief Time the dispatch of an event through the subscriber array and
+ *  through the listener of each subscriber, and print both.
+ */
+void test_dispatch_benchmark_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TEST_DISPATCH_H_ */
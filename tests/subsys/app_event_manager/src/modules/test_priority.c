@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <ztest.h>
+
+#include "test_events.h"
+#include "priority_events.h"
+
+#include "test_config.h"
+
+#define MODULE test_priority
+
+enum prio_class {
+	PRIO_HIGH,
+	PRIO_NORMAL,
+	PRIO_LOW,
+
+	PRIO_CNT
+};
+
+static size_t recv_cnt;
+static size_t recv_cnt_per_class[PRIO_CNT];
+static enum prio_class last_class;
+
+
+static void submit_events(void)
+{
+	/* Submit events in order opposite to their priorities. */
+	for (size_t i = 0; i < TEST_PRIORITY_EVENT_CNT; i++) {
+		struct low_prio_event *event = new_low_prio_event();
+
+		event->val = i;
+		APP_EVENT_SUBMIT(event);
+	}
+
+	for (size_t i = 0; i < TEST_PRIORITY_EVENT_CNT; i++) {
+		struct normal_prio_event *event = new_normal_prio_event();
+
+		event->val = i;
+		APP_EVENT_SUBMIT(event);
+	}
+
+	for (size_t i = 0; i < TEST_PRIORITY_EVENT_CNT; i++) {
+		struct high_prio_event *event = new_high_prio_event();
+
+		event->val = i;
+		APP_EVENT_SUBMIT(event);
+	}
+}
+
+static void handle_prio_event(enum prio_class class, int val)
+{
+	if (recv_cnt == 0) {
+		last_class = class;
+	}
+
+	/* Events of the given class must be received in order. */
+	zassert_equal(recv_cnt_per_class[class], val, "Wrong event order within lane");
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_LANES)) {
+		zassert_true(class >= last_class, "Lower priority event processed first");
+	} else {
+		zassert_true(class <= last_class, "Events processed out of submission order");
+	}
+
+	last_class = class;
+	recv_cnt_per_class[class]++;
+	recv_cnt++;
+
+	if (recv_cnt == (PRIO_CNT * TEST_PRIORITY_EVENT_CNT)) {
+		struct test_end_event *te = new_test_end_event();
+
+		te->test_id = TEST_PRIORITY_LANES;
+		APP_EVENT_SUBMIT(te);
+	}
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *st = cast_test_start_event(aeh);
+
+		if (st->test_id == TEST_PRIORITY_LANES) {
+			submit_events();
+		}
+
+		return false;
+	}
+
+	if (is_high_prio_event(aeh)) {
+		handle_prio_event(PRIO_HIGH, cast_high_prio_event(aeh)->val);
+		return false;
+	}
+
+	if (is_normal_prio_event(aeh)) {
+		handle_prio_event(PRIO_NORMAL, cast_normal_prio_event(aeh)->val);
+		return false;
+	}
+
+	if (is_low_prio_event(aeh)) {
+		handle_prio_event(PRIO_LOW, cast_low_prio_event(aeh)->val);
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, test_start_event);
+APP_EVENT_SUBSCRIBE(MODULE, high_prio_event);
+APP_EVENT_SUBSCRIBE(MODULE, normal_prio_event);
+APP_EVENT_SUBSCRIBE(MODULE, low_prio_event);
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <mesh/net.h>
+#include <mesh/rpl.h>
+#include <emds/emds.h>
+
+#define RPL_SIZE CONFIG_BT_MESH_CRPL
+#define BENCHMARK_CHECKS 10000
+
+static struct bt_mesh_rpl *replay_list;
+static size_t replay_list_len;
+
+/* Copy of the replay list, scanned the way the list was searched before it
+ * was indexed, to compare the cost of a check.
+ */
+static struct bt_mesh_rpl linear_list[RPL_SIZE];
+
+static struct bt_mesh_net_rx rx_get(uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct bt_mesh_net_rx rx = {
+		.ctx.addr = src,
+		.seq = seq,
+		.old_iv = old_iv,
+		.local_match = true,
+		.net_if = BT_MESH_NET_IF_ADV,
+	};
+
+	return rx;
+}
+
+static bool check(uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct bt_mesh_net_rx rx = rx_get(src, seq, old_iv);
+
+	return bt_mesh_rpl_check(&rx, NULL);
+}
+
+static bool linear_check(uint16_t src, uint32_t seq)
+{
+	for (int i = 0; i < ARRAY_SIZE(linear_list); i++) {
+		struct bt_mesh_rpl *rpl = &linear_list[i];
+
+		if (!rpl->src) {
+			rpl->src = src;
+			rpl->seq = seq;
+			return false;
+		}
+
+		if (rpl->src == src) {
+			if (rpl->seq < seq) {
+				rpl->seq = seq;
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	return true;
+}
+
+static void fill(void)
+{
+	for (uint16_t src = 1; src <= RPL_SIZE; src++) {
+		zassert_false(check(src, 1, false), "Rejected 0x%04x", src);
+	}
+}
+
+static void setup(void)
+{
+	bt_mesh_rpl_clear();
+}
+
+static void teardown(void)
+{
+}
+
+static void test_storage_layout(void)
+{
+	/* The index is not stored, the entry is the replay list as before. */
+	zassert_not_null(replay_list, "No RPL entry in the emergency data storage");
+	zassert_equal(replay_list_len, RPL_SIZE * sizeof(struct bt_mesh_rpl), "Wrong RPL size");
+}
+
+static void test_replay(void)
+{
+	zassert_false(check(0x0001, 10, false), "New source rejected");
+	zassert_true(check(0x0001, 10, false), "Replay accepted");
+	zassert_true(check(0x0001, 9, false), "Old sequence number accepted");
+	zassert_false(check(0x0001, 11, false), "New sequence number rejected");
+	zassert_false(check(0x0002, 10, false), "New source rejected");
+	zassert_true(check(0x0002, 10, false), "Replay accepted");
+
+	/* Messages on the old IV index after the new one are replays. */
+	zassert_true(check(0x0001, 12, true), "Old IV index accepted");
+
+	bt_mesh_rpl_reset();
+	zassert_false(check(0x0001, 1, false), "New IV index rejected");
+	zassert_true(check(0x0002, 10, true), "Replay on old IV index accepted");
+	zassert_false(check(0x0002, 12, true), "Old IV index rejected");
+
+	/* Entries that were not updated on the new IV index are discarded. */
+	bt_mesh_rpl_reset();
+	zassert_equal(replay_list[0].src, 0x0001, "Entry not kept");
+	zassert_equal(replay_list[1].src, 0, "Entry not discarded");
+}
+
+static void test_segmented(void)
+{
+	struct bt_mesh_net_rx rx = rx_get(0x0003, 5, false);
+	struct bt_mesh_rpl *rpl = NULL;
+
+	zassert_false(bt_mesh_rpl_check(&rx, &rpl), "New source rejected");
+	zassert_equal_ptr(rpl, &replay_list[0], "Wrong slot");
+	zassert_equal(rpl->src, 0, "Slot updated before the message is complete");
+
+	bt_mesh_rpl_update(rpl, &rx);
+	zassert_true(check(0x0003, 5, false), "Replay accepted");
+	zassert_false(check(0x0004, 5, false), "New source rejected");
+	zassert_equal(replay_list[1].src, 0x0004, "Wrong slot");
+}
+
+static void test_full(void)
+{
+	fill();
+
+	zassert_true(check(RPL_SIZE + 1, 1, false), "Source accepted with full RPL");
+
+	for (uint16_t src = 1; src <= RPL_SIZE; src++) {
+		zassert_true(check(src, 1, false), "Replay from 0x%04x accepted", src);
+		zassert_false(check(src, 2, false), "Message from 0x%04x rejected", src);
+	}
+
+	bt_mesh_rpl_reset();
+	bt_mesh_rpl_reset();
+	zassert_false(check(RPL_SIZE + 1, 1, false), "Source rejected with empty RPL");
+}
+
+static void test_restore(void)
+{
+	/* Restore the list like the emergency data storage does, with gaps left
+	 * by earlier versions.
+	 */
+	replay_list[1].src = 0x0010;
+	replay_list[1].seq = 100;
+	replay_list[4].src = 0x0020;
+	replay_list[4].seq = 200;
+
+	zassert_true(check(0x0020, 200, false), "Replay accepted");
+	zassert_true(check(0x0010, 99, false), "Replay accepted");
+	zassert_equal(replay_list[0].src, 0x0010, "List not compacted");
+	zassert_equal(replay_list[1].src, 0x0020, "List not compacted");
+
+	zassert_false(check(0x0030, 1, false), "New source rejected");
+	zassert_equal(replay_list[2].src, 0x0030, "Wrong slot");
+}
+
+static void test_benchmark(void)
+{
+	uint32_t seq = 2;
+	uint32_t start;
+	uint32_t indexed;
+	uint32_t linear;
+
+	fill();
+	(void)memset(linear_list, 0, sizeof(linear_list));
+	for (uint16_t src = 1; src <= RPL_SIZE; src++) {
+		(void)linear_check(src, 1);
+	}
+
+	/* Sources in random order, the same for both lists. */
+	srand(RPL_SIZE);
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_CHECKS; i++) {
+		zassert_false(check(1 + (rand() % RPL_SIZE), seq++, false), "Rejected");
+	}
+	indexed = k_cycle_get_32() - start;
+
+	srand(RPL_SIZE);
+	seq = 2;
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_CHECKS; i++) {
+		zassert_false(linear_check(1 + (rand() % RPL_SIZE), seq++), "Rejected");
+	}
+	linear = k_cycle_get_32() - start;
+
+	printk("RPL size %d: %llu ns per check, %llu ns with linear scan\n", RPL_SIZE,
+	       k_cyc_to_ns_floor64(indexed) / BENCHMARK_CHECKS,
+	       k_cyc_to_ns_floor64(linear) / BENCHMARK_CHECKS);
+}
+
+void test_main(void)
+{
+	STRUCT_SECTION_FOREACH(emds_entry, entry) {
+		if (entry->id == CONFIG_BT_MESH_RPL_INDEX) {
+			replay_list = (struct bt_mesh_rpl *)entry->data;
+			replay_list_len = entry->len;
+		}
+	}
+
+	ztest_test_suite(rpl_test,
+		ztest_unit_test(test_storage_layout),
+		ztest_unit_test_setup_teardown(test_replay, setup, teardown),
+		ztest_unit_test_setup_teardown(test_segmented, setup, teardown),
+		ztest_unit_test_setup_teardown(test_full, setup, teardown),
+		ztest_unit_test_setup_teardown(test_restore, setup, teardown),
+		ztest_unit_test_setup_teardown(test_benchmark, setup, teardown)
+	);
+
+	ztest_run_test_suite(rpl_test);
+}
@@ -9,6 +9,7 @@
 
 #include "test_events.h"
 #include <caf/events/sensor_event.h>
+#include <caf/sensor_data_aggregator.h>
 #include "test_config.h"
 #include <zephyr/drivers/sensor.h>
 
@@ -100,6 +101,41 @@ static void test_status(void)
 	test_start(TEST_STATUS);
 }
 
+static void test_direct(void)
+{
+	struct sensor_data_aggregator *agg = sensor_data_aggregator_get(DIRECT_TEST_AGG_DESCR);
+	const size_t sample_size = sizeof(struct sensor_value) * DIRECT_TEST_SENSOR_SAMPLE_SIZE;
+
+	zassert_not_null(agg, "No aggregator found");
+	zassert_is_null(sensor_data_aggregator_get("void_unknown_sensor"),
+			"Aggregator found for unknown sensor");
+	zassert_is_null(sensor_data_aggregator_sample_claim(agg, sample_size + 1),
+			"Sample of wrong size claimed");
+
+	cur_test_id = TEST_DIRECT;
+	struct test_start_event *ts = new_test_start_event();
+
+	zassert_not_null(ts, "Failed to allocate event");
+	ts->test_id = cur_test_id;
+	APP_EVENT_SUBMIT(ts);
+
+	for (size_t i = 0; i < SAMPLES_IN_AGG_BUF * DIRECT_TEST_AGG_EVENTS; i++) {
+		struct sensor_value *sample;
+
+		sample = sensor_data_aggregator_sample_claim(agg, sample_size);
+		zassert_not_null(sample, "No buffer for the sample");
+
+		sample->val1 = i;
+		sample->val2 = 0;
+		zassert_ok(sensor_data_aggregator_sample_commit(agg, sample),
+			   "Sample not committed");
+	}
+
+	int err = k_sem_take(&test_end_sem, K_SECONDS(30));
+
+	zassert_ok(err, "Test execution hanged");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(caf_sensor_aggregator_tests,
@@ -107,7 +143,8 @@ void test_main(void)
 			 ztest_unit_test(test_event_manager),
 			 ztest_unit_test(test_basic),
 			 ztest_unit_test(test_order),
-			 ztest_unit_test(test_status)
+			 ztest_unit_test(test_status),
+			 ztest_unit_test(test_direct)
 
 			 );
 
@@ -16,3 +16,6 @@
 #define BASIC_TEST_AGG_DESCR "void_basic_test_sensor"
 #define ORDER_TEST_AGG_DESCR "void_order_test_sensor"
 #define STATUS_TEST_AGG_DESCR "void_status_test_sensor"
+#define DIRECT_TEST_AGG_DESCR "void_direct_test_sensor"
+#define DIRECT_TEST_SENSOR_SAMPLE_SIZE 1
+#define DIRECT_TEST_AGG_EVENTS 3
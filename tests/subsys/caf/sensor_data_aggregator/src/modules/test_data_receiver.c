@@ -19,6 +19,7 @@
 static enum test_id cur_test_id;
 int msg_num;
 int order_event_indicator = SAMPLES_IN_AGG_BUF * ORDER_TEST_AGG_EVENTS;
+int direct_sample_num;
 
 static bool app_event_handler(const struct app_event_header *aeh)
 {
@@ -84,6 +85,26 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			zassert_not_null(te, "Failed to allocate event");
 			te->test_id = cur_test_id;
 			APP_EVENT_SUBMIT(te);
+		} else if (strcmp(event->sensor_descr, DIRECT_TEST_AGG_DESCR) == 0) {
+			const struct sensor_value *samples = (const struct sensor_value *)event->buf;
+
+			zassert_equal(event->sample_cnt, SAMPLES_IN_AGG_BUF,
+				      "Incorrect sample count");
+
+			for (int j = 0; j < SAMPLES_IN_AGG_BUF; j++) {
+				zassert_equal(samples[j * DIRECT_TEST_SENSOR_SAMPLE_SIZE].val1,
+					      direct_sample_num,
+					      "Incorrent sample order");
+				direct_sample_num++;
+			}
+
+			if (direct_sample_num == SAMPLES_IN_AGG_BUF * DIRECT_TEST_AGG_EVENTS) {
+				struct test_end_event *te = new_test_end_event();
+
+				zassert_not_null(te, "Failed to allocate event");
+				te->test_id = cur_test_id;
+				APP_EVENT_SUBMIT(te);
+			}
 		}
 
 		return false;
@@ -27,6 +27,8 @@ enum test_id {
 	TEST_CHANGE_PERIOD_PRE,
 	TEST_CHANGE_PERIOD_POST,
 	TEST_MULTIPLE_SENSORS,
+	TEST_DIRECT_AGGREGATION,
+	TEST_DIRECT_AGGREGATION_DROP,
 
 	TEST_CNT
 };
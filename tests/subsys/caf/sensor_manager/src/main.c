@@ -9,6 +9,9 @@
 #include <app_event_manager.h>
 #include "test_events.h"
 #include <caf/events/sensor_event.h>
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+#include <caf/events/sensor_data_aggregator_event.h>
+#endif
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 
@@ -21,6 +24,12 @@ LOG_MODULE_REGISTER(MODULE);
 #define PRE_CHANGE_SAMPLING_PERIOD 20
 #define SAMPLING_PERIOD 40
 
+/* Aggregator of the simulated sensor 1, defined in aggregator.overlay */
+#define AGG_SENSOR_DESCR "Simulated sensor 1"
+#define AGG_BUF_COUNT 2
+#define SAMPLES_IN_AGG_BUF 10
+#define DIRECT_AGGREGATION_EVENTS 3
+
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
 int64_t first_event_uptime;
@@ -55,11 +64,23 @@ static void test_event_manager(void)
 
 static void test_basic(void)
 {
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+		/* The simulated sensor 1 sends no sensor events */
+		ztest_test_skip();
+		return;
+	}
+
 	test_start(TEST_BASIC);
 }
 
 static void test_change_period_pre(void)
 {
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+		/* The simulated sensor 1 sends no sensor events */
+		ztest_test_skip();
+		return;
+	}
+
 	test_start(TEST_CHANGE_PERIOD_PRE);
 
 	struct set_sensor_period_event *event = new_set_sensor_period_event();
@@ -71,6 +92,12 @@ static void test_change_period_pre(void)
 
 static void test_change_period_post(void)
 {
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+		/* The simulated sensor 1 sends no sensor events */
+		ztest_test_skip();
+		return;
+	}
+
 	test_start(TEST_CHANGE_PERIOD_POST);
 
 	struct set_sensor_period_event *event = new_set_sensor_period_event();
@@ -87,9 +114,106 @@ static void test_change_period_post(void)
 
 static void test_multiple_sensors(void)
 {
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+		/* The simulated sensor 1 sends no sensor events */
+		ztest_test_skip();
+		return;
+	}
+
 	test_start(TEST_MULTIPLE_SENSORS);
 }
 
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+static K_SEM_DEFINE(agg_bufs_held_sem, 0, 1);
+static uint8_t *held_agg_bufs[AGG_BUF_COUNT];
+static const char *held_agg_descr;
+static size_t held_agg_buf_cnt;
+static size_t agg_event_cnt;
+
+static void release_agg_buf(const char *descr, uint8_t *buf)
+{
+	struct sensor_data_aggregator_release_buffer_event *event =
+		new_sensor_data_aggregator_release_buffer_event();
+
+	event->buf = buf;
+	/* The aggregator is identified by the pointer from its event */
+	event->sensor_descr = descr;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void handle_agg_event(const struct sensor_data_aggregator_event *event)
+{
+	zassert_equal(strcmp(event->sensor_descr, AGG_SENSOR_DESCR), 0,
+		      "Unexpected aggregator");
+
+	switch (cur_test_id) {
+	case TEST_DIRECT_AGGREGATION:
+		zassert_equal(event->sample_cnt, SAMPLES_IN_AGG_BUF, "Incorrect sample count");
+		release_agg_buf(event->sensor_descr, event->buf);
+		if (++agg_event_cnt == DIRECT_AGGREGATION_EVENTS) {
+			cur_test_id = TEST_IDLE;
+			k_sem_give(&test_end_sem);
+		}
+		break;
+
+	case TEST_DIRECT_AGGREGATION_DROP:
+		if (held_agg_buf_cnt < AGG_BUF_COUNT) {
+			held_agg_descr = event->sensor_descr;
+			held_agg_bufs[held_agg_buf_cnt++] = event->buf;
+			if (held_agg_buf_cnt == AGG_BUF_COUNT) {
+				k_sem_give(&agg_bufs_held_sem);
+			}
+			break;
+		}
+
+		zassert_equal(event->sample_cnt, SAMPLES_IN_AGG_BUF, "Incorrect sample count");
+		release_agg_buf(event->sensor_descr, event->buf);
+		cur_test_id = TEST_IDLE;
+		k_sem_give(&test_end_sem);
+		break;
+
+	default:
+		release_agg_buf(event->sensor_descr, event->buf);
+		break;
+	}
+}
+#endif
+
+static void test_direct_aggregation(void)
+{
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	agg_event_cnt = 0;
+	test_start(TEST_DIRECT_AGGREGATION);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_direct_aggregation_drop(void)
+{
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	held_agg_buf_cnt = 0;
+	k_sem_reset(&agg_bufs_held_sem);
+	cur_test_id = TEST_DIRECT_AGGREGATION_DROP;
+
+	/* Samples are dropped while all aggregator buffers are held */
+	int err = k_sem_take(&agg_bufs_held_sem, K_SECONDS(30));
+
+	zassert_ok(err, "Aggregator buffers not received");
+	k_sleep(K_MSEC(SAMPLES_IN_AGG_BUF * PRE_CHANGE_SAMPLING_PERIOD));
+
+	/* Aggregation resumes once the buffers are released */
+	for (size_t i = 0; i < ARRAY_SIZE(held_agg_bufs); i++) {
+		release_agg_buf(held_agg_descr, held_agg_bufs[i]);
+	}
+
+	err = k_sem_take(&test_end_sem, K_SECONDS(30));
+	zassert_ok(err, "Aggregation not resumed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(caf_sensor_aggregator_tests,
@@ -98,7 +222,9 @@ void test_main(void)
 			 ztest_unit_test(test_basic),
 			 ztest_unit_test(test_change_period_pre),
 			 ztest_unit_test(test_change_period_post),
-			 ztest_unit_test(test_multiple_sensors)
+			 ztest_unit_test(test_multiple_sensors),
+			 ztest_unit_test(test_direct_aggregation),
+			 ztest_unit_test(test_direct_aggregation_drop)
 			 );
 
 	ztest_run_test_suite(caf_sensor_aggregator_tests);
@@ -117,10 +243,23 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		return false;
 	}
 
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+	if (is_sensor_data_aggregator_event(aeh)) {
+		handle_agg_event(cast_sensor_data_aggregator_event(aeh));
+		return false;
+	}
+#endif
+
 	if (is_sensor_event(aeh)) {
 
 		struct sensor_event *ev = cast_sensor_event(aeh);
 
+		if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION)) {
+			/* The samples of the aggregated sensor are not sent in sensor events */
+			zassert_not_equal(strcmp(ev->descr, AGG_SENSOR_DESCR), 0,
+					  "Sensor event of the aggregated sensor");
+		}
+
 		switch (cur_test_id) {
 		case TEST_BASIC:
 			cur_test_id = TEST_IDLE;
@@ -214,3 +353,6 @@ static bool app_event_handler(const struct app_event_header *aeh)
 APP_EVENT_LISTENER(test_main, app_event_handler);
 APP_EVENT_SUBSCRIBE(test_main, test_end_event);
 APP_EVENT_SUBSCRIBE(test_main, sensor_event);
+#ifdef CONFIG_CAF_SENSOR_MANAGER_DIRECT_AGGREGATION
+APP_EVENT_SUBSCRIBE(test_main, sensor_data_aggregator_event);
+#endif
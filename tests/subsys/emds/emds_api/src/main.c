@@ -107,7 +107,11 @@ static void test_init(void)
 static void test_add_d_entries(void)
 {
 	int err;
-	uint32_t store_expected = NRFX_CEIL_DIV(sizeof(s_data), 4) * 4 + 8;
+	/* Static entry, and the record of the store duration */
+	uint32_t store_expected = NRFX_CEIL_DIV(sizeof(s_data), 4) * 4 + 8 + 8 + 8;
+	struct emds_dynamic_entry reserved = {{EMDS_STORE_TIME_ID, &d_data[0][0], 10}};
+
+	zassert_equal(emds_entry_add(&reserved), -EINVAL, "Reserved id accepted");
 
 	for (int i = 0; i < ARRAY_SIZE(d_entries); i++) {
 		err = emds_entry_add(&d_entries[i]);
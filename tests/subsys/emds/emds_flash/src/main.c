@@ -628,6 +628,59 @@ static void test_corrupted_data(void)
 				     "Should not be able to read");
 }
 
+static void test_write_staged(void)
+{
+	/* Stage entries of odd sizes, so that they span several bursts and allocation table
+	 * batches, and check that they can be read after flush and recovered after reset.
+	 */
+	const uint16_t entry_cnt = 40;
+	uint8_t data_in[40];
+	uint8_t data_out[40];
+	uint32_t size = 0;
+
+	for (size_t i = 0; i < sizeof(data_in); i++) {
+		data_in[i] = i + 1;
+	}
+
+	flash_clear();
+	device_reset();
+
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+
+	for (uint16_t id = 1; id <= entry_cnt; id++) {
+		size += NRFX_CEIL_DIV(id, 4) * 4 + ctx.ate_size;
+	}
+
+	zassert_false(emds_flash_prepare(&ctx, size), "Prepare failed");
+
+	for (uint16_t id = 1; id <= entry_cnt; id++) {
+		zassert_equal(emds_flash_write_staged(&ctx, id, data_in, id), id,
+			      "Error when staging");
+	}
+
+	zassert_false(emds_flash_flush(&ctx), "Error when flushing");
+	zassert_equal(emds_flash_free_space_get(&ctx), m_test_fd.size - size - ctx.ate_size,
+		      "Wrong free space");
+
+	for (uint16_t id = 1; id <= entry_cnt; id++) {
+		memset(data_out, 0, sizeof(data_out));
+		zassert_equal(emds_flash_read(&ctx, id, data_out, sizeof(data_out)), id,
+			      "Could not read");
+		zassert_false(memcmp(data_out, data_in, id), "Retrived wrong value");
+	}
+
+	/* Reset */
+	device_reset();
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+
+	for (uint16_t id = 1; id <= entry_cnt; id++) {
+		memset(data_out, 0, sizeof(data_out));
+		zassert_equal(emds_flash_read(&ctx, id, data_out, sizeof(data_out)), id,
+			      "Could not read after reset");
+		zassert_false(memcmp(data_out, data_in, id), "Retrived wrong value after reset");
+	}
+}
+
 static void test_write_speed(void)
 {
 	char data_in[4] = "bee";
@@ -670,6 +723,44 @@ static void test_write_speed(void)
 	zassert_true(store_time_us < 13000, "Storing 1024 bytes took to long time");
 }
 
+static void test_load_speed(void)
+{
+	const uint16_t entry_cnt[] = { 4, 16, 64, 128 };
+	uint32_t data_in;
+	uint32_t data_out;
+	int64_t tic;
+	uint64_t init_time_us;
+	uint64_t load_time_us;
+
+	for (size_t i = 0; i < ARRAY_SIZE(entry_cnt); i++) {
+		uint32_t idx = m_test_fd.ate_idx_start;
+
+		flash_clear();
+		device_reset();
+
+		for (uint16_t id = 0; id < entry_cnt[i]; id++) {
+			data_in = id;
+			entry_write(idx, id, &data_in, sizeof(data_in));
+			idx -= sizeof(struct test_ate);
+		}
+
+		tic = k_uptime_ticks();
+		zassert_false(emds_flash_init(&ctx), "Error when initializing");
+		init_time_us = k_ticks_to_us_ceil64(k_uptime_ticks() - tic);
+
+		tic = k_uptime_ticks();
+		for (uint16_t id = 0; id < entry_cnt[i]; id++) {
+			zassert_equal(emds_flash_read(&ctx, id, &data_out, sizeof(data_out)),
+				      sizeof(data_out), "Could not read");
+			zassert_equal(data_out, id, "Retrived wrong value");
+		}
+		load_time_us = k_ticks_to_us_ceil64(k_uptime_ticks() - tic);
+
+		printk("%u entries: init took %lldus, loading took %lldus\n", entry_cnt[i],
+		       init_time_us, load_time_us);
+	}
+}
+
 void test_main(void)
 {
 	fs_init();
@@ -686,6 +777,8 @@ void test_main(void)
 			 ztest_unit_test(test_full_corrupt_recovery),
 			 ztest_unit_test(test_overflow),
 			 ztest_unit_test(test_corrupted_data),
+			 ztest_unit_test(test_write_staged),
+			 ztest_unit_test(test_load_speed),
 			 ztest_unit_test(test_write_speed)
 			 );
 
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_ESB_COMMON_H_
+#define TEST_ESB_COMMON_H_
+
+#include <esb.h>
+
+/* Size of the payloads sent in the test */
+#define TEST_PAYLOAD_LENGTH 32
+
+enum test_packet_type {
+	/* Start of a test, the PRX resets its report */
+	TEST_PACKET_START,
+	/* Payload of the test, with a sequence number */
+	TEST_PACKET_DATA,
+	/* Payload ignored by the PRX */
+	TEST_PACKET_FILL,
+	/* Request for the report of the PRX, sent in the next ACK payload */
+	TEST_PACKET_QUERY,
+};
+
+struct test_packet {
+	uint8_t type;
+	uint8_t seq[4];
+};
+
+/* Sequence numbers received by the PRX, sent in the ACK payloads */
+struct test_report {
+	uint32_t received;
+	uint32_t gaps;
+	uint32_t duplicates;
+};
+
+BUILD_ASSERT(sizeof(struct test_packet) <= TEST_PAYLOAD_LENGTH);
+BUILD_ASSERT(sizeof(struct test_report) <= CONFIG_ESB_MAX_PAYLOAD_LENGTH);
+
+int test_clocks_start(void);
+int test_esb_init(enum esb_mode mode, esb_event_handler handler);
+
+#endif /* TEST_ESB_COMMON_H_ */
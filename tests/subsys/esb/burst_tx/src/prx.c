@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+static struct test_report report;
+static uint32_t expected_seq;
+
+static void report_send(void)
+{
+	struct esb_payload payload = {
+		.pipe = 0,
+		.length = sizeof(report),
+	};
+
+	memcpy(payload.data, &report, sizeof(report));
+
+	/* The report is sent in the ACK of the next packet of the PTX */
+	(void)esb_flush_tx();
+	(void)esb_write_payload(&payload);
+}
+
+static void packet_received(const struct esb_payload *payload)
+{
+	const struct test_packet *packet = (const struct test_packet *)payload->data;
+	uint32_t seq;
+
+	if (payload->length < sizeof(*packet)) {
+		return;
+	}
+
+	switch (packet->type) {
+	case TEST_PACKET_START:
+		memset(&report, 0, sizeof(report));
+		expected_seq = 0;
+		return;
+	case TEST_PACKET_QUERY:
+		report_send();
+		return;
+	case TEST_PACKET_DATA:
+		break;
+	default:
+		return;
+	}
+
+	seq = sys_get_le32(packet->seq);
+
+	if (seq < expected_seq) {
+		report.duplicates++;
+		return;
+	}
+
+	if (seq > expected_seq) {
+		report.gaps += seq - expected_seq;
+	}
+
+	report.received++;
+	expected_seq = seq + 1;
+}
+
+static void event_handler(const struct esb_evt *event)
+{
+	struct esb_payload payload;
+
+	if (event->evt_id != ESB_EVENT_RX_RECEIVED) {
+		return;
+	}
+
+	while (esb_read_rx_payload(&payload) == 0) {
+		packet_received(&payload);
+	}
+}
+
+void main(void)
+{
+	int err;
+
+	err = test_clocks_start();
+	if (err) {
+		printk("Clocks not started, err %d\n", err);
+		return;
+	}
+
+	err = test_esb_init(ESB_MODE_PRX, event_handler);
+	if (err) {
+		printk("ESB not initialized, err %d\n", err);
+		return;
+	}
+
+	err = esb_start_rx();
+	if (err) {
+		printk("RX not started, err %d\n", err);
+		return;
+	}
+
+	printk("ESB burst TX test PRX ready\n");
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ztest.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+#define TEST_PACKET_COUNT 2000
+#define TEST_TIMEOUT K_SECONDS(10)
+#define QUERY_ATTEMPTS 10
+
+static K_SEM_DEFINE(event_sem, 0, 1);
+static K_SEM_DEFINE(report_sem, 0, 1);
+
+static struct test_report report;
+
+static void event_handler(const struct esb_evt *event)
+{
+	struct esb_payload payload;
+
+	if (event->evt_id == ESB_EVENT_RX_RECEIVED) {
+		while (esb_read_rx_payload(&payload) == 0) {
+			if (payload.length == sizeof(report)) {
+				memcpy(&report, payload.data, sizeof(report));
+				k_sem_give(&report_sem);
+			}
+		}
+	}
+
+	k_sem_give(&event_sem);
+}
+
+static int packet_write(enum test_packet_type type, uint32_t seq)
+{
+	struct esb_payload payload = {
+		.pipe = 0,
+		.length = TEST_PAYLOAD_LENGTH,
+	};
+	struct test_packet *packet = (struct test_packet *)payload.data;
+	int err;
+
+	packet->type = type;
+	sys_put_le32(seq, packet->seq);
+
+	/* Keep the TX FIFO full, so that the payloads can be chained */
+	while ((err = esb_write_payload(&payload)) == -ENOMEM) {
+		err = k_sem_take(&event_sem, TEST_TIMEOUT);
+		if (err) {
+			return err;
+		}
+	}
+
+	return err;
+}
+
+static void stats_wait(struct esb_pipe_stats *stats, uint32_t count)
+{
+	int64_t timeout = k_uptime_get() + k_ticks_to_ms_ceil64(TEST_TIMEOUT.ticks);
+
+	do {
+		zassert_ok(esb_pipe_stats_get(0, stats), "Cannot get the pipe statistics");
+		if (stats->tx_success + stats->tx_failed >= count) {
+			return;
+		}
+		(void)k_sem_take(&event_sem, K_MSEC(10));
+	} while (k_uptime_get() < timeout);
+
+	zassert_unreachable("Payloads not sent in time");
+}
+
+static void report_get(void)
+{
+	k_sem_reset(&report_sem);
+
+	/* The PRX sends its report in the ACK of the next packet */
+	for (size_t i = 0; i < QUERY_ATTEMPTS; i++) {
+		zassert_ok(packet_write(TEST_PACKET_QUERY, 0), "Cannot write the query");
+
+		if (!k_sem_take(&report_sem, K_MSEC(100))) {
+			return;
+		}
+	}
+
+	zassert_unreachable("No report from the PRX");
+}
+
+static void test_burst_tx_throughput(void)
+{
+	struct esb_pipe_stats stats;
+	int64_t start;
+	int64_t elapsed;
+
+	zassert_ok(esb_pipe_stats_reset(), "Cannot reset the pipe statistics");
+	zassert_ok(packet_write(TEST_PACKET_START, 0), "Cannot start the test");
+	stats_wait(&stats, 1);
+	zassert_ok(esb_pipe_stats_reset(), "Cannot reset the pipe statistics");
+
+	start = k_uptime_get();
+
+	for (uint32_t seq = 0; seq < TEST_PACKET_COUNT; seq++) {
+		zassert_ok(packet_write(TEST_PACKET_DATA, seq), "Cannot write payload %u", seq);
+	}
+
+	stats_wait(&stats, TEST_PACKET_COUNT);
+	elapsed = MAX(k_uptime_get() - start, 1);
+
+	TC_PRINT("Sent %u payloads in %lld ms: %llu kbit/s, %u retransmissions, %u chained\n",
+		 stats.tx_success, elapsed, (uint64_t)stats.tx_bytes * 8 / elapsed,
+		 stats.tx_retransmits, stats.tx_chained);
+
+	zassert_equal(stats.tx_failed, 0, "Payloads not acknowledged");
+	zassert_equal(stats.tx_success, TEST_PACKET_COUNT, "Wrong number of payloads sent");
+
+	if (IS_ENABLED(CONFIG_ESB_BURST_TX)) {
+		zassert_true(stats.tx_chained > 0, "No payload chained");
+	}
+
+	/* Every payload reported as sent must have been received once, in order */
+	report_get();
+
+	TC_PRINT("PRX received %u payloads, %u missing\n", report.received, report.gaps);
+
+	zassert_equal(report.gaps, 0, "Payloads lost");
+	zassert_equal(report.duplicates, 0, "Payloads received twice");
+	zassert_equal(report.received, TEST_PACKET_COUNT, "Wrong number of payloads received");
+}
+
+static void test_burst_tx_flush(void)
+{
+	struct esb_pipe_stats stats;
+	uint32_t sent;
+
+	zassert_ok(packet_write(TEST_PACKET_START, 0), "Cannot start the test");
+
+	/* Flush the FIFO while a payload is prepared for the burst. The payloads written
+	 * afterwards reuse the same FIFO entries, and the PRX ignores the flushed payloads
+	 * if they are sent in their place.
+	 */
+	for (uint32_t i = 0; i < CONFIG_ESB_TX_FIFO_SIZE; i++) {
+		zassert_ok(packet_write(TEST_PACKET_FILL, i), "Cannot write payload %u", i);
+	}
+
+	zassert_ok(esb_flush_tx(), "Cannot flush the TX FIFO");
+
+	/* The payload in flight when the FIFO was flushed may still be acknowledged */
+	k_sleep(K_MSEC(10));
+	zassert_ok(esb_pipe_stats_get(0, &stats), "Cannot get the pipe statistics");
+	sent = stats.tx_success + stats.tx_failed;
+
+	for (uint32_t seq = 0; seq < CONFIG_ESB_TX_FIFO_SIZE; seq++) {
+		zassert_ok(packet_write(TEST_PACKET_DATA, seq), "Cannot write payload %u", seq);
+	}
+
+	stats_wait(&stats, sent + CONFIG_ESB_TX_FIFO_SIZE);
+	zassert_equal(stats.tx_failed, 0, "Payloads not acknowledged");
+
+	report_get();
+
+	zassert_equal(report.gaps, 0, "Payloads lost");
+	zassert_equal(report.duplicates, 0, "Payloads received twice");
+	zassert_equal(report.received, CONFIG_ESB_TX_FIFO_SIZE,
+		      "Wrong number of payloads received");
+}
+
+void test_main(void)
+{
+	zassert_ok(test_clocks_start(), "Cannot start the clocks");
+	zassert_ok(test_esb_init(ESB_MODE_PTX, event_handler), "Cannot initialize ESB");
+
+	ztest_test_suite(esb_burst_tx,
+			 ztest_unit_test(test_burst_tx_throughput),
+			 ztest_unit_test(test_burst_tx_flush)
+			 );
+
+	ztest_run_test_suite(esb_burst_tx);
+}
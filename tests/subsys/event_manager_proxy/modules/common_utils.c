@@ -29,7 +29,7 @@ int proxy_burst_simple_events(void)
 	for (size_t cnt = 0; cnt < TEST_CONFIG_SIMPLE_BURST_SIZE; ++cnt) {
 		proxy_direct_submit_event(&event->header);
 	}
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
@@ -41,7 +41,7 @@ int proxy_burst_simple_pong_events(void)
 	for (size_t cnt = 0; cnt < TEST_CONFIG_SIMPLE_BURST_SIZE; ++cnt) {
 		proxy_direct_submit_event(&event->header);
 	}
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
@@ -61,7 +61,7 @@ int proxy_burst_data_events(void)
 		proxy_direct_submit_event(&event->header);
 	}
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
@@ -81,7 +81,7 @@ int proxy_burst_data_response_events(void)
 		proxy_direct_submit_event(&event->header);
 	}
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
@@ -98,7 +98,7 @@ int proxy_burst_data_big_events(void)
 		proxy_direct_submit_event(&event->header);
 	}
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
@@ -115,7 +115,7 @@ int proxy_burst_data_big_response_events(void)
 		proxy_direct_submit_event(&event->header);
 	}
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	return 0;
 }
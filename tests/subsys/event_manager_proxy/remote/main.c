@@ -72,7 +72,7 @@ static void proxy_direct_submit_pong_event(void)
 	struct simple_pong_event *event = new_simple_pong_event();
 
 	proxy_direct_submit_event(&event->header);
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 }
 
 /*
@@ -87,7 +87,7 @@ static void proxy_direct_submit_start_ack_event(void)
 
 	event->test_id = cur_test_id;
 	proxy_direct_submit_event(&event->header);
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 }
 
 static bool event_handler(const struct app_event_header *eh)
@@ -170,7 +170,7 @@ static void test_data_ping_pong_performance(void)
 
 	us_spent = test_time_spent_us();
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	test_end(TEST_DATA_RESPONSE);
 
@@ -252,7 +252,7 @@ static void test_data_big_ping_pong_performance(void)
 
 	us_spent = test_time_spent_us();
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	test_end(TEST_DATA_RESPONSE);
 
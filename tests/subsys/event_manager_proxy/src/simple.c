@@ -92,7 +92,7 @@ static void test_simple_ping_pong_performance(void)
 
 	us_spent = test_time_spent_us();
 
-	app_event_manager_free(event);
+	APP_EVENT_FREE(event);
 
 	unsigned long speed =
 				     /* Burst size + test end event */
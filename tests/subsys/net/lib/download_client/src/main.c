@@ -12,6 +12,9 @@
 
 #include "mock/socket.h"
 #include "mock/dl_coap.h"
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+#include "mock/http_server.h"
+#endif
 
 static enum download_client_evt_id last_event = -1;
 
@@ -204,6 +207,366 @@ static void test_download_abort_on_invalid_block(void)
 	de_init(&client);
 }
 
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+#define HTTP_FILE_SIZE 80
+#define HTTP_FRAG_SIZE 16
+#define HTTP_HOST "http://10.1.0.10"
+#define HTTP_FILE "file.bin"
+
+static uint8_t http_file[HTTP_FILE_SIZE];
+static uint8_t http_received[HTTP_FILE_SIZE];
+static size_t http_received_len;
+static int http_error;
+
+static int download_client_http_callback(const struct download_client_evt *event)
+{
+	switch (event->id) {
+	case DOWNLOAD_CLIENT_EVT_FRAGMENT:
+		zassert_true(http_received_len + event->fragment.len <= sizeof(http_received),
+			     "Received more than the file");
+		memcpy(&http_received[http_received_len], event->fragment.buf,
+		       event->fragment.len);
+		http_received_len += event->fragment.len;
+		break;
+	case DOWNLOAD_CLIENT_EVT_ERROR:
+		http_error = event->error;
+		break;
+	default:
+		break;
+	}
+
+	return download_client_callback(event);
+}
+
+/* Start an HTTP download, keeping the bytes received before `from` when resuming. */
+static void dl_http_start_from(struct download_client *client, const struct http_server_cfg *cfg,
+			       size_t from, bool journal)
+{
+	const struct download_client_cfg http_config = {
+		.sec_tag = -1,
+		.frag_size_override = HTTP_FRAG_SIZE,
+		.journal = journal,
+	};
+	int err;
+
+	for (size_t i = 0; i < sizeof(http_file); i++) {
+		http_file[i] = i * 7 + 3;
+	}
+
+	if (from == 0) {
+		memset(http_received, 0, sizeof(http_received));
+	}
+	http_received_len = from;
+	http_error = 0;
+
+	http_server_start(http_file, sizeof(http_file), cfg);
+
+	memset(client, 0, sizeof(struct download_client));
+
+	err = download_client_init(client, download_client_http_callback);
+	zassert_ok(err, NULL);
+
+	err = download_client_connect(client, HTTP_HOST, &http_config);
+	zassert_ok(err, NULL);
+
+	err = download_client_start(client, HTTP_FILE, from);
+	zassert_ok(err, NULL);
+}
+
+static void dl_http_start(struct download_client *client, const struct http_server_cfg *cfg)
+{
+	dl_http_start_from(client, cfg, 0, false);
+}
+
+static void dl_http_check_file(void)
+{
+	zassert_equal(http_received_len, sizeof(http_file), "Received %u bytes",
+		      http_received_len);
+	zassert_mem_equal(http_received, http_file, sizeof(http_file), "Unexpected file data");
+}
+
+static void dl_http_stop(struct download_client *client)
+{
+	int err;
+
+	err = download_client_disconnect(client);
+	zassert_ok(err, NULL);
+
+	http_server_stop();
+}
+
+static void test_download_stats(void)
+{
+	struct download_client client;
+	struct download_client_stats stats;
+	int32_t recvfrom_params[] = { 25, 0, 25, 25 };
+	int32_t sendto_params[] = { 20, 20, 20, 20 };
+	int err;
+
+	dl_coap_init(75, 20);
+
+	mock_return_values("mock_socket_offload_recvfrom", recvfrom_params,
+			   ARRAY_SIZE(recvfrom_params));
+	mock_return_values("mock_socket_offload_sendto", sendto_params, ARRAY_SIZE(sendto_params));
+
+	dl_coap_start(&client);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+
+	err = download_client_stats_get(&client, &stats);
+	zassert_ok(err, NULL);
+	zassert_equal(stats.bytes, 75, "Unexpected number of bytes: %u", stats.bytes);
+	zassert_equal(stats.requests, 4, "Unexpected number of requests: %u", stats.requests);
+	zassert_equal(stats.reconnects, 1, "Unexpected number of reconnects: %u",
+		      stats.reconnects);
+
+	zassert_equal(download_client_stats_get(&client, NULL), -EINVAL, NULL);
+
+	de_init(&client);
+}
+
+/* Each response is read separately, the next requests are sent while it is received. */
+static void test_download_http_pipeline_in_order(void)
+{
+	struct download_client client;
+	struct download_client_stats stats;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+	};
+
+	dl_http_start(&client, &cfg);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	dl_http_check_file();
+
+	zassert_equal(http_server_stats_get()->requests, HTTP_FILE_SIZE / HTTP_FRAG_SIZE, NULL);
+	zassert_true(http_server_stats_get()->outstanding_max > 1, "Requests were not pipelined");
+	zassert_true(http_server_stats_get()->outstanding_max <=
+		     CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH, "Too many requests in flight");
+
+	zassert_ok(download_client_stats_get(&client, &stats), NULL);
+	zassert_equal(stats.bytes, HTTP_FILE_SIZE, "Unexpected number of bytes: %u",
+		      stats.bytes);
+	zassert_equal(stats.requests, HTTP_FILE_SIZE / HTTP_FRAG_SIZE,
+		      "Unexpected number of requests: %u", stats.requests);
+	zassert_equal(stats.reconnects, 0, NULL);
+
+	dl_http_stop(&client);
+}
+
+/* Headers and payloads are split over several reads. */
+static void test_download_http_pipeline_split(void)
+{
+	struct download_client client;
+	const struct http_server_cfg cfg = {
+		.recv_max = 7,
+	};
+
+	dl_http_start(&client, &cfg);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	dl_http_check_file();
+
+	dl_http_stop(&client);
+}
+
+/* The beginning of the next responses is read together with a fragment. */
+static void test_download_http_pipeline_bundled(void)
+{
+	struct download_client client;
+	const struct http_server_cfg cfg = { 0 };
+
+	dl_http_start(&client, &cfg);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	dl_http_check_file();
+
+	dl_http_stop(&client);
+}
+
+/* A response for another range than the one expected stops the download. */
+static void test_download_http_content_range_mismatch(void)
+{
+	struct download_client client;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+		.bad_range_resp = 2,
+	};
+
+	dl_http_start(&client, &cfg);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_ERROR, 10), "Download must be on error");
+	zassert_equal(http_error, -EBADMSG, "Unexpected error %d", http_error);
+	zassert_equal(http_received_len, HTTP_FRAG_SIZE, "Received %u bytes",
+		      http_received_len);
+	zassert_mem_equal(http_received, http_file, HTTP_FRAG_SIZE, "Unexpected file data");
+
+	dl_http_stop(&client);
+}
+
+/* The server closes the connection in the middle of the second response,
+ * with more requests in flight. The download resumes from the bytes received.
+ */
+static void test_download_http_close_mid_pipeline(void)
+{
+	struct download_client client;
+	struct download_client_stats stats;
+	const struct http_server_cfg cfg = {
+		.recv_max = 7,
+		.close_at = 150,
+	};
+
+	dl_http_start(&client, &cfg);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	zassert_equal(http_error, -ECONNRESET, "Unexpected error %d", http_error);
+	dl_http_check_file();
+
+	zassert_equal(http_server_stats_get()->connects, 2, NULL);
+	zassert_ok(download_client_stats_get(&client, &stats), NULL);
+	zassert_equal(stats.reconnects, 1, "Unexpected number of reconnects: %u",
+		      stats.reconnects);
+
+	dl_http_stop(&client);
+}
+
+static int journal_read(size_t offset, void *buf, size_t len, void *user_data)
+{
+	zassert_true(offset + len <= http_received_len, "Read beyond the data received");
+
+	memcpy(buf, &http_received[offset], len);
+
+	return 0;
+}
+
+/* Journaled download stopped by a bad response after two fragments. */
+static void dl_http_interrupt(const char *etag)
+{
+	struct download_client client;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+		.bad_range_resp = 3,
+		.etag = etag,
+	};
+
+	zassert_ok(download_client_journal_clear(), NULL);
+
+	dl_http_start_from(&client, &cfg, 0, true);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_ERROR, 10), "Download must be on error");
+	zassert_equal(http_received_len, 2 * HTTP_FRAG_SIZE, "Received %u bytes",
+		      http_received_len);
+
+	dl_http_stop(&client);
+}
+
+/* The download is resumed from the journal, which is deleted once done. */
+static void test_download_http_journal_resume(void)
+{
+	struct download_client client;
+	struct download_client_journal journal;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+		.etag = "\"v1\"",
+	};
+	int err;
+
+	dl_http_interrupt(cfg.etag);
+
+	err = download_client_journal_get(HTTP_HOST, "other.bin", &journal);
+	zassert_equal(err, -ENOENT, "Journal of another file must not be used");
+
+	err = download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal);
+	zassert_ok(err, NULL);
+	zassert_equal(journal.offset, 2 * HTTP_FRAG_SIZE, "Unexpected offset %u", journal.offset);
+	zassert_equal(journal.file_size, HTTP_FILE_SIZE, NULL);
+	zassert_ok(download_client_journal_verify(&journal, journal_read, NULL), NULL);
+
+	dl_http_start_from(&client, &cfg, journal.offset, true);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	dl_http_check_file();
+	zassert_equal(http_server_stats_get()->requests,
+		      (HTTP_FILE_SIZE - journal.offset) / HTTP_FRAG_SIZE, NULL);
+
+	err = download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal);
+	zassert_equal(err, -ENOENT, "Journal must be deleted once the download is done");
+
+	dl_http_stop(&client);
+}
+
+/* A journal that does not match the data received is deleted. */
+static void test_download_http_journal_crc_mismatch(void)
+{
+	struct download_client_journal journal;
+	int err;
+
+	dl_http_interrupt(NULL);
+
+	err = download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal);
+	zassert_ok(err, NULL);
+
+	http_received[HTTP_FRAG_SIZE + 1] ^= 0xff;
+
+	err = download_client_journal_verify(&journal, journal_read, NULL);
+	zassert_equal(err, -EBADMSG, "Unexpected error %d", err);
+
+	err = download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal);
+	zassert_equal(err, -ENOENT, "Journal must be deleted");
+}
+
+/* A journal that has not been verified is not used to check the resource. */
+static void test_download_http_journal_unverified(void)
+{
+	struct download_client client;
+	struct download_client_journal journal;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+		.etag = "\"v2\"",
+	};
+
+	dl_http_interrupt("\"v1\"");
+
+	zassert_ok(download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal), NULL);
+
+	dl_http_start_from(&client, &cfg, journal.offset, true);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_DONE, 10), "Download must have finished");
+	zassert_equal(http_error, 0, "Unexpected error %d", http_error);
+	dl_http_check_file();
+
+	dl_http_stop(&client);
+}
+
+/* The resource has changed on the server since the download was interrupted. */
+static void test_download_http_journal_stale(void)
+{
+	struct download_client client;
+	struct download_client_journal journal;
+	const struct http_server_cfg cfg = {
+		.per_response = true,
+		.etag = "\"v2\"",
+	};
+	int err;
+
+	dl_http_interrupt("\"v1\"");
+
+	zassert_ok(download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal), NULL);
+	zassert_ok(download_client_journal_verify(&journal, journal_read, NULL), NULL);
+
+	dl_http_start_from(&client, &cfg, journal.offset, true);
+
+	zassert_ok(wait_for_event(DOWNLOAD_CLIENT_EVT_ERROR, 10), "Download must be on error");
+	zassert_equal(http_error, -ESTALE, "Unexpected error %d", http_error);
+	zassert_equal(http_received_len, journal.offset, "Data of the new resource was used");
+
+	err = download_client_journal_get(HTTP_HOST, HTTP_FILE, &journal);
+	zassert_equal(err, -ENOENT, "Journal must be deleted");
+
+	dl_http_stop(&client);
+}
+#endif /* CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE */
+
 void test_main(void)
 {
 	ztest_test_suite(lib_fota_download_test, ztest_unit_test(test_download_simple),
@@ -213,6 +576,22 @@ void test_main(void)
 			 ztest_unit_test(test_download_abort_on_invalid_block));
 
 	ztest_run_test_suite(lib_fota_download_test);
+
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+	ztest_test_suite(lib_download_client_pipeline_test,
+			 ztest_unit_test(test_download_stats),
+			 ztest_unit_test(test_download_http_pipeline_in_order),
+			 ztest_unit_test(test_download_http_pipeline_split),
+			 ztest_unit_test(test_download_http_pipeline_bundled),
+			 ztest_unit_test(test_download_http_content_range_mismatch),
+			 ztest_unit_test(test_download_http_close_mid_pipeline),
+			 ztest_unit_test(test_download_http_journal_resume),
+			 ztest_unit_test(test_download_http_journal_crc_mismatch),
+			 ztest_unit_test(test_download_http_journal_unverified),
+			 ztest_unit_test(test_download_http_journal_stale));
+
+	ztest_run_test_suite(lib_download_client_pipeline_test);
+#endif
 }
 
 #define TEST_SOCKET_PRIO 40
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ztest.h>
+
+#include "mock/http_server.h"
+
+#define RESP_MAX 16
+
+static const uint8_t *file_data;
+static size_t file_size;
+static struct http_server_cfg cfg;
+static struct http_server_stats stats;
+static bool active;
+
+/* Current connection */
+static char req[512];
+static size_t req_len;
+static uint8_t out[1024];
+static size_t out_len;
+static size_t out_pos;
+/* End offset in `out` of each response not fully read yet */
+static size_t resp_end[RESP_MAX];
+static size_t resp_cnt;
+static size_t resp_total;
+static size_t sent_total;
+static bool closed;
+
+void http_server_start(const uint8_t *file, size_t size, const struct http_server_cfg *config)
+{
+	file_data = file;
+	file_size = size;
+	cfg = *config;
+	memset(&stats, 0, sizeof(stats));
+	resp_total = 0;
+	sent_total = 0;
+	active = true;
+
+	http_server_connect();
+	stats.connects = 0;
+}
+
+void http_server_stop(void)
+{
+	active = false;
+}
+
+bool http_server_active(void)
+{
+	return active;
+}
+
+const struct http_server_stats *http_server_stats_get(void)
+{
+	return &stats;
+}
+
+int http_server_connect(void)
+{
+	req_len = 0;
+	out_len = 0;
+	out_pos = 0;
+	resp_cnt = 0;
+	closed = false;
+	stats.connects++;
+
+	return 0;
+}
+
+static void response_add(size_t first, size_t last)
+{
+	int len;
+	size_t shift = 0;
+
+	zassert_true(resp_cnt < RESP_MAX, "Too many requests in flight");
+
+	/* Drop what has been read already */
+	memmove(out, &out[out_pos], out_len - out_pos);
+	for (size_t i = 0; i < resp_cnt; i++) {
+		resp_end[i] -= out_pos;
+	}
+	out_len -= out_pos;
+	out_pos = 0;
+
+	resp_total++;
+	if (resp_total == cfg.bad_range_resp) {
+		shift = 1;
+	}
+
+	last = MIN(last, file_size - 1);
+
+	len = snprintf(&out[out_len], sizeof(out) - out_len,
+		       "HTTP/1.1 206 Partial Content\r\n"
+		       "Content-Range: bytes %u-%u/%u\r\n"
+		       "%s%s%s"
+		       "\r\n",
+		       (unsigned int)(first + shift), (unsigned int)(last + shift),
+		       (unsigned int)file_size,
+		       cfg.etag ? "ETag: " : "", cfg.etag ? cfg.etag : "", cfg.etag ? "\r\n" : "");
+	zassert_true(len > 0 && out_len + len + last - first + 1 <= sizeof(out),
+		     "Response buffer too small");
+
+	out_len += len;
+	memcpy(&out[out_len], &file_data[first], last - first + 1);
+	out_len += last - first + 1;
+
+	resp_end[resp_cnt++] = out_len;
+	stats.outstanding_max = MAX(stats.outstanding_max, resp_cnt);
+}
+
+ssize_t http_server_send(const void *buf, size_t len)
+{
+	char *end;
+	char *range;
+	unsigned int first;
+	unsigned int last;
+
+	zassert_true(req_len + len < sizeof(req), "Request buffer too small");
+
+	memcpy(&req[req_len], buf, len);
+	req_len += len;
+	req[req_len] = '\0';
+
+	/* Answer each complete request */
+	while ((end = strstr(req, "\r\n\r\n"))) {
+		end += strlen("\r\n\r\n");
+
+		range = strstr(req, "Range: bytes=");
+		zassert_not_null(range, "Not a range request");
+		zassert_true(range < end, "Not a range request");
+		zassert_equal(sscanf(range, "Range: bytes=%u-%u", &first, &last), 2,
+			      "Malformed range");
+		zassert_true(first <= last && first < file_size, "Bad range %u-%u", first, last);
+
+		stats.requests++;
+		response_add(first, last);
+
+		req_len -= end - req;
+		memmove(req, end, req_len + 1);
+	}
+
+	return len;
+}
+
+ssize_t http_server_recv(void *buf, size_t len)
+{
+	size_t avail;
+
+	if (closed) {
+		errno = ECONNRESET;
+		return -1;
+	}
+
+	if (cfg.close_at && sent_total >= cfg.close_at) {
+		/* Close once, the client reconnects */
+		cfg.close_at = 0;
+		closed = true;
+		return 0;
+	}
+
+	avail = out_len - out_pos;
+	if (avail == 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (cfg.per_response) {
+		avail = resp_end[0] - out_pos;
+	}
+	if (cfg.recv_max) {
+		avail = MIN(avail, cfg.recv_max);
+	}
+	if (cfg.close_at) {
+		avail = MIN(avail, cfg.close_at - sent_total);
+	}
+
+	len = MIN(len, avail);
+	memcpy(buf, &out[out_pos], len);
+	out_pos += len;
+	sent_total += len;
+
+	/* Drop the responses read completely */
+	while (resp_cnt && out_pos >= resp_end[0]) {
+		memmove(resp_end, &resp_end[1], --resp_cnt * sizeof(resp_end[0]));
+	}
+
+	return len;
+}
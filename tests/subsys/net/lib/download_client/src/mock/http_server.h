@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#ifndef _HTTP_SERVER_H_
+#define _HTTP_SERVER_H_
+
+#include <zephyr/kernel.h>
+
+/* Local HTTP server answering range requests sent on the mock socket. */
+
+struct http_server_cfg {
+	/** Maximum number of bytes returned by one recv() call, 0 for no limit. */
+	size_t recv_max;
+	/** Return at most one response per recv() call. */
+	bool per_response;
+	/** Close the connection once this many bytes have been sent, 0 to never close. */
+	size_t close_at;
+	/** Shift the Content-Range of this response (counted from one), 0 for none. */
+	size_t bad_range_resp;
+	/** ETag of the file, NULL for none. */
+	const char *etag;
+};
+
+struct http_server_stats {
+	/** Range requests received. */
+	size_t requests;
+	/** Largest number of requests waiting for their response to be read. */
+	size_t outstanding_max;
+	/** Connections opened. */
+	size_t connects;
+};
+
+void http_server_start(const uint8_t *file, size_t size, const struct http_server_cfg *cfg);
+void http_server_stop(void);
+bool http_server_active(void);
+const struct http_server_stats *http_server_stats_get(void);
+
+int http_server_connect(void);
+ssize_t http_server_send(const void *buf, size_t len);
+ssize_t http_server_recv(void *buf, size_t len);
+
+#endif /* _HTTP_SERVER_H_ */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <string.h>
+#include <errno.h>
+#include <zephyr/settings/settings.h>
+
+/* Settings backend keeping the records in RAM, for the download journal. */
+
+#define RECORD_CNT 4
+#define RECORD_NAME_SIZE 32
+#define RECORD_VALUE_SIZE 128
+
+struct record {
+	char name[RECORD_NAME_SIZE];
+	uint8_t value[RECORD_VALUE_SIZE];
+	size_t len;
+};
+
+static struct record records[RECORD_CNT];
+
+static ssize_t record_read(void *cb_arg, void *data, size_t len)
+{
+	const struct record *rec = cb_arg;
+
+	len = MIN(len, rec->len);
+	memcpy(data, rec->value, len);
+
+	return len;
+}
+
+static int ram_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+	for (size_t i = 0; i < RECORD_CNT; i++) {
+		if (records[i].len == 0) {
+			continue;
+		}
+
+		(void)settings_call_set_handler(records[i].name, records[i].len, record_read,
+						&records[i], arg);
+	}
+
+	return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name, const char *value,
+		    size_t val_len)
+{
+	struct record *free_rec = NULL;
+	struct record *rec = NULL;
+
+	if (strlen(name) >= RECORD_NAME_SIZE || val_len > RECORD_VALUE_SIZE) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < RECORD_CNT; i++) {
+		if (records[i].len && !strcmp(records[i].name, name)) {
+			rec = &records[i];
+		} else if (!records[i].len && !free_rec) {
+			free_rec = &records[i];
+		}
+	}
+
+	if (!rec) {
+		if (val_len == 0) {
+			return 0;
+		}
+		if (!free_rec) {
+			return -ENOMEM;
+		}
+		rec = free_rec;
+		strcpy(rec->name, name);
+	}
+
+	/* A record is deleted by saving an empty value */
+	if (val_len) {
+		memcpy(rec->value, value, val_len);
+	}
+	rec->len = val_len;
+
+	return 0;
+}
+
+static const struct settings_store_itf ram_itf = {
+	.csi_load = ram_load,
+	.csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+	.cs_itf = &ram_itf,
+};
+
+int settings_backend_init(void)
+{
+	settings_dst_register(&ram_store);
+	settings_src_register(&ram_store);
+
+	return 0;
+}
@@ -8,6 +8,9 @@
 #include <ztest.h>
 
 #include "mock/socket.h"
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+#include "mock/http_server.h"
+#endif
 
 void mock_socket_iface_init(struct net_if *iface);
 
@@ -28,6 +31,13 @@ static ssize_t mock_socket_offload_recvfrom(void *obj, void *buf, size_t len, in
 					    struct sockaddr *from, socklen_t *fromlen)
 {
 	k_sleep(K_MSEC(50));
+
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+	if (http_server_active()) {
+		return http_server_recv(buf, len);
+	}
+#endif
+
 	return ztest_get_return_value();
 }
 
@@ -40,6 +50,13 @@ static ssize_t mock_socket_offload_sendto(void *obj, const void *buf, size_t len
 					  const struct sockaddr *to, socklen_t tolen)
 {
 	k_sleep(K_MSEC(50));
+
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+	if (http_server_active()) {
+		return http_server_send(buf, len);
+	}
+#endif
+
 	return ztest_get_return_value();
 }
 
@@ -92,6 +109,13 @@ static int mock_socket_offload_bind(void *obj, const struct sockaddr *addr, sock
 static int mock_socket_offload_connect(void *obj, const struct sockaddr *addr, socklen_t addrlen)
 {
 	k_sleep(K_MSEC(50));
+
+#if defined(CONFIG_TEST_DOWNLOAD_CLIENT_PIPELINE)
+	if (http_server_active()) {
+		return http_server_connect();
+	}
+#endif
+
 	return 0;
 }
 
@@ -34,6 +34,7 @@ static bool fail_on_connect;
 static bool fail_on_start;
 static bool download_with_offset_success;
 static download_client_callback_t download_client_event_handler;
+static int img_type_retval;
 
 int dfu_target_init(int img_type, int img_num, size_t file_size, dfu_target_callback_t cb)
 {
@@ -42,7 +43,7 @@ int dfu_target_init(int img_type, int img_num, size_t file_size, dfu_target_call
 
 int dfu_target_img_type(const void *const buf, size_t len)
 {
-	return 0;
+	return img_type_retval;
 }
 
 int dfu_target_offset_get(size_t *offset)
@@ -129,6 +130,37 @@ int z_impl_zsock_inet_pton(sa_family_t family, const char *src, void *dst)
 	return 0;
 }
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+static bool journal_present;
+static size_t journal_offset;
+static bool journal_verified;
+static bool journal_verified_with_read;
+
+int download_client_journal_get(const char *host, const char *file,
+				struct download_client_journal *journal)
+{
+	if (!journal_present) {
+		return -ENOENT;
+	}
+
+	memset(journal, 0, sizeof(*journal));
+	journal->offset = journal_offset;
+
+	return 0;
+}
+
+int download_client_journal_verify(const struct download_client_journal *journal,
+				   download_client_journal_read_t read, void *user_data)
+{
+	zassert_equal(journal->offset, journal_offset, NULL);
+
+	journal_verified = true;
+	journal_verified_with_read = (read != NULL);
+
+	return 0;
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_JOURNAL */
+
 /* END stubs and mocks */
 
 
@@ -251,6 +283,13 @@ static void init(void)
 	fail_on_start = false;
 	download_client_start_file = NULL;
 	spm_s0_active_retval = false;
+	img_type_retval = DFU_TARGET_IMAGE_TYPE_ANY;
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+	journal_present = false;
+	journal_offset = 0;
+	journal_verified = false;
+	journal_verified_with_read = false;
+#endif
 
 	err = fota_download_init(client_callback);
 	zassert_equal(err, 0, NULL);
@@ -391,3 +430,66 @@ ZTEST(fota_download_tests, test_download_with_offset)
 	err = fota_download_cancel();
 	zassert_ok(err, NULL);
 }
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_JOURNAL)
+ZTEST(fota_download_tests, test_download_modem_delta_resume_journal)
+{
+	int err;
+	uint8_t fragment_buf[1] = {0};
+	const struct download_client_evt evt = {
+		.id = DOWNLOAD_CLIENT_EVT_FRAGMENT,
+		.fragment = {
+			.buf = fragment_buf,
+			.len = sizeof(fragment_buf),
+		}
+	};
+
+	init();
+
+	/* A modem delta image is stored up to the offset of the journal */
+	start_with_offset = true;
+	img_type_retval = DFU_TARGET_IMAGE_TYPE_MODEM_DELTA;
+	journal_present = true;
+	journal_offset = ARBITRARY_IMAGE_OFFSET;
+
+	strcpy(buf, S0_A);
+	err = fota_download_start(BASE_DOMAIN, buf, NO_TLS, 0, 0);
+	zassert_ok(err, NULL);
+
+	k_sem_reset(&download_with_offset_sem);
+	download_with_offset_success = false;
+
+	err = download_client_event_handler(&evt);
+	zassert_equal(err, -1, NULL);
+
+	k_sem_take(&download_with_offset_sem, K_SECONDS(2));
+	zassert_true(download_with_offset_success, NULL);
+
+	/* The image cannot be read back, the journal is accepted without its hash */
+	zassert_true(journal_verified, "Journal not verified");
+	zassert_false(journal_verified_with_read, "Modem delta image read back");
+
+	err = fota_download_cancel();
+	zassert_ok(err, NULL);
+
+	/* A journal ahead of the stored image is not used */
+	journal_offset = ARBITRARY_IMAGE_OFFSET + 1;
+	journal_verified = false;
+
+	err = fota_download_start(BASE_DOMAIN, buf, NO_TLS, 0, 0);
+	zassert_ok(err, NULL);
+
+	k_sem_reset(&download_with_offset_sem);
+	download_with_offset_success = false;
+
+	err = download_client_event_handler(&evt);
+	zassert_equal(err, -1, NULL);
+
+	k_sem_take(&download_with_offset_sem, K_SECONDS(2));
+	zassert_true(download_with_offset_success, NULL);
+	zassert_false(journal_verified, "Journal ahead of the image verified");
+
+	err = fota_download_cancel();
+	zassert_ok(err, NULL);
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_JOURNAL */